@@ -25,6 +25,12 @@
 
 #include <sys/stat.h>
 
+#ifdef HAS_MMAP
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 PosixIoStream *PosixIoStream::makeFromPath(const Common::String &path, bool writeMode) {
 #if defined(HAS_FSEEKO64)
 	FILE *handle = fopen64(path.c_str(), writeMode ? "wb" : "rb");
@@ -58,3 +64,44 @@ int64 PosixIoStream::size() const {
 
 	return st.st_size;
 }
+
+#ifdef HAS_MMAP
+
+// Smaller files are cheaper to read than to map
+static const int64 kMinMmapSize = 64 * 1024;
+// Keep large mappings from using up the address space of 32-bit systems
+static const int64 kMaxMmapSize = sizeof(void *) >= 8 ? 0x7FFFFFFF : 64 * 1024 * 1024;
+
+PosixMmapStream *PosixMmapStream::makeFromPath(const Common::String &path) {
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd == -1)
+		return nullptr;
+
+	struct stat st;
+	if (fstat(fd, &st) == -1 || !S_ISREG(st.st_mode) ||
+			st.st_size < kMinMmapSize || st.st_size > kMaxMmapSize) {
+		close(fd);
+		return nullptr;
+	}
+
+	void *mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// The mapping stays valid after the descriptor is closed
+	close(fd);
+
+	if (mapping == MAP_FAILED)
+		return nullptr;
+
+	return new PosixMmapStream(mapping, st.st_size);
+}
+
+PosixMmapStream::PosixMmapStream(void *mapping, uint32 size) :
+		Common::MemoryReadStream((const byte *)mapping, size, DisposeAfterUse::NO),
+		_mapping(mapping), _mappingSize(size) {
+}
+
+PosixMmapStream::~PosixMmapStream() {
+	munmap(_mapping, _mappingSize);
+}
+
+#endif
@@ -35,4 +35,39 @@ public:
 	int64 size() const override;
 };
 
+#ifdef HAS_MMAP
+
+#include "common/memstream.h"
+
+/**
+ * A read-only file stream which maps the whole file into memory.
+ *
+ * Pages are only read from disk when they are accessed and are shared
+ * with the operating system's file cache, so callers which use
+ * getData() instead of read() do not need to copy the file at all.
+ *
+ * This is never used by createReadStream(), since the mapping breaks
+ * (SIGBUS) if the file is truncated while it is mapped, and mapping large
+ * files uses up address space. It is only meant for read-only data files
+ * which are explicitly opened through FSNode::createMappedReadStream().
+ */
+class PosixMmapStream final : public Common::MemoryReadStream {
+public:
+	/**
+	 * Map the file at the given path. Returns nullptr if the file can not
+	 * be opened, is not a regular file or is not worth mapping; callers
+	 * should then use PosixIoStream instead.
+	 */
+	static PosixMmapStream *makeFromPath(const Common::String &path);
+	~PosixMmapStream();
+
+private:
+	PosixMmapStream(void *mapping, uint32 size);
+
+	void *_mapping;
+	uint32 _mappingSize;
+};
+
+#endif
+
 #endif
@@ -25,8 +25,14 @@ MODULE_OBJS := \
 	midi/timidity.o \
 	saves/savefile.o \
 	saves/default/default-saves.o \
+	threads/default/default-threadpool.o \
 	timer/default/default-timer.o
 
+ifdef HAS_PTHREADS
+MODULE_OBJS += \
+	threads/pthread/pthread-threadpool.o
+endif
+
 ifdef USE_CLOUD
 ifdef USE_LIBCURL
 MODULE_OBJS += \
@@ -192,6 +198,7 @@ MODULE_OBJS += \
 	mixer/sdl/sdl-mixer.o \
 	mixer/null/null-mixer.o \
 	mutex/sdl/sdl-mutex.o \
+	threads/sdl/sdl-threadpool.o \
 	timer/sdl/sdl-timer.o
 
 ifndef RISCOS
@@ -49,6 +49,9 @@ typedef void (*sighandler_t)(int);
 #if defined(USE_NULL_DRIVER)
 #include "backends/modular-backend.h"
 #include "backends/mutex/null/null-mutex.h"
+#ifdef HAS_PTHREADS
+#include "backends/threads/pthread/pthread-threadpool.h"
+#endif
 #include "base/main.h"
 
 #ifndef NULL_DRIVER_USE_FOR_TEST
@@ -85,6 +88,9 @@ public:
 	virtual bool pollEvent(Common::Event &event);
 
 	virtual Common::MutexInternal *createMutex();
+#ifdef HAS_PTHREADS
+	virtual Common::ThreadPool *getThreadPool();
+#endif
 	virtual uint32 getMillis(bool skipRecord = false);
 	virtual void delayMillis(uint msecs);
 	virtual void getTimeAndDate(TimeDate &td, bool skipRecord = false) const;
@@ -187,9 +193,24 @@ bool OSystem_NULL::pollEvent(Common::Event &event) {
 }
 
 Common::MutexInternal *OSystem_NULL::createMutex() {
+#ifdef HAS_PTHREADS
+	// Code running on the thread pool needs working mutexes
+	return createPthreadThreadPoolMutex();
+#else
 	return new NullMutexInternal();
+#endif
 }
 
+#ifdef HAS_PTHREADS
+Common::ThreadPool *OSystem_NULL::getThreadPool() {
+	// The workers are only started once needed, as the tests create
+	// many instances of the backend
+	if (!_threadPool)
+		_threadPool = createPthreadThreadPool();
+	return _threadPool;
+}
+#endif
+
 uint32 OSystem_NULL::getMillis(bool skipRecord) {
 #ifdef POSIX
 	timeval curTime;
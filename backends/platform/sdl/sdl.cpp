@@ -47,6 +47,7 @@
 #include "backends/keymapper/hardware-input.h"
 #include "backends/mutex/sdl/sdl-mutex.h"
 #include "backends/timer/sdl/sdl-timer.h"
+#include "backends/threads/sdl/sdl-threadpool.h"
 #include "backends/graphics/surfacesdl/surfacesdl-graphics.h"
 #ifdef USE_OPENGL
 #include "backends/graphics/openglsdl/openglsdl-graphics.h"
@@ -141,6 +142,9 @@ OSystem_SDL::~OSystem_SDL() {
 
 	_timerManager = nullptr;
 
+	delete _threadPool;
+	_threadPool = nullptr;
+
 	delete _logger;
 	_logger = nullptr;
 
@@ -775,6 +779,13 @@ Common::TimerManager *OSystem_SDL::getTimerManager() {
 #endif
 }
 
+Common::ThreadPool *OSystem_SDL::getThreadPool() {
+	// The workers are only started once something needs them
+	if (_threadPool == nullptr)
+		_threadPool = createSdlThreadPool();
+	return _threadPool;
+}
+
 AudioCDManager *OSystem_SDL::createAudioCDManager() {
 	// Audio CD support was removed with SDL 2.0
 #if SDL_VERSION_ATLEAST(2, 0, 0)
@@ -88,6 +88,7 @@ public:
 	void getTimeAndDate(TimeDate &td, bool skipRecord = false) const override;
 	MixerManager *getMixerManager() override;
 	Common::TimerManager *getTimerManager() override;
+	Common::ThreadPool *getThreadPool() override;
 	Common::SaveFileManager *getSavefileManager() override;
 	uint32 getDoubleClickTime() const override;
 
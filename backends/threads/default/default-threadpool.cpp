@@ -0,0 +1,191 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "backends/threads/default/default-threadpool.h"
+
+#include "common/textconsole.h"
+#include "common/util.h"
+
+DefaultThreadPool::DefaultThreadPool() :
+	_numWorkers(0), _numQueued(0), _numSleeping(0), _numWaiting(0), _quit(false) {
+}
+
+DefaultThreadPool::~DefaultThreadPool() {
+	for (uint i = 0; i < _queues.size(); i++) {
+		delete _queues[i]->mutex;
+		delete _queues[i];
+	}
+}
+
+void DefaultThreadPool::startWorkers(uint numWorkers) {
+	numWorkers = MIN(numWorkers, kMaxWorkers);
+
+	// One queue per worker, and the shared one for other threads
+	for (uint i = 0; i <= numWorkers; i++) {
+		TaskQueue *queue = new TaskQueue();
+		queue->mutex = createQueueMutex();
+		queue->head = 0;
+		_queues.push_back(queue);
+	}
+
+	for (uint i = 0; i < numWorkers; i++) {
+		if (!createThread(i)) {
+			warning("DefaultThreadPool: Could only start %d of %d workers", i, numWorkers);
+			break;
+		}
+		_numWorkers++;
+	}
+}
+
+void DefaultThreadPool::stopWorkers() {
+	lockState();
+	_quit = true;
+	notifyState();
+	unlockState();
+
+	joinThreads();
+	_numWorkers = 0;
+}
+
+uint DefaultThreadPool::getCurrentQueue() const {
+	int worker = getCurrentWorker();
+	return worker < 0 ? _queues.size() - 1 : worker;
+}
+
+void DefaultThreadPool::submit(Common::Task *task, Common::TaskGroup &group) {
+	QueuedTask queued;
+	queued.task = task;
+	queued.group = &group;
+
+	// Count the task first, so the group cannot be seen as done while
+	// the task waits in a queue
+	lockState();
+	pendingTasks(group)++;
+	_numQueued++;
+	if (_numSleeping || _numWaiting)
+		notifyState();
+	unlockState();
+
+	TaskQueue *queue = _queues[getCurrentQueue()];
+	queue->mutex->lock();
+	queue->tasks.push_back(queued);
+	queue->mutex->unlock();
+}
+
+bool DefaultThreadPool::findTask(uint queue, QueuedTask &task) {
+	bool found = false;
+
+	// Newest task of the own queue first, as its data is likely still cached
+	TaskQueue *own = _queues[queue];
+	own->mutex->lock();
+	if (own->tasks.size() > own->head) {
+		task = own->tasks.back();
+		own->tasks.pop_back();
+		found = true;
+	}
+	if (own->tasks.size() == own->head) {
+		own->tasks.clear();
+		own->head = 0;
+	}
+	own->mutex->unlock();
+
+	// Otherwise the oldest task of another queue
+	for (uint i = 1; i < _queues.size() && !found; i++) {
+		TaskQueue *other = _queues[(queue + i) % _queues.size()];
+		other->mutex->lock();
+		if (other->tasks.size() > other->head) {
+			task = other->tasks[other->head++];
+			found = true;
+		}
+		if (other->tasks.size() == other->head) {
+			other->tasks.clear();
+			other->head = 0;
+		}
+		other->mutex->unlock();
+	}
+
+	if (found) {
+		lockState();
+		_numQueued--;
+		unlockState();
+	}
+	return found;
+}
+
+void DefaultThreadPool::runTask(const QueuedTask &task) {
+	task.task->run();
+
+	lockState();
+	if (--pendingTasks(*task.group) == 0 && _numWaiting)
+		notifyState();
+	unlockState();
+}
+
+void DefaultThreadPool::wait(Common::TaskGroup &group) {
+	const uint queue = getCurrentQueue();
+	QueuedTask task;
+
+	while (true) {
+		lockState();
+		bool done = pendingTasks(group) == 0;
+		unlockState();
+		if (done)
+			return;
+
+		if (findTask(queue, task)) {
+			runTask(task);
+			continue;
+		}
+
+		// The remaining tasks of the group run on other threads
+		lockState();
+		while (pendingTasks(group) != 0 && _numQueued <= 0) {
+			_numWaiting++;
+			waitState();
+			_numWaiting--;
+		}
+		unlockState();
+	}
+}
+
+void DefaultThreadPool::workerMain(uint index) {
+	QueuedTask task;
+
+	while (true) {
+		if (findTask(index, task)) {
+			runTask(task);
+			continue;
+		}
+
+		lockState();
+		while (_numQueued <= 0 && !_quit) {
+			_numSleeping++;
+			waitState();
+			_numSleeping--;
+		}
+		bool quit = _quit && _numQueued <= 0;
+		unlockState();
+
+		if (quit)
+			return;
+	}
+}
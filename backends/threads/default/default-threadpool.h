@@ -0,0 +1,115 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef BACKENDS_THREADS_DEFAULT_H
+#define BACKENDS_THREADS_DEFAULT_H
+
+#include "common/array.h"
+#include "common/mutex.h"
+#include "common/threadpool.h"
+
+/**
+ * Work stealing scheduler for Common::ThreadPool.
+ *
+ * Every worker has its own task queue. Tasks submitted from a worker
+ * go to its queue, which it runs newest first. Idle workers take the
+ * oldest tasks from the queues of the others. Tasks submitted from
+ * other threads go to a shared queue.
+ *
+ * Subclasses provide the threads and the synchronization primitives.
+ * They must call startWorkers() in their constructor and stopWorkers()
+ * in their destructor.
+ */
+class DefaultThreadPool : public Common::ThreadPool {
+public:
+	/** Upper bound for the number of workers, whatever the number of CPUs. */
+	static const uint kMaxWorkers = 16;
+
+	DefaultThreadPool();
+	virtual ~DefaultThreadPool();
+
+	uint getNumWorkers() const override { return _numWorkers; }
+	void submit(Common::Task *task, Common::TaskGroup &group) override;
+	void wait(Common::TaskGroup &group) override;
+
+protected:
+	/**
+	 * Start the workers. Fewer workers are used if creating a thread
+	 * fails.
+	 */
+	void startWorkers(uint numWorkers);
+
+	/** Run the remaining tasks and stop all workers. */
+	void stopWorkers();
+
+	/** Main loop of the worker with the given index. */
+	void workerMain(uint index);
+
+	/** Start a thread calling workerMain(index). */
+	virtual bool createThread(uint index) = 0;
+
+	/** Wait for all threads started by createThread() to end. */
+	virtual void joinThreads() = 0;
+
+	/** Return the index of the calling worker, or -1 for other threads. */
+	virtual int getCurrentWorker() const = 0;
+
+	/** Create a mutex protecting one task queue. */
+	virtual Common::MutexInternal *createQueueMutex() = 0;
+
+	/**
+	 * Lock and unlock the scheduler state. waitState() is called with
+	 * the state locked, and sleeps until notifyState() is called.
+	 */
+	virtual void lockState() = 0;
+	virtual void unlockState() = 0;
+	virtual void waitState() = 0;
+	virtual void notifyState() = 0;
+
+private:
+	struct QueuedTask {
+		Common::Task *task;
+		Common::TaskGroup *group;
+	};
+
+	struct TaskQueue {
+		Common::MutexInternal *mutex;
+		Common::Array<QueuedTask> tasks;
+		// Tasks before this index were taken by other workers
+		uint head;
+	};
+
+	bool findTask(uint queue, QueuedTask &task);
+	void runTask(const QueuedTask &task);
+	uint getCurrentQueue() const;
+
+	Common::Array<TaskQueue *> _queues;
+	uint _numWorkers;
+
+	// Protected by the state lock
+	int _numQueued;
+	uint _numSleeping;
+	uint _numWaiting;
+	bool _quit;
+};
+
+#endif
@@ -0,0 +1,151 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#define FORBIDDEN_SYMBOL_EXCEPTION_time_h
+#define FORBIDDEN_SYMBOL_EXCEPTION_unistd_h
+
+#include "common/scummsys.h"
+
+#if defined(HAS_PTHREADS)
+
+#include "backends/threads/pthread/pthread-threadpool.h"
+#include "backends/threads/default/default-threadpool.h"
+
+#include "common/textconsole.h"
+
+#include <pthread.h>
+#include <unistd.h>
+
+namespace {
+
+class PthreadPoolMutex final : public Common::MutexInternal {
+public:
+	PthreadPoolMutex() {
+		pthread_mutexattr_t attr;
+		pthread_mutexattr_init(&attr);
+		pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+		pthread_mutex_init(&_mutex, &attr);
+		pthread_mutexattr_destroy(&attr);
+	}
+	~PthreadPoolMutex() override { pthread_mutex_destroy(&_mutex); }
+
+	bool lock() override { return pthread_mutex_lock(&_mutex) == 0; }
+	bool unlock() override { return pthread_mutex_unlock(&_mutex) == 0; }
+
+private:
+	pthread_mutex_t _mutex;
+};
+
+} // End of anonymous namespace
+
+/**
+ * pthreads thread pool
+ */
+class PthreadThreadPool final : public DefaultThreadPool {
+public:
+	PthreadThreadPool();
+	~PthreadThreadPool() override;
+
+protected:
+	bool createThread(uint index) override;
+	void joinThreads() override;
+	int getCurrentWorker() const override;
+	Common::MutexInternal *createQueueMutex() override { return new PthreadPoolMutex(); }
+
+	void lockState() override { pthread_mutex_lock(&_stateMutex); }
+	void unlockState() override { pthread_mutex_unlock(&_stateMutex); }
+	void waitState() override { pthread_cond_wait(&_stateCond, &_stateMutex); }
+	void notifyState() override { pthread_cond_broadcast(&_stateCond); }
+
+private:
+	struct Worker {
+		PthreadThreadPool *pool;
+		uint index;
+		pthread_t thread;
+	};
+
+	static void *threadProc(void *arg);
+
+	Worker _workers[kMaxWorkers];
+	uint _numThreads;
+	pthread_mutex_t _stateMutex;
+	pthread_cond_t _stateCond;
+};
+
+PthreadThreadPool::PthreadThreadPool() : _numThreads(0) {
+	pthread_mutex_init(&_stateMutex, nullptr);
+	pthread_cond_init(&_stateCond, nullptr);
+
+	// The thread waiting for the tasks runs them too
+	long numCPUs = sysconf(_SC_NPROCESSORS_ONLN);
+	startWorkers(numCPUs > 1 ? numCPUs - 1 : 0);
+}
+
+PthreadThreadPool::~PthreadThreadPool() {
+	stopWorkers();
+
+	pthread_cond_destroy(&_stateCond);
+	pthread_mutex_destroy(&_stateMutex);
+}
+
+void *PthreadThreadPool::threadProc(void *arg) {
+	Worker *worker = (Worker *)arg;
+	worker->pool->workerMain(worker->index);
+	return nullptr;
+}
+
+bool PthreadThreadPool::createThread(uint index) {
+	Worker &worker = _workers[index];
+	worker.pool = this;
+	worker.index = index;
+	if (pthread_create(&worker.thread, nullptr, threadProc, &worker) != 0) {
+		warning("pthread_create() failed");
+		return false;
+	}
+	_numThreads = index + 1;
+	return true;
+}
+
+void PthreadThreadPool::joinThreads() {
+	for (uint i = 0; i < _numThreads; i++)
+		pthread_join(_workers[i].thread, nullptr);
+	_numThreads = 0;
+}
+
+int PthreadThreadPool::getCurrentWorker() const {
+	pthread_t self = pthread_self();
+	for (uint i = 0; i < _numThreads; i++) {
+		if (pthread_equal(_workers[i].thread, self))
+			return i;
+	}
+	return -1;
+}
+
+Common::ThreadPool *createPthreadThreadPool() {
+	return new PthreadThreadPool();
+}
+
+Common::MutexInternal *createPthreadThreadPoolMutex() {
+	return new PthreadPoolMutex();
+}
+
+#endif
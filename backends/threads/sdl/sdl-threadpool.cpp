@@ -0,0 +1,154 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+
+#if defined(SDL_BACKEND)
+
+#include "backends/threads/sdl/sdl-threadpool.h"
+#include "backends/threads/default/default-threadpool.h"
+#include "backends/platform/sdl/sdl-sys.h"
+
+#include "common/textconsole.h"
+
+namespace {
+
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+typedef SDL_threadID ThreadID;
+#else
+typedef Uint32 ThreadID;
+#endif
+
+class SdlQueueMutex final : public Common::MutexInternal {
+public:
+	SdlQueueMutex() { _mutex = SDL_CreateMutex(); }
+	~SdlQueueMutex() override { SDL_DestroyMutex(_mutex); }
+
+	bool lock() override { return (SDL_mutexP(_mutex) == 0); }
+	bool unlock() override { return (SDL_mutexV(_mutex) == 0); }
+
+private:
+	SDL_mutex *_mutex;
+};
+
+} // End of anonymous namespace
+
+/**
+ * SDL thread pool
+ */
+class SdlThreadPool final : public DefaultThreadPool {
+public:
+	SdlThreadPool();
+	~SdlThreadPool() override;
+
+protected:
+	bool createThread(uint index) override;
+	void joinThreads() override;
+	int getCurrentWorker() const override;
+	Common::MutexInternal *createQueueMutex() override { return new SdlQueueMutex(); }
+
+	void lockState() override { SDL_mutexP(_stateMutex); }
+	void unlockState() override { SDL_mutexV(_stateMutex); }
+	void waitState() override { SDL_CondWait(_stateCond, _stateMutex); }
+	void notifyState() override { SDL_CondBroadcast(_stateCond); }
+
+private:
+	struct Worker {
+		SdlThreadPool *pool;
+		uint index;
+		SDL_Thread *thread;
+		ThreadID id;
+	};
+
+	static int SDLCALL threadProc(void *arg);
+
+	Worker _workers[kMaxWorkers];
+	uint _numThreads;
+	SDL_mutex *_stateMutex;
+	SDL_cond *_stateCond;
+};
+
+SdlThreadPool::SdlThreadPool() : _numThreads(0) {
+	_stateMutex = SDL_CreateMutex();
+	_stateCond = SDL_CreateCond();
+
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	// The thread waiting for the tasks runs them too
+	int numCPUs = SDL_GetCPUCount();
+	startWorkers(numCPUs > 1 ? numCPUs - 1 : 0);
+#else
+	// SDL 1.2 cannot tell the number of CPUs
+	startWorkers(1);
+#endif
+}
+
+SdlThreadPool::~SdlThreadPool() {
+	stopWorkers();
+
+	SDL_DestroyCond(_stateCond);
+	SDL_DestroyMutex(_stateMutex);
+}
+
+int SDLCALL SdlThreadPool::threadProc(void *arg) {
+	Worker *worker = (Worker *)arg;
+	worker->pool->workerMain(worker->index);
+	return 0;
+}
+
+bool SdlThreadPool::createThread(uint index) {
+	Worker &worker = _workers[index];
+	worker.pool = this;
+	worker.index = index;
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	worker.thread = SDL_CreateThread(threadProc, "ScummVM worker", &worker);
+#else
+	worker.thread = SDL_CreateThread(threadProc, &worker);
+#endif
+	if (!worker.thread) {
+		warning("SDL_CreateThread() failed: %s", SDL_GetError());
+		return false;
+	}
+	worker.id = SDL_GetThreadID(worker.thread);
+	_numThreads = index + 1;
+	return true;
+}
+
+void SdlThreadPool::joinThreads() {
+	for (uint i = 0; i < _numThreads; i++)
+		SDL_WaitThread(_workers[i].thread, nullptr);
+	_numThreads = 0;
+}
+
+int SdlThreadPool::getCurrentWorker() const {
+	ThreadID self = SDL_ThreadID();
+	for (uint i = 0; i < _numThreads; i++) {
+		if (_workers[i].id == self)
+			return i;
+	}
+	return -1;
+}
+
+Common::ThreadPool *createSdlThreadPool() {
+	return new SdlThreadPool();
+}
+
+#endif
@@ -25,6 +25,7 @@
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "common/memstream.h"
+#include "common/mutex.h"
 #include "common/punycode.h"
 #include "common/debug.h"
 
@@ -250,6 +251,57 @@ uint MemcachingCaseInsensitiveArchive::CacheKey_Hash::operator()(const CacheKey
 	return static_cast<uint>(hashit_lower(x.path) * 1000003u) ^ static_cast<uint>(x.altStreamType);
 };
 
+// Bumped whenever any SearchSet changes, as SearchSets may be nested
+static uint32 g_searchSetGeneration = 1;
+
+// Upper bound for the number of remembered lookups per SearchSet
+static const uint kMaxLookupCacheSize = 8192;
+
+SearchSet::SearchSet() : _ignoreClashes(false), _lookupCacheGeneration(0), _lookupCacheMutex(nullptr) {
+	// Without an OSystem there are no other threads to guard against
+	if (g_system)
+		_lookupCacheMutex = new Mutex();
+}
+
+SearchSet::~SearchSet() {
+	clear();
+	delete _lookupCacheMutex;
+}
+
+void SearchSet::invalidateLookupCaches() {
+	g_searchSetGeneration++;
+}
+
+bool SearchSet::findCachedLookup(const Path &path, Archive *&archive) const {
+	if (_lookupCacheMutex)
+		_lookupCacheMutex->lock();
+
+	bool found = false;
+	if (_lookupCacheGeneration != g_searchSetGeneration) {
+		_lookupCache.clear();
+		_lookupCacheGeneration = g_searchSetGeneration;
+	} else {
+		found = _lookupCache.tryGetVal(path, archive);
+	}
+
+	if (_lookupCacheMutex)
+		_lookupCacheMutex->unlock();
+	return found;
+}
+
+void SearchSet::cacheLookup(const Path &path, Archive *archive) const {
+	if (_lookupCacheMutex)
+		_lookupCacheMutex->lock();
+
+	if (_lookupCache.size() >= kMaxLookupCacheSize)
+		_lookupCache.clear();
+
+	_lookupCache.setVal(path, archive);
+
+	if (_lookupCacheMutex)
+		_lookupCacheMutex->unlock();
+}
+
 SearchSet::ArchiveNodeList::iterator SearchSet::find(const String &name) {
 	ArchiveNodeList::iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
@@ -280,6 +332,7 @@ void SearchSet::insert(const Node &node) {
 			break;
 	}
 	_list.insert(it, node);
+	invalidateLookupCaches();
 }
 
 void SearchSet::add(const String &name, Archive *archive, int priority, bool autoFree) {
@@ -361,6 +414,7 @@ void SearchSet::remove(const String &name) {
 		if (it->_autoFree)
 			delete it->_arc;
 		_list.erase(it);
+		invalidateLookupCaches();
 	}
 }
 
@@ -384,6 +438,7 @@ void SearchSet::clear() {
 	}
 
 	_list.clear();
+	invalidateLookupCaches();
 }
 
 void SearchSet::setPriority(const String &name, int priority) {
@@ -406,12 +461,19 @@ bool SearchSet::hasFile(const Path &path) const {
 	if (path.empty())
 		return false;
 
+	Archive *cached;
+	if (findCachedLookup(path, cached))
+		return cached != nullptr;
+
 	ArchiveNodeList::const_iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
-		if (it->_arc->hasFile(path))
+		if (it->_arc->hasFile(path)) {
+			cacheLookup(path, it->_arc);
 			return true;
+		}
 	}
 
+	cacheLookup(path, nullptr);
 	return false;
 }
 
@@ -476,9 +538,21 @@ const ArchiveMemberPtr SearchSet::getMember(const Path &path, Archive **containe
 	if (path.empty())
 		return ArchiveMemberPtr();
 
+	Archive *cached;
+	if (findCachedLookup(path, cached)) {
+		if (!cached)
+			return ArchiveMemberPtr();
+
+		if (container) {
+			*container = cached;
+		}
+		return cached->getMember(path);
+	}
+
 	ArchiveNodeList::const_iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
 		if (it->_arc->hasFile(path)) {
+			cacheLookup(path, it->_arc);
 			if (container) {
 				*container = it->_arc;
 			}
@@ -486,6 +560,7 @@ const ArchiveMemberPtr SearchSet::getMember(const Path &path, Archive **containe
 		}
 	}
 
+	cacheLookup(path, nullptr);
 	return ArchiveMemberPtr();
 }
 
@@ -494,16 +569,39 @@ const ArchiveMemberPtr SearchSet::getMember(const Path &path) const {
 }
 
 SeekableReadStream *SearchSet::createReadStreamForMember(const Path &path) const {
+	return createReadStreamForMember(path, false);
+}
+
+SeekableReadStream *SearchSet::createMappedReadStreamForMember(const Path &path) const {
+	return createReadStreamForMember(path, true);
+}
+
+SeekableReadStream *SearchSet::createReadStreamForMember(const Path &path, bool mapped) const {
 	if (path.empty())
 		return nullptr;
 
+	Archive *cached;
+	if (findCachedLookup(path, cached)) {
+		if (!cached)
+			return nullptr;
+
+		SeekableReadStream *stream = mapped ? cached->createMappedReadStreamForMember(path) : cached->createReadStreamForMember(path);
+		if (stream)
+			return stream;
+
+		// The archive failed to open the file after all, so search again
+	}
+
 	ArchiveNodeList::const_iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
-		SeekableReadStream *stream = it->_arc->createReadStreamForMember(path);
-		if (stream)
+		SeekableReadStream *stream = mapped ? it->_arc->createMappedReadStreamForMember(path) : it->_arc->createReadStreamForMember(path);
+		if (stream) {
+			cacheLookup(path, it->_arc);
 			return stream;
+		}
 	}
 
+	cacheLookup(path, nullptr);
 	return nullptr;
 }
 
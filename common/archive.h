@@ -25,6 +25,7 @@
 #include "common/str.h"
 #include "common/list.h"
 #include "common/path.h"
+#include "common/flathashmap.h"
 #include "common/ptr.h"
 #include "common/hashmap.h"
 #include "common/hash-str.h"
@@ -103,6 +104,7 @@ struct ArchiveMemberListComparator {
 };
 
 class Archive;
+class Mutex;
 
 /**
  * Simple ArchiveMember implementation which allows
@@ -193,6 +195,19 @@ public:
 	 */
 	virtual SeekableReadStream *createReadStreamForMemberAltStream(const Path &path, AltStreamType altStreamType) const;
 
+	/**
+	 * Create a stream bound to a member with the specified name in the
+	 * archive, which may map the file into memory instead of reading it.
+	 * See FSNode::createMappedReadStream() for when this is safe to use.
+	 * Archives which can not map their members return the same stream as
+	 * createReadStreamForMember().
+	 *
+	 * @return The newly created input stream.
+	 */
+	virtual SeekableReadStream *createMappedReadStreamForMember(const Path &path) const {
+		return createReadStreamForMember(path);
+	}
+
 	/**
 	 * For most archives: same as previous. For SearchSet see SearchSet
 	 * documentation.
@@ -298,7 +313,7 @@ private:
 
 	SeekableReadStream *createReadStreamForMemberImpl(const Path &path, bool isAltStream, Common::AltStreamType altStreamType) const;
 
-	mutable HashMap<CacheKey, SharedArchiveContents, CacheKey_Hash, CacheKey_EqualTo> _cache;
+	mutable FlatHashMap<CacheKey, SharedArchiveContents, CacheKey_Hash, CacheKey_EqualTo> _cache;
 	uint32 _maxStronglyCachedSize;
 };
 
@@ -330,9 +345,25 @@ class SearchSet : public Archive {
 
 	bool _ignoreClashes;
 
+	/**
+	 * Remembers which archive, if any, a path was found in, so repeated
+	 * lookups do not have to probe every archive. A null archive records
+	 * that no archive contains the path. Lookups may run on several threads
+	 * at once, so the cache is guarded by _lookupCacheMutex.
+	 */
+	typedef FlatHashMap<Path, Archive *, Path::IgnoreCaseAndMac_Hash, Path::IgnoreCaseAndMac_EqualsTo> LookupCache;
+	mutable LookupCache _lookupCache;
+	mutable uint32 _lookupCacheGeneration;
+	Mutex *_lookupCacheMutex;
+
+	bool findCachedLookup(const Path &path, Archive *&archive) const;
+	void cacheLookup(const Path &path, Archive *archive) const;
+
+	SeekableReadStream *createReadStreamForMember(const Path &path, bool mapped) const;
+
 public:
-	SearchSet() : _ignoreClashes(false) { }
-	virtual ~SearchSet() { clear(); }
+	SearchSet();
+	virtual ~SearchSet();
 
 	/**
 	 * Add a new archive to the searchable set.
@@ -440,6 +471,12 @@ public:
 	 */
 	SeekableReadStream *createReadStreamForMemberAltStream(const Path &path, AltStreamType altStreamType) const override;
 
+	/**
+	 * Implement createMappedReadStreamForMember from the Archive base class. The same
+	 * policy as for createReadStreamForMember is used.
+	 */
+	SeekableReadStream *createMappedReadStreamForMember(const Path &path) const override;
+
 	/**
 	 * Similar to above but exclude matches from archives before starting and starting itself.
 	 */
@@ -450,6 +487,18 @@ public:
 	 * in @ref FSDirectory documentation.
 	 */
 	void setIgnoreClashes(bool ignoreClashes) { _ignoreClashes = ignoreClashes; }
+
+	/**
+	 * Forget the results of previous lookups in all SearchSets.
+	 *
+	 * SearchSets remember in which archive a file was found, or that it was
+	 * not found at all. This happens automatically whenever an archive is
+	 * added to or removed from any SearchSet, and whenever a file or
+	 * directory is created through FSNode. Code which changes the contents
+	 * of an archive that is already part of a SearchSet in another way needs
+	 * to call this.
+	 */
+	static void invalidateLookupCaches();
 };
 
 
@@ -66,6 +66,49 @@ ReadStream *wrapBufferedReadStream(ReadStream *parentStream, uint32 bufSize, Dis
  */
 SeekableReadStream *wrapBufferedSeekableReadStream(SeekableReadStream *parentStream, uint32 bufSize, DisposeAfterUse::Flag disposeParentStream);
 
+/**
+ * Take an arbitrary SeekableReadStream and wrap it in a custom stream that
+ * transparently provides buffering, adapting the buffer size to the way
+ * the stream is accessed.
+ *
+ * While the stream is read sequentially, every refill reads twice as much
+ * data as the previous one, up to maxBufSize. Any other access starts over
+ * with minBufSize. The last few blocks which were read are kept, so
+ * seeking back a short distance does not read the data again. This suits
+ * streaming consumers like video and audio decoders, which mostly read
+ * sequentially but occasionally jump back to an earlier chunk.
+ *
+ * It is safe to call this with a NULL parameter (in this case, NULL is
+ * returned).
+ *
+ * @param parentStream        The SeekableReadStream to wrap in a custom stream.
+ * @param minBufSize          Size of the buffer after a seek.
+ * @param maxBufSize          Size the buffer may grow to during sequential reads.
+ * @param disposeParentStream Flag indicating whether to dispose of the wrapped stream.
+ */
+SeekableReadStream *wrapAdaptiveBufferedSeekableReadStream(SeekableReadStream *parentStream, uint32 minBufSize, uint32 maxBufSize, DisposeAfterUse::Flag disposeParentStream);
+
+/**
+ * Counters describing how a stream returned by
+ * wrapAdaptiveBufferedSeekableReadStream accessed its wrapped stream.
+ */
+struct BufferedStreamStats {
+	uint32 refills;     ///< Number of reads from the wrapped stream.
+	uint64 bytesRead;   ///< Bytes read from the wrapped stream.
+	uint32 blockHits;   ///< Seeks which were served from a previously read block.
+	uint32 timeBlocked; ///< Milliseconds spent waiting for the wrapped stream.
+};
+
+/**
+ * Query the counters of a stream returned by
+ * wrapAdaptiveBufferedSeekableReadStream.
+ *
+ * @param stream  The stream to query.
+ * @param stats   Receives the counters.
+ * @return false in case @p stream is not an adaptive buffered stream.
+ */
+bool getBufferedStreamStats(const ReadStream *stream, BufferedStreamStats &stats);
+
 /**
  * Take an arbitrary WriteStream and wrap it in a custom stream that
  * transparently provides buffering.
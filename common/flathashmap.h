@@ -0,0 +1,595 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_FLATHASHMAP_H
+#define COMMON_FLATHASHMAP_H
+
+#include "common/func.h"
+#include "common/hashmap.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_flathashmap Flat hash table (FlatHashMap)
+ * @ingroup common
+ *
+ * @brief API for operations on a flat, open addressed hash table.
+ *
+ * @{
+ */
+
+/**
+ * FlatHashMap<Key,Val> maps objects of type Key to objects of type Val, like
+ * HashMap does, and provides the same interface.
+ *
+ * Unlike HashMap, the nodes are stored inline in the table instead of being
+ * allocated separately, and each slot remembers the hash of its key. A lookup
+ * thus touches a single contiguous array, keys are only compared when their
+ * hashes match, and growing the table never calls the hash functor again.
+ * The table uses linear probing.
+ *
+ * The lookup methods (find, contains, getValOrDefault and tryGetVal) accept
+ * any type the hash and equality functors can handle. For example, a map with
+ * IgnoreCase_Hash and IgnoreCase_EqualTo can be queried with a plain
+ * const char * without building a temporary String.
+ *
+ * @note As nodes are stored inline, references and pointers to keys and values
+ *       are invalidated whenever the map grows, i.e. when a new key is
+ *       inserted. Erasing does not move any other node, so it is safe to erase
+ *       the current element while iterating.
+ */
+template<class Key, class Val, class HashFunc = Hash<Key>, class EqualFunc = EqualTo<Key> >
+class FlatHashMap {
+public:
+	typedef uint size_type;
+
+	struct Node {
+		Val _value;
+		const Key _key;
+		explicit Node(const Key &key) : _value(), _key(key) {}
+		Node(const Key &key, const Val &value) : _value(value), _key(key) {}
+	};
+
+private:
+
+	typedef FlatHashMap<Key, Val, HashFunc, EqualFunc> FHM_t;
+
+	enum {
+		FLATHASHMAP_MIN_CAPACITY = 16,
+
+		// The quotient of the next two constants controls how much the
+		// internal storage of the hashmap may fill up before being
+		// increased automatically. Deleted slots count as used.
+		FLATHASHMAP_LOADFACTOR_NUMERATOR = 2,
+		FLATHASHMAP_LOADFACTOR_DENOMINATOR = 3
+	};
+
+	enum {
+		kSlotEmpty = 0,
+		kSlotDeleted = 1,
+		kSlotFirstHash = 2
+	};
+
+	struct Slot {
+		uint _keyHash;	///< kSlotEmpty, kSlotDeleted or the (adjusted) hash of the key
+		union {
+			Node _node;
+		};
+
+		Slot() : _keyHash(kSlotEmpty) {}
+		~Slot() {}
+
+		bool isUsed() const { return _keyHash >= kSlotFirstHash; }
+	};
+
+	/** Default value, returned by the const getVal. */
+	Val _defaultVal;
+
+	Slot *_slots;
+	size_type _mask;	///< Capacity of the map minus one; capacity is a power of two
+	size_type _size;
+	size_type _deleted;	///< Number of slots holding a deleted marker
+
+	HashFunc _hash;
+	EqualFunc _equal;
+
+	template<class LookupKey>
+	uint slotHash(const LookupKey &key) const {
+		const uint hash = _hash(key);
+		return hash < (uint)kSlotFirstHash ? hash + kSlotFirstHash : hash;
+	}
+
+	size_type firstIndex(uint hash) const {
+		return (hash ^ (hash >> 16)) & _mask;
+	}
+
+	void assign(const FHM_t &map);
+	void destroyNodes();
+	template<class LookupKey>
+	size_type lookup(const LookupKey &key) const;
+	size_type insertNew(const Key &key, uint hash);
+	void rehash(size_type newCapacity);
+	void allocStorage(size_type capacity);
+
+	template<class NodeType>
+	class IteratorImpl {
+		friend class FlatHashMap;
+		template<class T> friend class IteratorImpl;
+	protected:
+		typedef const FlatHashMap hashmap_t;
+
+		size_type _idx;
+		hashmap_t *_hashmap;
+
+	protected:
+		IteratorImpl(size_type idx, hashmap_t *hashmap) : _idx(idx), _hashmap(hashmap) {}
+
+		NodeType *deref() const {
+			assert(_hashmap != nullptr);
+			assert(_idx <= _hashmap->_mask);
+			assert(_hashmap->_slots[_idx].isUsed());
+			return &_hashmap->_slots[_idx]._node;
+		}
+
+	public:
+		IteratorImpl() : _idx(0), _hashmap(nullptr) {}
+		template<class T>
+		IteratorImpl(const IteratorImpl<T> &c) : _idx(c._idx), _hashmap(c._hashmap) {}
+
+		NodeType &operator*() const { return *deref(); }
+		NodeType *operator->() const { return deref(); }
+
+		bool operator==(const IteratorImpl &iter) const { return _idx == iter._idx && _hashmap == iter._hashmap; }
+		bool operator!=(const IteratorImpl &iter) const { return !(*this == iter); }
+
+		IteratorImpl &operator++() {
+			assert(_hashmap);
+			do {
+				_idx++;
+			} while (_idx <= _hashmap->_mask && !_hashmap->_slots[_idx].isUsed());
+			if (_idx > _hashmap->_mask)
+				_idx = (size_type)-1;
+
+			return *this;
+		}
+
+		IteratorImpl operator++(int) {
+			IteratorImpl old = *this;
+			operator ++();
+			return old;
+		}
+	};
+
+public:
+	typedef IteratorImpl<Node> iterator;
+	typedef IteratorImpl<const Node> const_iterator;
+
+	FlatHashMap();
+	FlatHashMap(const FHM_t &map);
+	~FlatHashMap();
+
+	FHM_t &operator=(const FHM_t &map) {
+		if (this == &map)
+			return *this;
+
+		// Remove the previous content and ...
+		destroyNodes();
+		delete[] _slots;
+		// ... copy the new stuff.
+		assign(map);
+		return *this;
+	}
+
+	template<class LookupKey>
+	bool contains(const LookupKey &key) const {
+		return _slots[lookup(key)].isUsed();
+	}
+
+	Val &operator[](const Key &key);
+	const Val &operator[](const Key &key) const;
+
+	Val &getOrCreateVal(const Key &key);
+	Val &getVal(const Key &key);
+	const Val &getVal(const Key &key) const;
+
+	template<class LookupKey>
+	const Val &getValOrDefault(const LookupKey &key) const {
+		return getValOrDefault(key, _defaultVal);
+	}
+
+	template<class LookupKey>
+	const Val &getValOrDefault(const LookupKey &key, const Val &defaultVal) const {
+		const Slot &slot = _slots[lookup(key)];
+		return slot.isUsed() ? slot._node._value : defaultVal;
+	}
+
+	template<class LookupKey>
+	bool tryGetVal(const LookupKey &key, Val &out) const {
+		const Slot &slot = _slots[lookup(key)];
+		if (!slot.isUsed())
+			return false;
+
+		out = slot._node._value;
+		return true;
+	}
+
+	void setVal(const Key &key, const Val &val);
+
+	void clear(bool shrinkArray = 0);
+
+	void erase(iterator entry);
+	void erase(const Key &key);
+
+	size_type size() const { return _size; }
+
+	iterator	begin() {
+		// Find and return the first non-empty entry
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (_slots[ctr].isUsed())
+				return iterator(ctr, this);
+		}
+		return end();
+	}
+	iterator	end() {
+		return iterator((size_type)-1, this);
+	}
+
+	const_iterator	begin() const {
+		// Find and return the first non-empty entry
+		for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+			if (_slots[ctr].isUsed())
+				return const_iterator(ctr, this);
+		}
+		return end();
+	}
+	const_iterator	end() const {
+		return const_iterator((size_type)-1, this);
+	}
+
+	template<class LookupKey>
+	iterator	find(const LookupKey &key) {
+		size_type ctr = lookup(key);
+		if (_slots[ctr].isUsed())
+			return iterator(ctr, this);
+		return end();
+	}
+
+	template<class LookupKey>
+	const_iterator	find(const LookupKey &key) const {
+		size_type ctr = lookup(key);
+		if (_slots[ctr].isUsed())
+			return const_iterator(ctr, this);
+		return end();
+	}
+
+	/** Return true if hashmap is empty. */
+	bool empty() const {
+		return (_size == 0);
+	}
+};
+
+//-------------------------------------------------------
+// FlatHashMap functions
+
+/**
+ * Base constructor, creates an empty hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap() : _defaultVal() {
+	allocStorage(FLATHASHMAP_MIN_CAPACITY);
+}
+
+/**
+ * Copy constructor, creates a full copy of the given hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::FlatHashMap(const FHM_t &map) : _defaultVal() {
+	assign(map);
+}
+
+/**
+ * Destructor, frees all used memory.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+FlatHashMap<Key, Val, HashFunc, EqualFunc>::~FlatHashMap() {
+	destroyNodes();
+	delete[] _slots;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::allocStorage(size_type capacity) {
+	_mask = capacity - 1;
+	_slots = new Slot[capacity];
+	assert(_slots != nullptr);
+
+	_size = 0;
+	_deleted = 0;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::destroyNodes() {
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		if (_slots[ctr].isUsed())
+			_slots[ctr]._node.~Node();
+		_slots[ctr]._keyHash = kSlotEmpty;
+	}
+}
+
+/**
+ * Internal method for assigning the content of another FlatHashMap
+ * to this one.
+ *
+ * @note The previous storage here is *not* deallocated here -- the caller is
+ *       responsible for doing that!
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::assign(const FHM_t &map) {
+	allocStorage(map._mask + 1);
+
+	// The capacity is the same, so every node can keep its slot
+	for (size_type ctr = 0; ctr <= _mask; ++ctr) {
+		const Slot &src = map._slots[ctr];
+		if (src.isUsed()) {
+			new ((void *)&_slots[ctr]._node) Node(src._node._key, src._node._value);
+			_size++;
+		} else if (src._keyHash == kSlotDeleted) {
+			_deleted++;
+		}
+		_slots[ctr]._keyHash = src._keyHash;
+	}
+
+	// Perform a sanity check (to help track down hashmap corruption)
+	assert(_size == map._size);
+	assert(_deleted == map._deleted);
+}
+
+/**
+ * Clear all values in the hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::clear(bool shrinkArray) {
+	destroyNodes();
+
+	if (shrinkArray && _mask >= FLATHASHMAP_MIN_CAPACITY) {
+		delete[] _slots;
+		allocStorage(FLATHASHMAP_MIN_CAPACITY);
+	}
+
+	_size = 0;
+	_deleted = 0;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::rehash(size_type newCapacity) {
+	assert(newCapacity >= _mask + 1);
+
+#ifndef NDEBUG
+	const size_type old_size = _size;
+#endif
+	const size_type old_mask = _mask;
+	Slot *old_slots = _slots;
+
+	allocStorage(newCapacity);
+
+	// Move all the old nodes over. The slots remember their hashes, so
+	// there is no need to call the hash functor again, and since no key
+	// exists twice there is no need to call the equality functor either.
+	for (size_type ctr = 0; ctr <= old_mask; ++ctr) {
+		Slot &src = old_slots[ctr];
+		if (!src.isUsed())
+			continue;
+
+		size_type idx = firstIndex(src._keyHash);
+		while (_slots[idx].isUsed())
+			idx = (idx + 1) & _mask;
+
+		new ((void *)&_slots[idx]._node) Node(src._node._key, src._node._value);
+		_slots[idx]._keyHash = src._keyHash;
+		src._node.~Node();
+		_size++;
+	}
+
+	// Perform a sanity check: Old number of elements should match the new one!
+	// This check will fail if some previous operation corrupted this hashmap.
+	assert(_size == old_size);
+
+	delete[] old_slots;
+}
+
+/**
+ * Return the slot holding @p key, or the empty slot ending its probe
+ * sequence if the key is not present.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+template<class LookupKey>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::lookup(const LookupKey &key) const {
+	const uint hash = slotHash(key);
+	size_type ctr = firstIndex(hash);
+	for (;;) {
+		const Slot &slot = _slots[ctr];
+		if (slot._keyHash == kSlotEmpty)
+			break;
+		if (slot._keyHash == hash && _equal(slot._node._key, key))
+			break;
+
+		ctr = (ctr + 1) & _mask;
+	}
+
+	return ctr;
+}
+
+/**
+ * Insert @p key, which must not be present yet, and return its slot.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+typename FlatHashMap<Key, Val, HashFunc, EqualFunc>::size_type FlatHashMap<Key, Val, HashFunc, EqualFunc>::insertNew(const Key &key, uint hash) {
+	// Keep the load factor below a certain threshold. Deleted slots are also
+	// counted. The caller has to make sure key does not live in this map,
+	// as growing moves all nodes.
+	size_type capacity = _mask + 1;
+	if ((_size + _deleted + 1) * FLATHASHMAP_LOADFACTOR_DENOMINATOR >
+	        capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR) {
+		// Only grow when the live nodes fill a good part of the table.
+		// Otherwise it is mostly cluttered with deleted slots, and is
+		// simply rebuilt at the same size.
+		if ((_size + 1) * FLATHASHMAP_LOADFACTOR_DENOMINATOR * 2 >
+		        capacity * FLATHASHMAP_LOADFACTOR_NUMERATOR)
+			capacity = capacity < 500 ? (capacity * 4) : (capacity * 2);
+
+		rehash(capacity);
+	}
+
+	// Reuse the first deleted slot on the probe sequence
+	size_type ctr = firstIndex(hash);
+	while (_slots[ctr].isUsed())
+		ctr = (ctr + 1) & _mask;
+
+	if (_slots[ctr]._keyHash == kSlotDeleted)
+		_deleted--;
+
+	new ((void *)&_slots[ctr]._node) Node(key);
+	_slots[ctr]._keyHash = hash;
+	_size++;
+
+	return ctr;
+}
+
+/**
+ * Get a value from the hashmap.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) {
+	return getOrCreateVal(key);
+}
+
+/**
+ * @overload
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) const {
+	return getVal(key);
+}
+
+/**
+ * Get a value from the hashmap, creating it if the key is not present.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getOrCreateVal(const Key &key) {
+	size_type ctr = lookup(key);
+	if (_slots[ctr].isUsed())
+		return _slots[ctr]._node._value;
+
+	// The key might refer to a node of this map, which is moved if the
+	// map has to grow.
+	const Key keyCopy(key);
+	ctr = insertNew(keyCopy, slotHash(keyCopy));
+	return _slots[ctr]._node._value;
+}
+
+/**
+ * @overload
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) {
+	size_type ctr = lookup(key);
+	if (_slots[ctr].isUsed())
+		return _slots[ctr]._node._value;
+	else
+		// See comment in HashMap::getVal().
+#ifdef RELEASE_BUILD
+		return _defaultVal;
+#else
+		unknownKeyError(key);
+#endif
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+const Val &FlatHashMap<Key, Val, HashFunc, EqualFunc>::getVal(const Key &key) const {
+	size_type ctr = lookup(key);
+	if (_slots[ctr].isUsed())
+		return _slots[ctr]._node._value;
+	else
+		// See comment in HashMap::getVal().
+#ifdef RELEASE_BUILD
+		return _defaultVal;
+#else
+		unknownKeyError(key);
+#endif
+}
+
+/**
+ * Assign an element specified by @p key to a value @p val.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::setVal(const Key &key, const Val &val) {
+	size_type ctr = lookup(key);
+	if (_slots[ctr].isUsed()) {
+		_slots[ctr]._node._value = val;
+		return;
+	}
+
+	// Both arguments might refer to nodes of this map, which are moved if
+	// the map has to grow.
+	const Key keyCopy(key);
+	const Val valCopy(val);
+	ctr = insertNew(keyCopy, slotHash(keyCopy));
+	_slots[ctr]._node._value = valCopy;
+}
+
+/**
+ * Erase an element referred to by an iterator.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(iterator entry) {
+	// Check whether we have a valid iterator
+	assert(entry._hashmap == this);
+	const size_type ctr = entry._idx;
+	assert(ctr <= _mask);
+	assert(_slots[ctr].isUsed());
+
+	// If we remove a key, we leave a marker so probe sequences stay intact.
+	_slots[ctr]._node.~Node();
+	_slots[ctr]._keyHash = kSlotDeleted;
+	_size--;
+	_deleted++;
+}
+
+/**
+ * Erase an element specified by a key.
+ */
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void FlatHashMap<Key, Val, HashFunc, EqualFunc>::erase(const Key &key) {
+	size_type ctr = lookup(key);
+	if (!_slots[ctr].isUsed())
+		return;
+
+	// If we remove a key, we leave a marker so probe sequences stay intact.
+	_slots[ctr]._node.~Node();
+	_slots[ctr]._keyHash = kSlotDeleted;
+	_size--;
+	_deleted++;
+}
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
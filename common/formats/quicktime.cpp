@@ -27,6 +27,7 @@
 // Seek function by Gael Chardon gael.dev@4now.net
 //
 
+#include "common/bufferedstream.h"
 #include "common/debug.h"
 #include "common/endian.h"
 #include "common/macresman.h"
@@ -42,6 +43,11 @@ namespace Common {
 // QuickTimeParser
 ////////////////////////////////////////////
 
+// Buffer sizes for reading the file. Samples are mostly read in file
+// order, with the tracks of interleaved files jumping back and forth.
+static const uint32 kMinBufferSize = 4 * 1024;
+static const uint32 kMaxBufferSize = 128 * 1024;
+
 QuickTimeParser::QuickTimeParser() {
 	_beginOffset = 0;
 	_fd = nullptr;
@@ -84,7 +90,7 @@ bool QuickTimeParser::parseFile(const Path &filename) {
 		delete _fd;
 	}
 
-	_fd = Common::MacResManager::openFileOrDataFork(filename);
+	_fd = wrapAdaptiveBufferedSeekableReadStream(MacResManager::openFileOrDataFork(filename), kMinBufferSize, kMaxBufferSize, DisposeAfterUse::YES);
 	if (!_fd)
 		return false;
 	atom.size = _fd->size();
@@ -97,9 +103,10 @@ bool QuickTimeParser::parseFile(const Path &filename) {
 }
 
 bool QuickTimeParser::parseStream(SeekableReadStream *stream, DisposeAfterUse::Flag disposeFileHandle) {
-	_fd = stream;
+	// The wrapper disposes of the stream if requested, and is always ours
+	_fd = wrapAdaptiveBufferedSeekableReadStream(stream, kMinBufferSize, kMaxBufferSize, disposeFileHandle);
 	_foundMOOV = false;
-	_disposeFileHandle = disposeFileHandle;
+	_disposeFileHandle = DisposeAfterUse::YES;
 
 	Atom atom = { 0, 0, 0xffffffff };
 
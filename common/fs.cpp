@@ -248,6 +248,21 @@ SeekableReadStream *FSNode::createReadStream() const {
 	return _realNode->createReadStream();
 }
 
+SeekableReadStream *FSNode::createMappedReadStream() const {
+	if (_realNode == nullptr)
+		return nullptr;
+
+	if (!_realNode->exists()) {
+		warning("FSNode::createMappedReadStream: '%s' does not exist", getName().c_str());
+		return nullptr;
+	} else if (_realNode->isDirectory()) {
+		warning("FSNode::createMappedReadStream: '%s' is a directory", getName().c_str());
+		return nullptr;
+	}
+
+	return _realNode->createMappedReadStream();
+}
+
 SeekableReadStream *FSNode::createReadStreamForAltStream(AltStreamType altStreamType) const {
 	if (_realNode == nullptr)
 		return nullptr;
@@ -272,6 +287,8 @@ SeekableWriteStream *FSNode::createWriteStream() const {
 		return nullptr;
 	}
 
+	// The file may be new, so forget that it could not be found
+	SearchSet::invalidateLookupCaches();
 	return _realNode->createWriteStream();
 }
 
@@ -288,6 +305,7 @@ bool FSNode::createDirectory() const {
 		return false;
 	}
 
+	SearchSet::invalidateLookupCaches();
 	return _realNode->createDirectory();
 }
 
@@ -333,8 +351,9 @@ FSNode *FSDirectory::lookupCache(NodeCache &cache, const Path &name) const {
 	if (!name.empty()) {
 		ensureCached();
 
-		if (cache.contains(name))
-			return &cache[name];
+		NodeCache::iterator it = cache.find(name);
+		if (it != cache.end())
+			return &it->_value;
 	}
 
 	return nullptr;
@@ -374,6 +393,14 @@ const ArchiveMemberPtr FSDirectory::getMember(const Path &path) const {
 }
 
 SeekableReadStream *FSDirectory::createReadStreamForMember(const Path &path) const {
+	return createReadStreamForMember(path, false);
+}
+
+SeekableReadStream *FSDirectory::createMappedReadStreamForMember(const Path &path) const {
+	return createReadStreamForMember(path, true);
+}
+
+SeekableReadStream *FSDirectory::createReadStreamForMember(const Path &path, bool mapped) const {
 	if (path.toString().empty() || !_node.isDirectory())
 		return nullptr;
 
@@ -383,7 +410,7 @@ SeekableReadStream *FSDirectory::createReadStreamForMember(const Path &path) con
 
 	debug(5, "FSDirectory::createReadStreamForMember('%s') -> '%s'", path.toString().c_str(), node->getPath().c_str());
 
-	SeekableReadStream *stream = node->createReadStream();
+	SeekableReadStream *stream = mapped ? node->createMappedReadStream() : node->createReadStream();
 	if (!stream)
 		warning("FSDirectory::createReadStreamForMember: Can't create stream for file '%s'", Common::toPrintable(path.toString()).c_str());
 
@@ -275,6 +275,20 @@ public:
 	 */
 	SeekableReadStream *createReadStreamForAltStream(AltStreamType altStreamType) const override;
 
+	/**
+	 * Create a SeekableReadStream instance corresponding to the file
+	 * referred by this node, which may map the file into memory instead of
+	 * reading it through a buffer. The result is then a MemoryReadStream,
+	 * and getData() gives access to the whole file without copying it.
+	 *
+	 * Only use this for read-only game data: the stream may crash when
+	 * the file is truncated while it is open. Backends which can not map
+	 * files, and small files, use createReadStream() instead.
+	 *
+	 * @return Pointer to the stream object, nullptr in case of a failure.
+	 */
+	SeekableReadStream *createMappedReadStream() const;
+
 	/**
 	 * Create a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -441,6 +455,15 @@ public:
 	 * for success.
 	 */
 	SeekableReadStream *createReadStreamForMember(const Path &path) const override;
+
+	/**
+	 * Open the specified file like createReadStreamForMember(), mapping it into
+	 * memory when possible.
+	 */
+	SeekableReadStream *createMappedReadStreamForMember(const Path &path) const override;
+
+private:
+	SeekableReadStream *createReadStreamForMember(const Path &path, bool mapped) const;
 };
 
 /** @} */
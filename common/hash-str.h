@@ -44,10 +44,12 @@ struct CaseSensitiveString_Hash {
 
 struct IgnoreCase_EqualTo {
 	bool operator()(const String& x, const String& y) const { return x.equalsIgnoreCase(y); }
+	bool operator()(const String& x, const char *y) const { return x.equalsIgnoreCase(y); }
 };
 
 struct IgnoreCase_Hash {
 	uint operator()(const String& x) const { return hashit_lower(x.c_str()); }
+	uint operator()(const char *x) const { return hashit_lower(x); }
 };
 
 // Specalization of the Hash functor for String objects.
@@ -93,6 +93,16 @@ public:
 	int64 size() const { return _size; }
 
 	bool seek(int64 offs, int whence = SEEK_SET);
+
+	/**
+	 * Return the memory block the stream reads from. This allows to
+	 * access the data without copying it, e.g. for streams which are
+	 * backed by a memory mapped file.
+	 *
+	 * The block is valid as long as the stream exists and is size()
+	 * bytes long.
+	 */
+	const byte *getData() const { return _ptrOrig.get(); }
 };
 
 
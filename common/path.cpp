@@ -392,6 +392,24 @@ String Path::getIdentifierString() const {
 	return res;
 }
 
+// The identifier string of most paths is the path string itself. That is
+// the case unless a component contains an escaped slash, might be
+// punycode encoded or has non-ASCII characters, which punycode decoding
+// may alter.
+bool Path::isIdentifierTrivial() const {
+	const char *str = _str.c_str();
+	for (uint i = 0; i < _str.size(); i++) {
+		if (str[i] & 0x80)
+			return false;
+		if (str[i] == ESCAPER && str[i + 1] == ESCAPE_SLASH)
+			return false;
+		if (str[i] == 'x' && !strncmp(str + i, "xn--", 4))
+			return false;
+	}
+
+	return true;
+}
+
 Path Path::punycodeEncode() const {
 	StringArray c = splitComponents();
 	String res;
@@ -424,10 +442,16 @@ bool Path::matchPattern(const Path& pattern) const {
 }
 
 bool Path::IgnoreCaseAndMac_EqualsTo::operator()(const Path& x, const Path& y) const {
+	if (x.isIdentifierTrivial() && y.isIdentifierTrivial())
+		return x._str.equalsIgnoreCase(y._str);
+
 	return x.getIdentifierString().equalsIgnoreCase(y.getIdentifierString());
 }
 
 uint Path::IgnoreCaseAndMac_Hash::operator()(const Path& x) const {
+	if (x.isIdentifierTrivial())
+		return hashit_lower(x._str.c_str());
+
 	return hashit_lower(x.getIdentifierString().c_str());
 }
 
@@ -49,6 +49,7 @@ private:
 	String _str;
 
 	String getIdentifierString() const;
+	bool isIdentifierTrivial() const;
 	size_t findLastSeparator(size_t last = String::npos) const;
 
 public:
@@ -19,11 +19,13 @@
  *
  */
 
+#include "common/bufferedstream.h"
 #include "common/ptr.h"
 #include "common/stream.h"
 #include "common/memstream.h"
 #include "common/substream.h"
 #include "common/str.h"
+#include "common/system.h"
 
 namespace Common {
 
@@ -499,6 +501,231 @@ SeekableReadStream *wrapBufferedSeekableReadStream(SeekableReadStream *parentStr
 
 namespace {
 
+/**
+ * Wrapper class which adds buffering to any given SeekableReadStream,
+ * growing the amount of data read at once while the stream is read
+ * sequentially.
+ * @see wrapAdaptiveBufferedSeekableReadStream
+ */
+class AdaptiveBufferedSeekableReadStream : public SeekableReadStream {
+protected:
+	struct Block {
+		byte *data;
+		uint32 capacity;
+		int64 start;
+		uint32 size;
+		uint32 lastUsed;
+	};
+
+	enum {
+		kNumBlocks = 4
+	};
+
+	DisposablePtr<SeekableReadStream> _parentStream;
+	Block _blocks[kNumBlocks];
+	Block *_current;
+	uint32 _minBufSize;
+	uint32 _maxBufSize;
+	uint32 _readAhead;
+	int64 _pos;
+	int64 _parentPos;   // -1 if unknown
+	int64 _sequentialEnd; // end of the last read from the parent
+	uint32 _useCounter;
+	bool _eos;
+	BufferedStreamStats _stats;
+
+	Block *findBlock(int64 pos);
+	Block *refill();
+	uint32 readParent(void *dataPtr, uint32 dataSize);
+
+public:
+	AdaptiveBufferedSeekableReadStream(SeekableReadStream *parentStream, uint32 minBufSize, uint32 maxBufSize, DisposeAfterUse::Flag disposeParentStream);
+	~AdaptiveBufferedSeekableReadStream();
+
+	bool eos() const override { return _eos; }
+	bool err() const override { return _parentStream->err(); }
+	void clearErr() override { _eos = false; _parentStream->clearErr(); }
+
+	uint32 read(void *dataPtr, uint32 dataSize) override;
+
+	int64 pos() const override { return _pos; }
+	int64 size() const override { return _parentStream->size(); }
+
+	bool seek(int64 offset, int whence = SEEK_SET) override;
+
+	const BufferedStreamStats &getStats() const { return _stats; }
+};
+
+AdaptiveBufferedSeekableReadStream::AdaptiveBufferedSeekableReadStream(SeekableReadStream *parentStream, uint32 minBufSize, uint32 maxBufSize, DisposeAfterUse::Flag disposeParentStream)
+	: _parentStream(parentStream, disposeParentStream),
+	_current(nullptr),
+	_minBufSize(minBufSize),
+	_maxBufSize(MAX(minBufSize, maxBufSize)),
+	_readAhead(minBufSize),
+	_pos(parentStream->pos()),
+	_parentPos(_pos),
+	_sequentialEnd(-1),
+	_useCounter(0),
+	_eos(false) {
+
+	assert(minBufSize > 0);
+	memset(_blocks, 0, sizeof(_blocks));
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+AdaptiveBufferedSeekableReadStream::~AdaptiveBufferedSeekableReadStream() {
+	for (int i = 0; i < kNumBlocks; i++)
+		free(_blocks[i].data);
+}
+
+AdaptiveBufferedSeekableReadStream::Block *AdaptiveBufferedSeekableReadStream::findBlock(int64 pos) {
+	if (_current && pos >= _current->start && pos < _current->start + _current->size)
+		return _current;
+
+	for (int i = 0; i < kNumBlocks; i++) {
+		Block &block = _blocks[i];
+		if (block.size && pos >= block.start && pos < block.start + block.size) {
+			block.lastUsed = ++_useCounter;
+			_current = &block;
+			_stats.blockHits++;
+			return _current;
+		}
+	}
+
+	return nullptr;
+}
+
+uint32 AdaptiveBufferedSeekableReadStream::readParent(void *dataPtr, uint32 dataSize) {
+	uint32 start = g_system ? g_system->getMillis() : 0;
+
+	if (_parentPos != _pos)
+		_parentStream->seek(_pos);
+
+	uint32 n = _parentStream->read(dataPtr, dataSize);
+
+	// After a short read the parent position depends on the kind of stream
+	_parentPos = (n == dataSize) ? _pos + n : -1;
+	_sequentialEnd = _pos + n;
+
+	_stats.refills++;
+	_stats.bytesRead += n;
+	if (g_system)
+		_stats.timeBlocked += g_system->getMillis() - start;
+
+	return n;
+}
+
+AdaptiveBufferedSeekableReadStream::Block *AdaptiveBufferedSeekableReadStream::refill() {
+	// Read larger blocks while the stream is read sequentially
+	if (_pos == _sequentialEnd)
+		_readAhead = MIN(_readAhead * 2, _maxBufSize);
+	else
+		_readAhead = _minBufSize;
+
+	// Reuse the least recently used block
+	Block *block = &_blocks[0];
+	for (int i = 1; i < kNumBlocks; i++) {
+		if (_blocks[i].lastUsed < block->lastUsed)
+			block = &_blocks[i];
+	}
+
+	if (block->capacity < _readAhead) {
+		free(block->data);
+		block->data = (byte *)malloc(_readAhead);
+		assert(block->data);
+		block->capacity = _readAhead;
+	}
+
+	block->start = _pos;
+	block->size = readParent(block->data, _readAhead);
+	block->lastUsed = ++_useCounter;
+
+	_current = block->size ? block : nullptr;
+	return _current;
+}
+
+uint32 AdaptiveBufferedSeekableReadStream::read(void *dataPtr, uint32 dataSize) {
+	byte *dst = (byte *)dataPtr;
+	uint32 alreadyRead = 0;
+
+	while (dataSize > 0) {
+		Block *block = findBlock(_pos);
+
+		if (!block && dataSize >= _maxBufSize) {
+			// Large reads are satisfied directly from the parent
+			uint32 n = readParent(dst, dataSize);
+			_pos += n;
+			alreadyRead += n;
+			if (n < dataSize)
+				_eos = true;
+			break;
+		}
+
+		if (!block)
+			block = refill();
+
+		if (!block) {
+			_eos = true;
+			break;
+		}
+
+		uint32 offset = _pos - block->start;
+		uint32 n = MIN(dataSize, block->size - offset);
+		memcpy(dst, block->data + offset, n);
+		dst += n;
+		dataSize -= n;
+		_pos += n;
+		alreadyRead += n;
+	}
+
+	return alreadyRead;
+}
+
+bool AdaptiveBufferedSeekableReadStream::seek(int64 offset, int whence) {
+	int64 newPos;
+	switch (whence) {
+	case SEEK_END:
+		newPos = size() + offset;
+		break;
+	case SEEK_CUR:
+		newPos = _pos + offset;
+		break;
+	case SEEK_SET:
+	default:
+		newPos = offset;
+		break;
+	}
+
+	if (newPos < 0)
+		return false;
+
+	// The parent is only seeked when data has to be read from it
+	_pos = newPos;
+	_eos = false; // seeking always cancels EOS
+	return true;
+}
+
+} // End of anonymous namespace
+
+SeekableReadStream *wrapAdaptiveBufferedSeekableReadStream(SeekableReadStream *parentStream, uint32 minBufSize, uint32 maxBufSize, DisposeAfterUse::Flag disposeParentStream) {
+	if (parentStream)
+		return new AdaptiveBufferedSeekableReadStream(parentStream, minBufSize, maxBufSize, disposeParentStream);
+	return nullptr;
+}
+
+bool getBufferedStreamStats(const ReadStream *stream, BufferedStreamStats &stats) {
+	const AdaptiveBufferedSeekableReadStream *bufferedStream = dynamic_cast<const AdaptiveBufferedSeekableReadStream *>(stream);
+	if (!bufferedStream)
+		return false;
+
+	stats = bufferedStream->getStats();
+	return true;
+}
+
+#pragma mark -
+
+namespace {
+
 /**
  * Wrapper class which adds buffering to any WriteStream.
  */
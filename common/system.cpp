@@ -33,6 +33,7 @@
 #include "common/str-enc.h"
 #include "common/textconsole.h"
 #include "common/text-to-speech.h"
+#include "common/threadpool.h"
 
 #include "backends/audiocd/default/default-audiocd.h"
 #include "backends/fs/fs-factory.h"
@@ -56,6 +57,7 @@ OSystem::OSystem() {
 #if defined(USE_SYSDIALOGS)
 	_dialogManager = nullptr;
 #endif
+	_threadPool = nullptr;
 	_fsFactory = nullptr;
 	_dlcStore = nullptr;
 	_backendInitialized = false;
@@ -84,6 +86,9 @@ OSystem::~OSystem() {
 	delete _textToSpeechManager;
 	_textToSpeechManager = nullptr;
 
+	delete _threadPool;
+	_threadPool = nullptr;
+
 #if defined(USE_SYSDIALOGS)
 	delete _dialogManager;
 	_dialogManager = nullptr;
@@ -259,6 +264,12 @@ Common::TimerManager *OSystem::getTimerManager() {
 	return _timerManager;
 }
 
+Common::ThreadPool *OSystem::getThreadPool() {
+	if (!_threadPool)
+		_threadPool = new Common::ThreadPool();
+	return _threadPool;
+}
+
 Common::SaveFileManager *OSystem::getSavefileManager() {
 	return _savefileManager;
 }
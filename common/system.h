@@ -68,6 +68,7 @@ class TextToSpeechManager;
 class DialogManager;
 #endif
 class TimerManager;
+class ThreadPool;
 class SeekableReadStream;
 class WriteStream;
 class HardwareInputSet;
@@ -247,6 +248,15 @@ protected:
 	 */
 	Common::TextToSpeechManager *_textToSpeechManager;
 
+	/**
+	 * No default value is provided for _threadPool by OSystem.
+	 * However, getThreadPool() creates a pool without worker threads
+	 * if none has been set before.
+	 *
+	 * @note _threadPool is deleted by the OSystem destructor.
+	 */
+	Common::ThreadPool *_threadPool;
+
 #if defined(USE_SYSDIALOGS)
 	/**
 	 * No default value is provided for _dialogManager by OSystem.
@@ -1522,6 +1532,13 @@ public:
 	 */
 	virtual Common::TimerManager *getTimerManager();
 
+	/**
+	 * Return the thread pool singleton.
+	 *
+	 * For more information, see @ref ThreadPool.
+	 */
+	virtual Common::ThreadPool *getThreadPool();
+
 	/**
 	 * Return the event manager singleton.
 	 *
@@ -0,0 +1,217 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef COMMON_THREADPOOL_H
+#define COMMON_THREADPOOL_H
+
+#include "common/scummsys.h"
+#include "common/array.h"
+#include "common/noncopyable.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_threadpool Thread pool
+ * @ingroup common
+ *
+ * @brief API for running work on the worker threads of the backend.
+ *
+ * The thread pool is obtained through OSystem::getThreadPool(). Ports
+ * without threads provide a pool without workers, which simply runs
+ * every task on the thread submitting it, so code using the pool does
+ * not need a separate single-threaded path.
+ *
+ * @{
+ */
+
+/**
+ * A unit of work that can be run by a ThreadPool.
+ *
+ * Tasks may run on any thread and in any order. They must only access
+ * data that no other task or thread modifies at the same time.
+ */
+class Task {
+public:
+	virtual ~Task() {}
+
+	virtual void run() = 0;
+};
+
+/**
+ * A set of tasks which are waited for together.
+ *
+ * The group, and all tasks submitted to it, must stay alive until
+ * ThreadPool::wait() returned for it.
+ */
+class TaskGroup : NonCopyable {
+	friend class ThreadPool;
+
+	int _pending;
+
+public:
+	TaskGroup() : _pending(0) {}
+};
+
+class ThreadPool : NonCopyable {
+public:
+	virtual ~ThreadPool() {}
+
+	/**
+	 * Return the number of worker threads.
+	 *
+	 * Without workers, all tasks run on the thread calling submit().
+	 */
+	virtual uint getNumWorkers() const { return 0; }
+
+	/**
+	 * Queue a task for running.
+	 *
+	 * Tasks may submit further tasks, also to the group they are part of.
+	 *
+	 * @param task   The task to run. It is not deleted by the pool.
+	 * @param group  The group to add the task to.
+	 */
+	virtual void submit(Task *task, TaskGroup &group) { task->run(); }
+
+	/**
+	 * Wait until all tasks of a group are done.
+	 *
+	 * The calling thread runs queued tasks while waiting, so it is
+	 * safe to wait from within a task.
+	 */
+	virtual void wait(TaskGroup &group) {}
+
+	/**
+	 * Call func(first, last) for consecutive ranges covering
+	 * [begin, end) and wait for all calls to finish.
+	 *
+	 * The calls may run in parallel, so func must be safe to call
+	 * from several threads at once for distinct ranges.
+	 *
+	 * @param grainSize  The smallest number of indices given to one
+	 *                   call, or 0 to split the range based on the
+	 *                   number of workers.
+	 */
+	template<class Func>
+	void parallelFor(uint begin, uint end, const Func &func, uint grainSize = 0);
+
+protected:
+	static int &pendingTasks(TaskGroup &group) { return group._pending; }
+
+private:
+	template<class Func>
+	class RangeTask : public Task {
+	public:
+		RangeTask() : _func(nullptr), _first(0), _last(0) {}
+
+		void run() override { (*_func)(_first, _last); }
+
+		const Func *_func;
+		uint _first, _last;
+	};
+};
+
+template<class Func>
+void ThreadPool::parallelFor(uint begin, uint end, const Func &func, uint grainSize) {
+	if (begin >= end)
+		return;
+
+	const uint count = end - begin;
+	const uint numWorkers = getNumWorkers();
+	if (!grainSize) {
+		// A few ranges per thread leave room to balance uneven work
+		const uint numRanges = (numWorkers + 1) * 4;
+		grainSize = (count + numRanges - 1) / numRanges;
+	}
+	if (!numWorkers || count <= grainSize) {
+		func(begin, end);
+		return;
+	}
+
+	Array<RangeTask<Func> > tasks;
+	tasks.resize((count + grainSize - 1) / grainSize);
+	for (uint i = 0; i < tasks.size(); i++) {
+		tasks[i]._func = &func;
+		tasks[i]._first = begin + i * grainSize;
+		tasks[i]._last = MIN(tasks[i]._first + grainSize, end);
+	}
+
+	// The first range is run by the calling thread
+	TaskGroup group;
+	for (uint i = 1; i < tasks.size(); i++)
+		submit(&tasks[i], group);
+	tasks[0].run();
+	wait(group);
+}
+
+/**
+ * A task computing a value.
+ *
+ * Subclasses implement compute(). The future is either started on a
+ * pool, or computed by the first call to get().
+ */
+template<class T>
+class Future : public Task, NonCopyable {
+public:
+	Future() : _pool(nullptr), _done(false) {}
+
+	/**
+	 * Queue the computation on a pool.
+	 *
+	 * The future must then stay alive until get() was called.
+	 */
+	void start(ThreadPool *pool) {
+		_pool = pool;
+		pool->submit(this, _group);
+	}
+
+	/** Return the result, waiting for it or computing it if needed. */
+	const T &get() {
+		if (_pool) {
+			_pool->wait(_group);
+			_pool = nullptr;
+		} else if (!_done) {
+			run();
+		}
+		return _result;
+	}
+
+protected:
+	virtual T compute() = 0;
+
+private:
+	void run() override {
+		_result = compute();
+		_done = true;
+	}
+
+	ThreadPool *_pool;
+	TaskGroup _group;
+	T _result;
+	bool _done;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -23,6 +23,7 @@
 #include "ags/ags.h"
 #include "ags/globals.h"
 #include "ags/shared/ac/sprite_cache.h"
+#include "ags/engine/gfx/ali_3d_scummvm.h"
 #include "ags/shared/gfx/allegro_bitmap.h"
 #include "ags/shared/script/cc_common.h"
 #include "image/png.h"
@@ -33,8 +34,12 @@ AGSConsole::AGSConsole(AGSEngine *vm) : GUI::Debugger(), _vm(vm), _logOutputTarg
 	registerCmd("ags_debug_groups_list",   WRAP_METHOD(AGSConsole, Cmd_listDebugGroups));
 	registerCmd("ags_debug_groups_set",  WRAP_METHOD(AGSConsole, Cmd_setDebugGroupLevel));
 	registerCmd("ags_set_script_dump", WRAP_METHOD(AGSConsole, Cmd_SetScriptDump));
+	registerCmd("ags_set_script_predecode", WRAP_METHOD(AGSConsole, Cmd_SetScriptPredecode));
 	registerCmd("ags_sprite_info",   WRAP_METHOD(AGSConsole, Cmd_getSpriteInfo));
 	registerCmd("ags_sprite_dump",  WRAP_METHOD(AGSConsole, Cmd_dumpSprite));
+	registerCmd("ags_sprite_cache_stats",  WRAP_METHOD(AGSConsole, Cmd_spriteCacheStats));
+	registerCmd("ags_sprite_compressed_cache",  WRAP_METHOD(AGSConsole, Cmd_setSpriteCompressedCache));
+	registerCmd("ags_dirty_rects",  WRAP_METHOD(AGSConsole, Cmd_dirtyRects));
 
 	_logOutputTarget = new LogOutputTarget();
 	_agsDebuggerOutput = _GP(DbgMgr).RegisterOutput("ScummVMLog", _logOutputTarget, AGS3::AGS::Shared::kDbgMsg_None);
@@ -184,6 +189,19 @@ bool AGSConsole::Cmd_SetScriptDump(int argc, const char **argv) {
 	return true;
 }
 
+bool AGSConsole::Cmd_SetScriptPredecode(int argc, const char **argv) {
+	if (argc != 2) {
+		debugPrintf("Usage: %s [on|off]\n", argv[0]);
+		return true;
+	}
+
+	if (strcmp(argv[1], "on") == 0 || strcmp(argv[1], "true") == 0)
+		AGS3::ccSetOption(SCOPT_PREDECODED, 1);
+	else
+		AGS3::ccSetOption(SCOPT_PREDECODED, 0);
+	return true;
+}
+
 bool AGSConsole::Cmd_getSpriteInfo(int argc, const char **argv) {
 	if (argc != 2) {
 		debugPrintf("Usage: %s SpriteNumber\n", argv[0]);
@@ -244,6 +262,67 @@ bool AGSConsole::Cmd_dumpSprite(int argc, const char **argv) {
 	return true;
 }
 
+bool AGSConsole::Cmd_spriteCacheStats(int argc, const char **argv) {
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "reset") != 0)) {
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	const AGS3::Shared::SpriteCache::Stats &stats = _GP(spriteset).GetStats();
+	debugPrintf("Cache size: %u / %u KB (locked %u KB)\n", (uint)(_GP(spriteset).GetCacheSize() / 1024),
+		(uint)(_GP(spriteset).GetMaxCacheSize() / 1024), (uint)(_GP(spriteset).GetLockedSize() / 1024));
+	debugPrintf("Compressed data: %u / %u KB\n", (uint)(_GP(spriteset).GetCompressedSize() / 1024),
+		(uint)(_GP(spriteset).GetMaxCompressedSize() / 1024));
+	debugPrintf("Hits: %u, misses: %u, time spent loading on request: %u ms\n", stats.Hits, stats.Misses, stats.StallMs);
+	debugPrintf("Prefetched: %u, used after prefetch: %u\n", stats.Prefetched, stats.PrefetchHits);
+	debugPrintf("Restored from compressed data: %u\n", stats.CompressedHits);
+
+	if (argc == 2)
+		_GP(spriteset).ResetStats();
+	return true;
+}
+
+bool AGSConsole::Cmd_setSpriteCompressedCache(int argc, const char **argv) {
+	if (argc != 2) {
+		debugPrintf("Usage: %s SizeInKB\n", argv[0]);
+		debugPrintf("Current size: %u KB, 0 means disabled\n", (uint)(_GP(spriteset).GetMaxCompressedSize() / 1024));
+		return true;
+	}
+
+	int size = atoi(argv[1]);
+	_GP(spriteset).SetMaxCompressedSize(size > 0 ? size * 1024 : 0);
+	return true;
+}
+
+bool AGSConsole::Cmd_dirtyRects(int argc, const char **argv) {
+	if (argc > 2) {
+		debugPrintf("Usage: %s [on|off|reset]\n", argv[0]);
+		return true;
+	}
+
+	AGS3::AGS::Engine::ALSW::ScummVMRendererGraphicsDriver *driver =
+		dynamic_cast<AGS3::AGS::Engine::ALSW::ScummVMRendererGraphicsDriver *>(_G(gfxDriver));
+	if (!driver) {
+		debugPrintf("The software renderer is not active\n");
+		return true;
+	}
+
+	if (argc == 2) {
+		if (strcmp(argv[1], "on") == 0 || strcmp(argv[1], "true") == 0)
+			driver->SetDirtyRectPresent(true);
+		else if (strcmp(argv[1], "off") == 0 || strcmp(argv[1], "false") == 0)
+			driver->SetDirtyRectPresent(false);
+		driver->ResetPresentStats();
+		return true;
+	}
+
+	const AGS3::AGS::Engine::ALSW::ScummVMRendererGraphicsDriver::PresentStats &stats = driver->GetPresentStats();
+	debugPrintf("Dirty rects: %s\n", driver->IsDirtyRectPresent() ? "on" : "off");
+	debugPrintf("Frames: %u, copied whole: %u\n", stats.Frames, stats.FullFrames);
+	debugPrintf("Pixels copied: %u%%\n", stats.Pixels ? (uint)(stats.PixelsCopied * 100 / stats.Pixels) : 0);
+	return true;
+}
+
 LogOutputTarget::LogOutputTarget() {
 }
 
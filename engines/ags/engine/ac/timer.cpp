@@ -23,6 +23,7 @@
 #include "ags/engine/ac/timer.h"
 #include "ags/shared/core/platform.h"
 #include "ags/engine/ac/sys_events.h"
+#include "ags/shared/ac/sprite_cache.h"
 #include "ags/engine/platform/base/ags_platform_driver.h"
 #include "ags/ags.h"
 #include "ags/globals.h"
@@ -80,8 +81,14 @@ void WaitForNextFrame() {
 	}
 
 	if (_G(next_frame_timestamp) > now) {
-		auto frame_time_remaining = _G(next_frame_timestamp) - now;
-		std::this_thread::sleep_for(frame_time_remaining);
+		// Spend part of the spare time loading the sprites needed soon;
+		// half of it is left as a margin, because a sprite load can't be interrupted
+		_GP(spriteset).ProcessPrefetch((_G(next_frame_timestamp) - now) / 2);
+		const auto after_prefetch = AGS_Clock::now();
+		if (_G(next_frame_timestamp) > after_prefetch) {
+			auto frame_time_remaining = _G(next_frame_timestamp) - after_prefetch;
+			std::this_thread::sleep_for(frame_time_remaining);
+		}
 	}
 
 	_G(last_tick_time) = _G(next_frame_timestamp);
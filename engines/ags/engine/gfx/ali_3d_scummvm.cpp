@@ -168,11 +168,13 @@ void ScummVMRendererGraphicsDriver::DestroyVirtualScreen() {
 	_origVirtualScreen.reset();
 	virtualScreen = nullptr;
 	_stageVirtualScreen = nullptr;
+	_lastFrame.reset();
 }
 
 void ScummVMRendererGraphicsDriver::ReleaseDisplayMode() {
 	OnModeReleased();
 	ClearDrawLists();
+	_lastFrame.reset();
 }
 
 bool ScummVMRendererGraphicsDriver::SetNativeResolution(const GraphicResolution &native_res) {
@@ -533,6 +535,40 @@ void ScummVMRendererGraphicsDriver::copySurface(const Graphics::Surface &src, bo
 		_screen->addDirtyRect(Common::Rect(x1, y1, x2 + 1, y2 + 1));
 }
 
+void ScummVMRendererGraphicsDriver::SetDirtyRectPresent(bool enabled) {
+	_dirtyRectPresent = enabled;
+	_lastFrame.reset();
+}
+
+void ScummVMRendererGraphicsDriver::copyDirtyRects() {
+	// Size of the tiles the screen is compared by
+	const int DirtyTileWidth = 32;
+	const int DirtyTileHeight = 16;
+	const Graphics::Surface &src = virtualScreen->GetAllegroBitmap()->getSurface();
+	const uint32_t frame_pixels = src.w * src.h;
+
+	// Copy the whole frame if there's nothing to compare it to
+	if (!_lastFrame || _lastFrame->GetSize() != virtualScreen->GetSize() ||
+		_lastFrame->GetColorDepth() != virtualScreen->GetColorDepth()) {
+		g_system->copyRectToScreen(src.getPixels(), src.pitch, 0, 0, src.w, src.h);
+		_lastFrame.reset(BitmapHelper::CreateBitmapCopy(virtualScreen));
+		_presentStats.FullFrames++;
+		_presentStats.PixelsCopied += frame_pixels;
+		return;
+	}
+
+	GfxUtil::FindChangedRects(virtualScreen, _lastFrame.get(), DirtyTileWidth, DirtyTileHeight, _dirtyRects);
+	const int bpp = virtualScreen->GetBPP();
+	for (const Rect &r : _dirtyRects) {
+		g_system->copyRectToScreen(src.getBasePtr(r.Left, r.Top), src.pitch,
+			r.Left, r.Top, r.GetWidth(), r.GetHeight());
+		for (int y = r.Top; y <= r.Bottom; ++y)
+			memcpy(_lastFrame->GetScanLineForWriting(y) + r.Left * bpp,
+				virtualScreen->GetScanLine(y) + r.Left * bpp, r.GetWidth() * bpp);
+		_presentStats.PixelsCopied += r.GetWidth() * r.GetHeight();
+	}
+}
+
 void ScummVMRendererGraphicsDriver::Present(int xoff, int yoff, Shared::GraphicFlip flip) {
 	Graphics::Surface *srcTransformed = nullptr;
 	if (xoff != 0 || yoff != 0 || flip != Shared::kFlip_None) {
@@ -585,6 +621,8 @@ void ScummVMRendererGraphicsDriver::Present(int xoff, int yoff, Shared::GraphicF
 
 	if (renderMode != kRenderDirect && !_screen)
 		_screen = new Graphics::Screen();
+	if (renderMode != kRenderDirect)
+		_lastFrame.reset();
 
 	switch (renderMode) {
 	case kRenderToABGR:
@@ -608,9 +646,19 @@ void ScummVMRendererGraphicsDriver::Present(int xoff, int yoff, Shared::GraphicF
 	}
 
 	case kRenderDirect:
-		// Blit the virtual surface directly to the screen
-		g_system->copyRectToScreen(src.getPixels(), src.pitch,
-			0, 0, src.w, src.h);
+		// Blit the virtual surface directly to the screen;
+		// unless it is shaken or flipped, only copy the parts that changed
+		_presentStats.Frames++;
+		_presentStats.Pixels += src.w * src.h;
+		if (_dirtyRectPresent && !srcTransformed) {
+			copyDirtyRects();
+		} else {
+			g_system->copyRectToScreen(src.getPixels(), src.pitch,
+				0, 0, src.w, src.h);
+			_lastFrame.reset();
+			_presentStats.FullFrames++;
+			_presentStats.PixelsCopied += src.w * src.h;
+		}
 		g_system->updateScreen();
 		if (srcTransformed) {
 			srcTransformed->free();
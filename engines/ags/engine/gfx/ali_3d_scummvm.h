@@ -236,6 +236,26 @@ public:
 
 	void SetGraphicsFilter(PSDLRenderFilter filter);
 
+	// Statistics of the screen updates
+	struct PresentStats {
+		uint32_t Frames = 0;        // number of presented frames
+		uint32_t FullFrames = 0;    // frames which were copied to the screen whole
+		uint64_t Pixels = 0;        // total number of pixels in the presented frames
+		uint64_t PixelsCopied = 0;  // number of pixels actually copied to the screen
+	};
+
+	// Sets whether only the changed parts of the virtual screen are copied to the screen
+	void SetDirtyRectPresent(bool enabled);
+	bool IsDirtyRectPresent() const {
+		return _dirtyRectPresent;
+	}
+	const PresentStats &GetPresentStats() const {
+		return _presentStats;
+	}
+	void ResetPresentStats() {
+		_presentStats = PresentStats();
+	}
+
 protected:
 	bool SetVsyncImpl(bool vsync, bool &vsync_res) override;
 	size_t GetLastDrawEntryIndex() override {
@@ -273,6 +293,14 @@ private:
 	Bitmap *_stageVirtualScreen;
 	int _tint_red, _tint_green, _tint_blue;
 
+	// Copy of the virtual screen contents last copied to the screen,
+	// for finding out which parts of it have changed since
+	std::unique_ptr<Bitmap> _lastFrame;
+	// Changed parts of the virtual screen found in the current frame
+	std::vector<Rect> _dirtyRects;
+	bool _dirtyRectPresent = true;
+	PresentStats _presentStats;
+
 	// Sprite batches (parent scene nodes)
 	ALSpriteBatches _spriteBatches;
 	// List of sprites to render
@@ -295,6 +323,8 @@ private:
 	void __fade_out_range(int speed, int from, int to, int targetColourRed, int targetColourGreen, int targetColourBlue);
 	// Copy raw screen bitmap pixels to the screen
 	void copySurface(const Graphics::Surface &src, bool mode);
+	// Copy the changed parts of the virtual screen to the screen
+	void copyDirtyRects();
 	// Render bitmap on screen
 	void Present(int xoff = 0, int yoff = 0, Shared::GraphicFlip flip = Shared::kFlip_None);
 };
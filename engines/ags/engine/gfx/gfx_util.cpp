@@ -20,6 +20,7 @@
  */
 
 #include "ags/shared/core/platform.h"
+#include "ags/lib/std/algorithm.h"
 #include "ags/engine/gfx/gfx_util.h"
 #include "ags/engine/gfx/blender.h"
 
@@ -144,6 +145,55 @@ void DrawSpriteWithTransparency(Bitmap *ds, Bitmap *sprite, int x, int y, int al
 	}
 }
 
+void FindChangedRects(const Bitmap *bmp, const Bitmap *prev, int tile_w, int tile_h, std::vector<Rect> &rects) {
+	rects.clear();
+	assert(bmp->GetSize() == prev->GetSize() && bmp->GetColorDepth() == prev->GetColorDepth());
+	const int width = bmp->GetWidth();
+	const int height = bmp->GetHeight();
+	const int bpp = bmp->GetBPP();
+	// Rects which end at the previous tile row, and may be extended down
+	std::vector<size_t> open_rects, next_open_rects;
+	for (int y = 0; y < height; y += tile_h) {
+		const int bottom = std::min(y + tile_h, height) - 1;
+		int run_left = -1;
+		for (int x = 0; x <= width; x += tile_w) {
+			bool changed = false;
+			if (x < width) {
+				const size_t tile_len = std::min(tile_w, width - x) * bpp;
+				for (int line = y; line <= bottom && !changed; ++line)
+					changed = memcmp(bmp->GetScanLine(line) + x * bpp, prev->GetScanLine(line) + x * bpp, tile_len) != 0;
+			}
+			if (changed) {
+				if (run_left < 0)
+					run_left = x;
+				continue;
+			}
+			if (run_left < 0)
+				continue;
+
+			// End of the changed tiles run: extend the rect from the tile row
+			// above if it spans the same columns, otherwise start a new one
+			const Rect run(run_left, y, std::min(x, width) - 1, bottom);
+			bool merged = false;
+			for (size_t i : open_rects) {
+				if (rects[i].Left == run.Left && rects[i].Right == run.Right) {
+					rects[i].Bottom = run.Bottom;
+					next_open_rects.push_back(i);
+					merged = true;
+					break;
+				}
+			}
+			if (!merged) {
+				next_open_rects.push_back(rects.size());
+				rects.push_back(run);
+			}
+			run_left = -1;
+		}
+		open_rects.swap(next_open_rects);
+		next_open_rects.clear();
+	}
+}
+
 } // namespace GfxUtil
 
 } // namespace Engine
@@ -34,6 +34,7 @@
 #ifndef AGS_ENGINE_GFX_GFX_UTIL_H
 #define AGS_ENGINE_GFX_GFX_UTIL_H
 
+#include "ags/lib/std/vector.h"
 #include "ags/shared/gfx/bitmap.h"
 #include "ags/shared/gfx/gfx_def.h"
 
@@ -59,6 +60,11 @@ void DrawSpriteBlend(Bitmap *ds, const Point &ds_at, Bitmap *sprite,
 // ignores image's alpha channel, even if there's one;
 // does proper conversion depending on respected color depths.
 void DrawSpriteWithTransparency(Bitmap *ds, Bitmap *sprite, int x, int y, int alpha = 0xFF);
+
+// Compares two bitmaps of equal size and format by tiles of the given size,
+// and fills the list with rectangles covering the tiles that differ;
+// adjacent changed tiles are merged into larger rectangles.
+void FindChangedRects(const Bitmap *bmp, const Bitmap *prev, int tile_w, int tile_h, std::vector<Rect> &rects);
 } // namespace GfxUtil
 
 } // namespace Engine
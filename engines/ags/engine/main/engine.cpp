@@ -525,6 +525,7 @@ int engine_init_sprites() {
 
 	if (_GP(usetup).SpriteCacheSize > 0)
 		_GP(spriteset).SetMaxCacheSize(_GP(usetup).SpriteCacheSize);
+	_GP(spriteset).SetMaxCompressedSize(_GP(usetup).SpriteCompressedCacheSize);
 	return 0;
 }
 
@@ -50,6 +50,7 @@
 #include "ags/engine/ac/room_object.h"
 #include "ags/engine/ac/room_status.h"
 #include "ags/engine/ac/view_frame.h"
+#include "ags/shared/ac/view.h"
 #include "ags/engine/ac/walk_behind.h"
 #include "ags/engine/debugging/debugger.h"
 #include "ags/engine/debugging/debug_log.h"
@@ -745,6 +746,38 @@ static void game_loop_update_loop_counter() {
 	}
 }
 
+// Queues the next frames of the given view loop to be loaded in advance
+static void prefetch_view_frames(int view, int loop, int frame, int count) {
+	if (view < 0 || view >= _GP(game).numviews)
+		return;
+	const ViewStruct &vs = _GP(views)[view];
+	if (loop < 0 || loop >= vs.numLoops)
+		return;
+	const ViewLoopNew &vl = vs.loops[loop];
+	for (int i = 1; i <= count && i < vl.numFrames; ++i)
+		_GP(spriteset).PrefetchSprite(vl.frames[(frame + i) % vl.numFrames].pic);
+}
+
+// Queues the upcoming animation frames of the characters and objects in the
+// room, so that the sprite cache could load them while waiting for the next frame
+static void game_loop_queue_sprite_prefetch() {
+	const int PrefetchFrameCount = 2;
+	// Drop the requests left over from the previous frame, they may be outdated
+	_GP(spriteset).ClearPrefetch();
+	for (int i = 0; i < _GP(game).numcharacters; ++i) {
+		const CharacterInfo &chi = _GP(game).chars[i];
+		if (chi.room != _G(displayed_room) || !chi.on)
+			continue;
+		prefetch_view_frames(chi.view, chi.loop, chi.frame, PrefetchFrameCount);
+	}
+	for (uint32_t i = 0; i < _G(croom)->numobj; ++i) {
+		const RoomObject &obj = _G(objs)[i];
+		if (!obj.on || !obj.cycling || obj.view == RoomObject::NoView)
+			continue;
+		prefetch_view_frames(obj.view, obj.loop, obj.frame, PrefetchFrameCount);
+	}
+}
+
 static void game_loop_update_fps() {
 	auto t2 = AGS_Clock::now();
 	auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - _G(t1));
@@ -881,6 +914,8 @@ void UpdateGameOnce(bool checkControls, IDriverDependantBitmap *extraBitmap, int
 	if (_G(abort_engine))
 		return;
 
+	game_loop_queue_sprite_prefetch();
+
 	WaitForNextFrame();
 }
 
@@ -456,92 +456,127 @@ int ccInstance::Run(int32_t curpc) {
 	//const auto timeout_abort = std::chrono::milliseconds(_G(timeoutAbortMs));
 	_lastAliveTs = AGS_Clock::now();
 
+	const ScriptPreparedCode *prepared = nullptr;
+	if (ccGetOption(SCOPT_PREDECODED) && codeInst->prepared_code) {
+		if (!codeInst->prepared_code->IsPrepared)
+			codeInst->PrepareCode();
+		prepared = codeInst->prepared_code.get();
+	}
+
 	while ((flags & INSTF_ABORTED) == 0) {
 		if (_G(abort_engine))
 			return -1;
 
-		/*
-		if (!codeInst->ReadOperation(codeOp, pc))
-		{
-		    return -1;
-		}
-		*/
-		/* ReadOperation */
-		//=====================================================================
-		codeOp.Instruction.Code         = codeInst->code[pc];
-		codeOp.Instruction.InstanceId   = (codeOp.Instruction.Code >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
-		codeOp.Instruction.Code        &= INSTANCE_ID_REMOVEMASK; // now this is pure instruction code
-
-		if (codeOp.Instruction.Code < 0 || codeOp.Instruction.Code >= CC_NUM_SCCMDS) {
-			cc_error("invalid instruction %d found in code stream", codeOp.Instruction.Code);
-			return -1;
-		}
+		const ScriptOperation *op = &codeOp;
+		const int32_t prepared_idx = (prepared && (size_t)pc < prepared->OpIndex.size()) ? prepared->OpIndex[pc] : -1;
+		if (prepared_idx >= 0) {
+			// Use the operation decoded in advance, and only resolve the
+			// arguments which depend on the current state
+			const ScriptPreparedOp &prepared_op = prepared->Ops[prepared_idx];
+			op = &prepared_op.Op;
+			if (prepared_op.DynamicArgs) {
+				codeOp = prepared_op.Op;
+				op = &codeOp;
+				for (int i = 0; i < codeOp.ArgCount; ++i) {
+					if ((prepared_op.DynamicArgs & (1 << i)) == 0)
+						continue;
+					const int pc_at = pc + 1 + i;
+					if (codeInst->code_fixups[pc_at] == FIXUP_STACK) {
+						codeOp.Args[i] = GetStackPtrOffsetFw((int32_t)codeInst->code[pc_at]);
+					} else {
+						const ScriptImport *import = _GP(simp).getByIndex(static_cast<uint32_t>(codeInst->code[pc_at]));
+						if (!import) {
+							cc_error("cannot resolve import, key = %ld", codeInst->code[pc_at]);
+							return -1;
+						}
+						codeOp.Args[i] = import->Value;
+					}
+				}
+			}
+		} else {
+			/*
+			if (!codeInst->ReadOperation(codeOp, pc))
+			{
+			    return -1;
+			}
+			*/
+			/* ReadOperation */
+			//=====================================================================
+			codeOp.Instruction.Code         = codeInst->code[pc];
+			codeOp.Instruction.InstanceId   = (codeOp.Instruction.Code >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
+			codeOp.Instruction.Code        &= INSTANCE_ID_REMOVEMASK; // now this is pure instruction code
+
+			if (codeOp.Instruction.Code < 0 || codeOp.Instruction.Code >= CC_NUM_SCCMDS) {
+				cc_error("invalid instruction %d found in code stream", codeOp.Instruction.Code);
+				return -1;
+			}
 
-		codeOp.ArgCount = (*g_commands)[codeOp.Instruction.Code].ArgCount;
-		if (pc + codeOp.ArgCount >= codeInst->codesize) {
-			cc_error("unexpected end of code data (%d; %d)", pc + codeOp.ArgCount, codeInst->codesize);
-			return -1;
-		}
+			codeOp.ArgCount = (*g_commands)[codeOp.Instruction.Code].ArgCount;
+			if (pc + codeOp.ArgCount >= codeInst->codesize) {
+				cc_error("unexpected end of code data (%d; %d)", pc + codeOp.ArgCount, codeInst->codesize);
+				return -1;
+			}
 
-		int pc_at = pc + 1;
-		for (int i = 0; i < codeOp.ArgCount; ++i, ++pc_at) {
-			char fixup = codeInst->code_fixups[pc_at];
-			if (fixup > 0) {
-				// could be relative pointer or import address
-				/*
-				if (!FixupArgument(code[pc], fixup, codeOp.Args[i]))
-				{
-				    return -1;
-				}
-				*/
-				/* FixupArgument */
-				//=====================================================================
-				switch (fixup) {
-				case FIXUP_GLOBALDATA: {
-					ScriptVariable *gl_var = (ScriptVariable *)codeInst->code[pc_at];
-					codeOp.Args[i].SetGlobalVar(&gl_var->RValue);
-				}
-				break;
-				case FIXUP_FUNCTION:
-					// originally commented -- CHECKME: could this be used in very old versions of AGS?
-					//      code[fixup] += (long)&code[0];
-					// This is a program counter value, presumably will be used as SCMD_CALL argument
-					codeOp.Args[i].SetInt32((int32_t)codeInst->code[pc_at]);
+			int pc_at = pc + 1;
+			for (int i = 0; i < codeOp.ArgCount; ++i, ++pc_at) {
+				char fixup = codeInst->code_fixups[pc_at];
+				if (fixup > 0) {
+					// could be relative pointer or import address
+					/*
+					if (!FixupArgument(code[pc], fixup, codeOp.Args[i]))
+					{
+					    return -1;
+					}
+					*/
+					/* FixupArgument */
+					//=====================================================================
+					switch (fixup) {
+					case FIXUP_GLOBALDATA: {
+						ScriptVariable *gl_var = (ScriptVariable *)codeInst->code[pc_at];
+						codeOp.Args[i].SetGlobalVar(&gl_var->RValue);
+					}
 					break;
-				case FIXUP_STRING:
-					codeOp.Args[i].SetStringLiteral(&codeInst->strings[0] + codeInst->code[pc_at]);
+					case FIXUP_FUNCTION:
+						// originally commented -- CHECKME: could this be used in very old versions of AGS?
+						//      code[fixup] += (long)&code[0];
+						// This is a program counter value, presumably will be used as SCMD_CALL argument
+						codeOp.Args[i].SetInt32((int32_t)codeInst->code[pc_at]);
+						break;
+					case FIXUP_STRING:
+						codeOp.Args[i].SetStringLiteral(&codeInst->strings[0] + codeInst->code[pc_at]);
+						break;
+					case FIXUP_IMPORT: {
+						const ScriptImport *import = _GP(simp).getByIndex(static_cast<uint32_t>(codeInst->code[pc_at]));
+						if (import) {
+							codeOp.Args[i] = import->Value;
+						} else {
+							cc_error("cannot resolve import, key = %ld", codeInst->code[pc_at]);
+							return -1;
+						}
+					}
 					break;
-				case FIXUP_IMPORT: {
-					const ScriptImport *import = _GP(simp).getByIndex(static_cast<uint32_t>(codeInst->code[pc_at]));
-					if (import) {
-						codeOp.Args[i] = import->Value;
-					} else {
-						cc_error("cannot resolve import, key = %ld", codeInst->code[pc_at]);
+					case FIXUP_STACK:
+						codeOp.Args[i] = GetStackPtrOffsetFw((int32_t)codeInst->code[pc_at]);
+						break;
+					default:
+						cc_error("internal fixup type error: %d", fixup);
 						return -1;
 					}
+					/* End FixupArgument */
+					//=====================================================================
+				} else {
+					// should be a numeric literal (int32 or float)
+					codeOp.Args[i].SetInt32((int32_t)codeInst->code[pc_at]);
 				}
-				break;
-				case FIXUP_STACK:
-					codeOp.Args[i] = GetStackPtrOffsetFw((int32_t)codeInst->code[pc_at]);
-					break;
-				default:
-					cc_error("internal fixup type error: %d", fixup);
-					return -1;
-				}
-				/* End FixupArgument */
-				//=====================================================================
-			} else {
-				// should be a numeric literal (int32 or float)
-				codeOp.Args[i].SetInt32((int32_t)codeInst->code[pc_at]);
 			}
+			/* End ReadOperation */
+			//=====================================================================
 		}
-		/* End ReadOperation */
-		//=====================================================================
 
 		// save the arguments for quick access
-		RuntimeScriptValue &arg1 = codeOp.Args[0];
-		RuntimeScriptValue &arg2 = codeOp.Args[1];
-		RuntimeScriptValue &arg3 = codeOp.Args[2];
+		const RuntimeScriptValue &arg1 = op->Args[0];
+		const RuntimeScriptValue &arg2 = op->Args[1];
+		const RuntimeScriptValue &arg3 = op->Args[2];
 		RuntimeScriptValue &reg1 =
 		    registers[arg1.IValue >= 0 && arg1.IValue < CC_NUM_REGISTERS ? arg1.IValue : 0];
 		RuntimeScriptValue &reg2 =
@@ -551,10 +586,10 @@ int ccInstance::Run(int32_t curpc) {
 		const char *direct_ptr2;
 
 		if (write_debug_dump) {
-			DumpInstruction(codeOp);
+			DumpInstruction(*op);
 		}
 
-		switch (codeOp.Instruction.Code) {
+		switch (op->Instruction.Code) {
 		case SCMD_LINENUM:
 			line_number = arg1.IValue;
 			_G(currentline) = arg1.IValue;
@@ -732,7 +767,7 @@ int ccInstance::Run(int32_t curpc) {
 			PUSH_CALL_STACK;
 
 			ASSERT_STACK_SPACE_AVAILABLE(1);
-			PushValueToStack(RuntimeScriptValue().SetInt32(pc + codeOp.ArgCount + 1));
+			PushValueToStack(RuntimeScriptValue().SetInt32(pc + op->ArgCount + 1));
 
 			if (thisbase[curnest] == 0)
 				pc = reg1.IValue;
@@ -975,7 +1010,7 @@ int ccInstance::Run(int32_t curpc) {
 			ccInstance *wasRunning = runningInst;
 
 			// extract the instance ID
-			int32_t instId = codeOp.Instruction.InstanceId;
+			int32_t instId = op->Instruction.InstanceId;
 			// determine the offset into the code of the instance we want
 			runningInst = _G(loadedInstances)[instId];
 			intptr_t callAddr = reg1.Ptr - (char *)&runningInst->code[0];
@@ -1234,11 +1269,11 @@ int ccInstance::Run(int32_t curpc) {
 				loopIterationCheckDisabled++;
 			break;
 		default:
-			cc_error("instruction %d is not implemented", codeOp.Instruction.Code);
+			cc_error("instruction %d is not implemented", op->Instruction.Code);
 			return -1;
 		}
 
-		pc += codeOp.ArgCount + 1;
+		pc += op->ArgCount + 1;
 	}
 	return 0;
 }
@@ -1427,7 +1462,9 @@ bool ccInstance::_Create(PScript scri, ccInstance *joined) {
 	if (joined) {
 		resolved_imports = joined->resolved_imports;
 		code_fixups = joined->code_fixups;
+		prepared_code = joined->prepared_code;
 	} else {
+		prepared_code.reset(new ScriptPreparedCode());
 		if (!CreateGlobalVars(scri.get())) {
 			return false;
 		}
@@ -1512,6 +1549,7 @@ void ccInstance::Free() {
 	}
 	resolved_imports = nullptr;
 	code_fixups = nullptr;
+	prepared_code.reset();
 }
 
 bool ccInstance::ResolveScriptImports(const ccScript *scri) {
@@ -1699,6 +1737,64 @@ bool ccInstance::CreateRuntimeCodeFixups(const ccScript *scri) {
 	return true;
 }
 
+void ccInstance::PrepareCode() {
+	ScriptPreparedCode &prepared = *prepared_code;
+	prepared.OpIndex.clear();
+	prepared.OpIndex.resize(codesize, -1);
+	prepared.Ops.clear();
+
+	// Decode the operations one after another. Anything which can not be
+	// decoded is left to the regular interpreter loop, which reports the error
+	// if the code is ever reached.
+	for (int32_t at_pc = 0; at_pc < codesize;) {
+		ScriptPreparedOp prepared_op;
+		ScriptOperation &op = prepared_op.Op;
+		op.Instruction.Code = code[at_pc];
+		op.Instruction.InstanceId = (op.Instruction.Code >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
+		op.Instruction.Code &= INSTANCE_ID_REMOVEMASK;
+		if (op.Instruction.Code < 0 || op.Instruction.Code >= CC_NUM_SCCMDS)
+			break;
+
+		op.ArgCount = (*g_commands)[op.Instruction.Code].ArgCount;
+		if (at_pc + op.ArgCount >= codesize)
+			break;
+
+		bool valid = true;
+		for (int i = 0; i < op.ArgCount && valid; ++i) {
+			const int32_t pc_at = at_pc + 1 + i;
+			switch (code_fixups[pc_at]) {
+			case 0:
+				op.Args[i].SetInt32((int32_t)code[pc_at]);
+				break;
+			case FIXUP_GLOBALDATA:
+				op.Args[i].SetGlobalVar(&((ScriptVariable *)code[pc_at])->RValue);
+				break;
+			case FIXUP_FUNCTION:
+				op.Args[i].SetInt32((int32_t)code[pc_at]);
+				break;
+			case FIXUP_STRING:
+				op.Args[i].SetStringLiteral(&strings[0] + code[pc_at]);
+				break;
+			case FIXUP_IMPORT:
+			case FIXUP_STACK:
+				prepared_op.DynamicArgs |= (1 << i);
+				break;
+			default:
+				valid = false;
+				break;
+			}
+		}
+		if (!valid)
+			break;
+
+		prepared.OpIndex[at_pc] = prepared.Ops.size();
+		prepared.Ops.push_back(prepared_op);
+		at_pc += op.ArgCount + 1;
+	}
+
+	prepared.IsPrepared = true;
+}
+
 bool ccInstance::ResolveImportFixups(const ccScript *scri) {
 	for (int fixup_idx = 0; fixup_idx < scri->numfixups; ++fixup_idx) {
 		if (scri->fixuptypes[fixup_idx] != FIXUP_IMPORT)
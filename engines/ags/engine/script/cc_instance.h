@@ -24,6 +24,7 @@
 
 #include "ags/lib/std/memory.h"
 #include "ags/lib/std/map.h"
+#include "ags/lib/std/vector.h"
 #include "ags/engine/ac/timer.h"
 #include "ags/shared/script/cc_internal.h"
 #include "ags/shared/script/cc_script.h"  // ccScript
@@ -69,6 +70,33 @@ struct ScriptOperation {
 	int                 ArgCount;
 };
 
+// Operation with the arguments decoded ahead of execution
+struct ScriptPreparedOp {
+	ScriptPreparedOp() {
+		DynamicArgs = 0;
+	}
+
+	ScriptOperation     Op;
+	// Bit mask of the arguments which depend on the execution state
+	// (stack offsets and imports), and have to be resolved on each run
+	uint8_t             DynamicArgs;
+};
+
+// Byte-code translated into a sequence of prepared operations
+struct ScriptPreparedCode {
+	ScriptPreparedCode() {
+		IsPrepared = false;
+	}
+
+	bool IsPrepared;
+	// For each byte-code position, the index of the operation starting
+	// there, or -1 if no operation starts there
+	std::vector<int32_t> OpIndex;
+	std::vector<ScriptPreparedOp> Ops;
+};
+
+typedef std::shared_ptr<ScriptPreparedCode> PScriptPreparedCode;
+
 struct ScriptVariable {
 	ScriptVariable() {
 		ScAddress = -1; // address = 0 is valid one, -1 means undefined
@@ -140,6 +168,10 @@ public:
 
 	char *code_fixups;
 
+	// Pre-decoded byte-code, shared with forked instances; only filled in
+	// when the instance is run with SCOPT_PREDECODED enabled
+	PScriptPreparedCode prepared_code;
+
 	// returns the currently executing instance, or NULL if none
 	static ccInstance *GetCurrentInstance(void);
 	// create a runnable instance of the supplied script
@@ -189,6 +221,8 @@ private:
 	bool    AddGlobalVar(const ScriptVariable &glvar);
 	ScriptVariable *FindGlobalVar(int32_t var_addr);
 	bool    CreateRuntimeCodeFixups(const ccScript *scri);
+	// Decode the whole byte-code into prepared_code
+	void    PrepareCode();
 	//bool    ReadOperation(ScriptOperation &op, int32_t at_pc);
 
 	// Begin executing script starting from the given bytecode index
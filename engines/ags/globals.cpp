@@ -137,7 +137,7 @@ Globals::Globals() {
 	_GlobalReturnValue = new RuntimeScriptValue();
 
 	// cc_options.cpp globals
-	_ccCompOptions = SCOPT_LEFTTORIGHT;
+	_ccCompOptions = SCOPT_LEFTTORIGHT | SCOPT_PREDECODED;
 
 	// cc_serializer.cpp globals
 	_ccUnserializer = new AGSDeSerializer();
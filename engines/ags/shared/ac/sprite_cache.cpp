@@ -62,7 +62,8 @@ namespace Shared {
 
 SpriteCache::SpriteCache(std::vector<SpriteInfo> &sprInfos)
 	: _sprInfos(sprInfos), _maxCacheSize(DEFAULTCACHESIZE_KB * 1024u),
-	_cacheSize(0u), _lockedSize(0u) {
+	_cacheSize(0u), _lockedSize(0u), _maxCompressedSize(0u), _compressedSize(0u),
+	_prefetchPos(0u) {
 }
 
 SpriteCache::~SpriteCache() {
@@ -90,6 +91,23 @@ void SpriteCache::SetMaxCacheSize(size_t size) {
 	_maxCacheSize = size;
 }
 
+size_t SpriteCache::GetCompressedSize() const {
+	return _compressedSize;
+}
+
+size_t SpriteCache::GetMaxCompressedSize() const {
+	return _maxCompressedSize;
+}
+
+void SpriteCache::SetMaxCompressedSize(size_t size) {
+	FreeCompressedMem(size);
+	_maxCompressedSize = size;
+}
+
+void SpriteCache::ResetStats() {
+	_stats = Stats();
+}
+
 void SpriteCache::Reset() {
 	_file.Close();
 	// TODO: find out if it's safe to simply always delete _spriteData.Image with array element
@@ -103,6 +121,9 @@ void SpriteCache::Reset() {
 	_mru.clear();
 	_cacheSize = 0;
 	_lockedSize = 0;
+	_compressedMru.clear();
+	_compressedSize = 0;
+	ClearPrefetch();
 }
 
 bool SpriteCache::SetSprite(sprkey_t index, Bitmap *sprite, int flags) {
@@ -149,6 +170,7 @@ void SpriteCache::RemoveSprite(sprkey_t index, bool freeMemory) {
 
 	if (freeMemory)
 		delete _spriteData[index].Image;
+	DisposeCompressed(index);
 	InitNullSpriteParams(index);
 	SprCacheLog("RemoveSprite: %d", index);
 }
@@ -211,11 +233,19 @@ Bitmap *SpriteCache::operator [] (sprkey_t index) {
 		return _spriteData[index].Image;
 
 	if (_spriteData[index].Image) {
+		_stats.Hits++;
+		if (_spriteData[index].Flags & SPRCACHEFLAG_PREFETCHED) {
+			_stats.PrefetchHits++;
+			_spriteData[index].Flags &= ~SPRCACHEFLAG_PREFETCHED;
+		}
 		// Move to the beginning of the MRU list
 		_mru.splice(_mru.begin(), _mru, _spriteData[index].MruIt);
 	} else {
 		// Sprite exists in file but is not in mem, load it
+		_stats.Misses++;
+		const uint32_t start = g_system->getMillis();
 		LoadSprite(index);
+		_stats.StallMs += g_system->getMillis() - start;
 		_spriteData[index].MruIt = _mru.insert(_mru.begin(), index);
 	}
 	return _spriteData[index].Image;
@@ -253,6 +283,7 @@ void SpriteCache::DisposeOldest() {
 		_cacheSize -= _spriteData[sprnum].Size;
 		delete _spriteData[*it].Image;
 		_spriteData[sprnum].Image = nullptr;
+		_spriteData[sprnum].Flags &= ~SPRCACHEFLAG_PREFETCHED;
 		SprCacheLog("DisposeOldest: disposed %d, size now %d KB", sprnum, _cacheSize / 1024);
 	}
 	// Remove from the mru list
@@ -269,12 +300,53 @@ void SpriteCache::DisposeAll() {
 		{
 			delete _spriteData[i].Image;
 			_spriteData[i].Image = nullptr;
+			_spriteData[i].Flags &= ~SPRCACHEFLAG_PREFETCHED;
 		}
 	}
 	_cacheSize = _lockedSize;
 	_mru.clear();
 }
 
+void SpriteCache::PrefetchSprite(sprkey_t index) {
+	if (index < 0 || (size_t)index >= _spriteData.size())
+		return;
+	if (_spriteData[index].Image || !_spriteData[index].IsAssetSprite() ||
+		(_spriteData[index].Flags & SPRCACHEFLAG_REMAPPED) != 0)
+		return; // already loaded, or nothing to load
+	if (_prefetchQueue.size() >= MAX_PREFETCH_QUEUE)
+		return;
+	_prefetchQueue.push_back(index);
+}
+
+void SpriteCache::ProcessPrefetch(uint32_t time_ms) {
+	const uint32_t start = g_system->getMillis();
+	for (; _prefetchPos < _prefetchQueue.size(); ++_prefetchPos) {
+		if (g_system->getMillis() - start >= time_ms)
+			return;
+		const sprkey_t index = _prefetchQueue[_prefetchPos];
+		if ((size_t)index >= _spriteData.size() || _spriteData[index].Image ||
+			!_spriteData[index].IsAssetSprite() || (_spriteData[index].Flags & SPRCACHEFLAG_REMAPPED) != 0)
+			continue;
+		// Only use the free space: the cached sprites are more likely to be
+		// needed than the prefetched ones. Assume the largest color depth.
+		const size_t size = _sprInfos[index].Width * _sprInfos[index].Height * 4;
+		if (_cacheSize + size > _maxCacheSize)
+			continue;
+		if (LoadSprite(index) == 0 || !_spriteData[index].Image)
+			continue;
+		_spriteData[index].MruIt = _mru.insert(_mru.begin(), index);
+		_spriteData[index].Flags |= SPRCACHEFLAG_PREFETCHED;
+		_stats.Prefetched++;
+		SprCacheLog("Prefetched %d", index);
+	}
+	ClearPrefetch();
+}
+
+void SpriteCache::ClearPrefetch() {
+	_prefetchQueue.clear();
+	_prefetchPos = 0;
+}
+
 void SpriteCache::Precache(sprkey_t index) {
 	if (index < 0 || (size_t)index >= _spriteData.size())
 		return;
@@ -312,7 +384,7 @@ size_t SpriteCache::LoadSprite(sprkey_t index) {
 
 	sprkey_t load_index = GetDataIndex(index);
 	Bitmap *image;
-	HError err = _file.LoadSprite(load_index, image);
+	HError err = LoadSpriteImage(load_index, image);
 	if (!image) {
 		Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Warn,
 			"LoadSprite: failed to load sprite %d:\n%s\n - remapping to sprite 0.", index,
@@ -349,6 +421,52 @@ size_t SpriteCache::LoadSprite(sprkey_t index) {
 	return size;
 }
 
+HError SpriteCache::LoadSpriteImage(sprkey_t index, Bitmap *&image) {
+	if (_maxCompressedSize == 0)
+		return _file.LoadSprite(index, image);
+
+	SpriteData &data = _spriteData[index];
+	if (!data.CompressedData.empty()) {
+		_stats.CompressedHits++;
+		_compressedMru.splice(_compressedMru.begin(), _compressedMru, data.CompressedMruIt);
+		return _file.LoadSpriteFromRawData(index, data.CompressedHdr, data.CompressedData, image);
+	}
+
+	image = nullptr;
+	HError err = _file.LoadRawData(index, data.CompressedHdr, data.CompressedData);
+	if (!err)
+		return err;
+	err = _file.LoadSpriteFromRawData(index, data.CompressedHdr, data.CompressedData, image);
+	// Keep only the data which is actually compressed and fits in the limit;
+	// otherwise it would take about as much memory as the image itself
+	const size_t size = data.CompressedData.size();
+	if (!image || data.CompressedHdr.Compress == kSprCompress_None || size > _maxCompressedSize) {
+		data.CompressedData.clear();
+		return err;
+	}
+	FreeCompressedMem(_maxCompressedSize - size);
+	_compressedSize += size;
+	data.CompressedMruIt = _compressedMru.insert(_compressedMru.begin(), index);
+	return err;
+}
+
+void SpriteCache::DisposeCompressed(sprkey_t index) {
+	SpriteData &data = _spriteData[index];
+	if (data.CompressedData.empty())
+		return;
+	_compressedSize -= data.CompressedData.size();
+	data.CompressedData.clear();
+	_compressedMru.erase(data.CompressedMruIt);
+	// std::list::erase() invalidates iterators to the erased item.
+	// But our implementation does not.
+	data.CompressedMruIt._node = nullptr;
+}
+
+void SpriteCache::FreeCompressedMem(size_t limit) {
+	while (!_compressedMru.empty() && _compressedSize > limit)
+		DisposeCompressed(_compressedMru.back());
+}
+
 void SpriteCache::RemapSpriteToSprite0(sprkey_t index) {
 	_sprInfos[index].Flags = _sprInfos[0].Flags;
 	_sprInfos[index].Width = _sprInfos[0].Width;
@@ -70,6 +70,8 @@ struct SpriteInfo;
 #define SPRCACHEFLAG_REMAPPED       0x02
 // Locked sprites are ones that should not be freed when out of cache space.
 #define SPRCACHEFLAG_LOCKED         0x04
+// Tells that the sprite was loaded ahead of time and was not requested yet.
+#define SPRCACHEFLAG_PREFETCHED     0x08
 
 // Max size of the sprite cache, in bytes
 #if AGS_PLATFORM_OS_ANDROID || AGS_PLATFORM_OS_IOS
@@ -88,6 +90,18 @@ public:
 	static const sprkey_t MIN_SPRITE_INDEX = 1; // 0 is reserved for "empty sprite"
 	static const sprkey_t MAX_SPRITE_INDEX = INT32_MAX - 1;
 	static const size_t   MAX_SPRITE_SLOTS = INT32_MAX;
+	// Max number of sprites waiting to be prefetched
+	static const size_t   MAX_PREFETCH_QUEUE = 256;
+
+	// Cache usage statistics
+	struct Stats {
+		uint32_t Hits = 0;           // requests served by an already loaded image
+		uint32_t Misses = 0;         // requests which had to load the sprite
+		uint32_t StallMs = 0;        // total time spent loading sprites on request
+		uint32_t Prefetched = 0;     // sprites loaded ahead of time
+		uint32_t PrefetchHits = 0;   // prefetched sprites which were requested later
+		uint32_t CompressedHits = 0; // sprites restored from the compressed data in memory
+	};
 
 	SpriteCache(std::vector<SpriteInfo> &sprInfos);
 	~SpriteCache();
@@ -143,6 +157,27 @@ public:
 	void        SubstituteBitmap(sprkey_t index, Shared::Bitmap *);
 	// Sets max cache size in bytes
 	void        SetMaxCacheSize(size_t size);
+	// Returns the size of the compressed sprite data kept in memory, in bytes
+	size_t      GetCompressedSize() const;
+	// Returns the limit of the compressed sprite data kept in memory, in bytes
+	size_t      GetMaxCompressedSize() const;
+	// Sets the limit of the compressed sprite data kept in memory, in bytes;
+	// 0 disables keeping compressed data, so that evicted sprites are reread from file
+	void        SetMaxCompressedSize(size_t size);
+
+	// Queues the sprite to be loaded ahead of time, when the engine is idle
+	void        PrefetchSprite(sprkey_t index);
+	// Loads the queued sprites until the given time runs out;
+	// prefetching never evicts sprites already in cache
+	void        ProcessPrefetch(uint32_t time_ms);
+	// Drops all the queued sprites
+	void        ClearPrefetch();
+
+	// Returns cache usage statistics
+	const Stats &GetStats() const {
+		return _stats;
+	}
+	void        ResetStats();
 
 	// Loads (if it's not in cache yet) and returns bitmap by the sprite index
 	Shared::Bitmap *operator[](sprkey_t index);
@@ -157,6 +192,12 @@ private:
 	void        DisposeOldest();
 	// Keep disposing oldest elements until cache has at least the given free space
 	void        FreeMem(size_t space);
+	// Loads sprite image, using the compressed data kept in memory if possible
+	HError      LoadSpriteImage(sprkey_t index, Shared::Bitmap *&image);
+	// Deletes the compressed data of the given sprite
+	void        DisposeCompressed(sprkey_t index);
+	// Keep disposing oldest compressed data until it fits in the given limit
+	void        FreeCompressedMem(size_t limit);
 
 	// Information required for the sprite streaming
 	struct SpriteData {
@@ -167,6 +208,11 @@ private:
 		Shared::Bitmap *Image = nullptr; // actual bitmap
 		// MRU list reference
 		std::list<sprkey_t>::iterator MruIt;
+		// Sprite data as it is stored in file, kept to avoid rereading it
+		SpriteDatHeader CompressedHdr;
+		std::vector<uint8_t> CompressedData;
+		// Compressed MRU list reference
+		std::list<sprkey_t>::iterator CompressedMruIt;
 
 		// Tells if there actually is a registered sprite in this slot
 		bool DoesSpriteExist() const;
@@ -194,6 +240,17 @@ private:
 	// that were last time used long ago.
 	std::list<sprkey_t> _mru;
 
+	size_t _maxCompressedSize; // compressed data size limit
+	size_t _compressedSize;    // size in bytes of currently kept compressed data
+	// MRU list of the sprites having compressed data in memory
+	std::list<sprkey_t> _compressedMru;
+
+	// Sprites waiting to be prefetched, and the next one to process
+	std::vector<sprkey_t> _prefetchQueue;
+	size_t _prefetchPos;
+
+	Stats _stats;
+
 	// Initialize the empty sprite slot
 	void        InitNullSpriteParams(sprkey_t index);
 };
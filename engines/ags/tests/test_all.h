@@ -35,6 +35,9 @@ extern void Test_IniFile();
 // Graphics tests
 extern void Test_Gfx();
 
+// Script interpreter tests
+extern void Test_Script();
+
 // Memory / bit-byte operations
 extern void Test_Memory();
 
@@ -30,6 +30,7 @@
 #include "ags/shared/gfx/image.h"
 #include "ags/lib/allegro/surface.h"
 #include "ags/shared/debugging/debug_manager.h"
+#include "ags/engine/gfx/gfx_util.h"
 #include "ags/globals.h"
 #include "graphics/managed_surface.h"
 #include "graphics/pixelformat.h"
@@ -263,8 +264,59 @@ void Test_GfxTransparency() {
 	}
 }
 
+static bool IsSameRect(const Rect &a, const Rect &b) {
+	return a.Left == b.Left && a.Top == b.Top && a.Right == b.Right && a.Bottom == b.Bottom;
+}
+
+void Test_GfxDirtyRects() {
+	using AGS::Engine::GfxUtil::FindChangedRects;
+	Bitmap *frame = BitmapHelper::CreateClearBitmap(320, 200, 32);
+	Bitmap *prev = BitmapHelper::CreateClearBitmap(320, 200, 32);
+	std::vector<Rect> rects;
+
+	// Same frames have no changes
+	FindChangedRects(frame, prev, 32, 16, rects);
+	assert(rects.empty());
+
+	// Single pixel marks the tile it is in
+	frame->PutPixel(100, 50, 0xFFFFFF);
+	FindChangedRects(frame, prev, 32, 16, rects);
+	assert(rects.size() == 1);
+	assert(IsSameRect(rects[0], Rect(96, 48, 127, 63)));
+
+	// Tiles in a row, and in the following rows of same width, make one rect;
+	// the last column and row tiles are clipped to the bitmap size
+	frame->FillRect(Rect(290, 150, 319, 199), 0xFF00FF);
+	FindChangedRects(frame, prev, 32, 16, rects);
+	assert(rects.size() == 2);
+	assert(IsSameRect(rects[0], Rect(96, 48, 127, 63)));
+	assert(IsSameRect(rects[1], Rect(288, 144, 319, 199)));
+
+	// Compare the time it takes to find the changed parts, with copying the frame
+	Bitmap *large = BitmapHelper::CreateClearBitmap(640, 480, 32);
+	Bitmap *large_prev = BitmapHelper::CreateClearBitmap(640, 480, 32);
+	large->FillRect(Rect(300, 200, 363, 299), 0xFFFFFF); // about a character sized change
+	const int iters = 1000;
+	uint32 start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < iters; ++i)
+		FindChangedRects(large, large_prev, 32, 16, rects);
+	uint32 compare_time = std::chrono::high_resolution_clock::now() - start;
+	start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < iters; ++i)
+		large_prev->Blit(large);
+	uint32 copy_time = std::chrono::high_resolution_clock::now() - start;
+	debug("Finding changed rects of 640x480 frame, %d iters (in milliseconds): %u", iters, compare_time);
+	debug("Copying 640x480 frame, %d iters (in milliseconds): %u", iters, copy_time);
+
+	delete large;
+	delete large_prev;
+	delete frame;
+	delete prev;
+}
+
 void Test_Gfx() {
 	Test_GfxTransparency();
+	Test_GfxDirtyRects();
 #if (defined(SCUMMVM_AVX2) || defined(SCUMMVM_SSE2) || defined(SCUMMVM_NEON)) && defined(SLOW_TESTS)
 	Test_BlenderModes();
 	// This could take a LONG time
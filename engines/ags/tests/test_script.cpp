@@ -0,0 +1,97 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/scummsys.h"
+#include "common/debug.h"
+#include "common/system.h"
+#include "ags/shared/core/platform.h"
+#include "ags/shared/script/cc_common.h"
+#include "ags/shared/script/cc_internal.h"
+#include "ags/engine/script/cc_instance.h"
+
+namespace AGS3 {
+
+// Creates a script with a single function "loop", which counts up to
+// the given number and returns it
+static PScript CreateLoopScript(int32_t iterations) {
+	const int32_t code[] = {
+		/*  0 */ SCMD_LITTOREG, SREG_BX, iterations,
+		/*  3 */ SCMD_LITTOREG, SREG_CX, 0,
+		/*  6 */ SCMD_ADD, SREG_CX, 1,
+		/*  9 */ SCMD_REGTOREG, SREG_CX, SREG_AX,
+		/* 12 */ SCMD_LESSTHAN, SREG_AX, SREG_BX,
+		/* 15 */ SCMD_JNZ, -11,
+		/* 17 */ SCMD_REGTOREG, SREG_CX, SREG_AX,
+		/* 20 */ SCMD_RET
+	};
+
+	PScript script(new ccScript());
+	script->codesize = ARRAYSIZE(code);
+	script->code = (int32_t *)malloc(sizeof(code));
+	memcpy(script->code, code, sizeof(code));
+	script->numexports = 1;
+	script->exportsCapacity = 1;
+	script->exports = (char **)malloc(sizeof(char *));
+	script->exports[0] = scumm_strdup("loop");
+	script->export_addr = (int32_t *)malloc(sizeof(int32_t));
+	script->export_addr[0] = (EXPORT_FUNCTION << 24L) | 0;
+	return script;
+}
+
+static int RunLoopScript(ccInstance *inst, bool predecoded, uint32 &time) {
+	ccSetOption(SCOPT_PREDECODED, predecoded ? 1 : 0);
+	uint32 start = g_system->getMillis();
+	int result = inst->CallScriptFunction("loop", 0, nullptr);
+	time = g_system->getMillis() - start;
+	assert(result == 0);
+	return inst->returnValue;
+}
+
+void Test_Script() {
+	const int32_t iterations = 5000000;
+	// Four operations per iteration, plus setting up and returning
+	const uint64 numOps = (uint64)iterations * 4 + 4;
+
+	PScript script = CreateLoopScript(iterations);
+	ccInstance *inst = ccInstance::CreateFromScript(script);
+	assert(inst);
+	inst->ResolveScriptImports(script.get());
+	inst->ResolveImportFixups(script.get());
+
+	const int oldPredecoded = ccGetOption(SCOPT_PREDECODED);
+	uint32 plainTime, predecodedTime;
+	int plainResult = RunLoopScript(inst, false, plainTime);
+	int predecodedResult = RunLoopScript(inst, true, predecodedTime);
+	ccSetOption(SCOPT_PREDECODED, oldPredecoded);
+
+	assert(plainResult == iterations);
+	assert(predecodedResult == iterations);
+
+	debug("Script interpreter: %u ms, %u ops/s", plainTime,
+		(uint32)(numOps * 1000 / MAX<uint32>(plainTime, 1)));
+	debug("Pre-decoded script interpreter: %u ms, %u ops/s", predecodedTime,
+		(uint32)(numOps * 1000 / MAX<uint32>(predecodedTime, 1)));
+
+	delete inst;
+}
+
+} // namespace AGS3
@@ -146,7 +146,7 @@ Datum CastMember::getField(int field) {
 		break;
 	case kTheCastType:
 		d.type = SYMBOL;
-		d.u.s = new Common::String(castType2str(_type));
+		d.u.s = newDatumString(castType2str(_type));
 		break;
 	case kTheFileName:
 		if (castInfo)
@@ -473,13 +473,13 @@ Datum TextCastMember::getField(int field) {
 		d.type = STRING;
 		switch (_textAlign) {
 		case kTextAlignLeft:
-			d.u.s = new Common::String("left");
+			d.u.s = newDatumString("left");
 			break;
 		case kTextAlignCenter:
-			d.u.s = new Common::String("center");
+			d.u.s = newDatumString("center");
 			break;
 		case kTextAlignRight:
-			d.u.s = new Common::String("right");
+			d.u.s = newDatumString("right");
 			break;
 		default:
 			warning("TextCastMember::getField(): Invalid text align spec");
@@ -488,7 +488,7 @@ Datum TextCastMember::getField(int field) {
 		break;
 	case kTheTextFont:
 		d.type = STRING;
-		d.u.s = new Common::String(g_director->_wm->_fontMan->getFontName(_fontId));
+		d.u.s = newDatumString(g_director->_wm->_fontMan->getFontName(_fontId));
 		break;
 	case kTheTextHeight:
 		d = getTextHeight();
@@ -645,7 +645,7 @@ Datum TextCastMember::getChunkField(int field, int start, int end) {
 			fontId = _fontId;
 
 		d.type = STRING;
-		d.u.s = new Common::String(g_director->_wm->_fontMan->getFontName(fontId));
+		d.u.s = newDatumString(g_director->_wm->_fontMan->getFontName(fontId));
 		break;
 		}
 	case kTheTextHeight:
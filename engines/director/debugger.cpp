@@ -278,6 +278,14 @@ bool Debugger::cmdInfo(int argc, const char **argv) {
 	debugPrintf("Remap palettes when needed flag: %d\n", movie->_remapPalettesWhenNeeded);
 	debugPrintf("Allow outdated Lingo flag: %d\n", movie->_allowOutdatedLingo);
 	debugPrintf("Frame count: %d\n", score->getFramesNum());
+	const FrameSeekStats &seekStats = score->getSeekStats();
+	debugPrintf("Frame keyframes: %d every %d frames, %d bytes\n", score->getKeyframeCount(), score->getKeyframeInterval(), score->getKeyframesSize());
+	debugPrintf("Frame seeks: %d, from keyframes: %d, frames decoded per seek: %.1f\n", seekStats.seeks, seekStats.keyframeHits,
+		seekStats.seeks ? (float)seekStats.framesDecoded / seekStats.seeks : 0.0f);
+	const DatumAllocStats &allocStats = getDatumAllocStats();
+	debugPrintf("Lingo value heap allocations: pool pages: %d (last frame: %d, peak: %d), payloads: %d (last frame: %d, peak: %d)\n",
+		allocStats.poolPages, g_lingo->_frameAllocs.poolPages, g_lingo->_peakFrameAllocs.poolPages,
+		allocStats.heapPayloads, g_lingo->_frameAllocs.heapPayloads, g_lingo->_peakFrameAllocs.heapPayloads);
 	debugPrintf("Cast member count: %d\n", cast->getCastSize());
 	debugPrintf("Search paths:\n");
 	if (g_lingo->_searchPath.isArray() && g_lingo->_searchPath.u.farr->arr.size() > 0) {
@@ -1150,6 +1158,10 @@ void Debugger::stepHook() {
 	}
 }
 
+bool Debugger::needsStepHook() const {
+	return _step || _finish || _bpCheckFunc || _bpCheckMoviePath;
+}
+
 void Debugger::frameHook() {
 	bpTest();
 	if (_nextFrame) {
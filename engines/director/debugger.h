@@ -68,6 +68,7 @@ public:
 	~Debugger();
 	void debugLogFile(Common::String logs, bool prompt);
 	void stepHook();
+	bool needsStepHook() const;
 	void frameHook();
 	void movieHook();
 	void eventHook(LEvent eventId);
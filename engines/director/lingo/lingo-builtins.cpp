@@ -1527,7 +1527,7 @@ void LB::b_play(int nargs) {
 		// fall through
 	case 0:
 		frame.type = SYMBOL;
-		frame.u.s = new Common::String("done");
+		frame.u.s = newDatumString("done");
 		break;
 	default:
 		warning("b_play: expected 0, 1 or 2 args, not %d", nargs);
@@ -2311,7 +2311,7 @@ void LB::b_move(int nargs) {
 	if (dest.type == INT) {
 		dest.type = CASTREF;
 		int datum_int = dest.u.i;
-		dest.u.cast = new CastMemberID();
+		dest.u.cast = newDatumCast(CastMemberID());
 		dest.u.cast->member = datum_int;
 	}
 
@@ -1211,7 +1211,7 @@ ScriptContext *LingoCompiler::compileLingoV4(Common::SeekableReadStreamEndian &s
 					break;
 				}
 				constant.type = STRING;
-				constant.u.s = new Common::String(archive->cast->decodeString(str), Common::kUtf8);
+				constant.u.s = newDatumString(Common::String(archive->cast->decodeString(str), Common::kUtf8));
 			}
 			break;
 		case 4: // Integer type
@@ -1804,7 +1804,7 @@ void LC::c_delete() {
 		res += text.substr(end);
 	}
 	Datum s;
-	s.u.s = new Common::String(res, Common::kUtf8);
+	s.u.s = newDatumString(Common::String(res, Common::kUtf8));
 	s.type = STRING;
 	g_lingo->varAssign(field, s);
 }
@@ -161,7 +161,7 @@ void Lingo::func_play(Datum &frame, Datum &movie) {
 			m.type = VOID;
 		} else {
 			m.type = STRING;
-			m.u.s = new Common::String(ref.movie);
+			m.u.s = newDatumString(ref.movie);
 		}
 
 		f.type = INT;
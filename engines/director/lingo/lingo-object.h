@@ -71,8 +71,7 @@ protected:
 		_objType = kNoneObj;
 		_disposed = false;
 		_inheritanceLevel = 1;
-		_refCount = new int;
-		*_refCount = 0;
+		_refCount = newRefCount(0);
 	};
 
 	Object(const Object &obj) {
@@ -80,8 +79,7 @@ protected:
 		_objType = obj._objType;
 		_disposed = obj._disposed;
 		_inheritanceLevel = obj._inheritanceLevel + 1;
-		_refCount = new int;
-		*_refCount = 0;
+		_refCount = newRefCount(0);
 	};
 
 public:
@@ -112,7 +110,7 @@ public:
 	}
 
 	virtual ~Object() {
-		delete _refCount;
+		deleteRefCount(_refCount);
 	};
 
 	Common::String getName() const override { return _name; };
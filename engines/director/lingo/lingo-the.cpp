@@ -462,7 +462,7 @@ Datum Lingo::getTheEntity(int entity, Datum &id, int field) {
 		break;
 	case kTheFrameLabel:
 		d.type = STRING;
-		d.u.s = score->getFrameLabel(score->getCurrentFrameNum());
+		d.u.s = newDatumString(score->getFrameLabel(score->getCurrentFrameNum()));
 		break;
 	case kTheFrameScript:
 		d = score->_currentFrame->_mainChannels.actionId.member;
@@ -487,12 +487,12 @@ Datum Lingo::getTheEntity(int entity, Datum &id, int field) {
 		{
 			Common::U32String ch(g_lingo->_itemDelimiter);
 			d.type = STRING;
-			d.u.s = new Common::String(ch, Common::kUtf8);
+			d.u.s = newDatumString(Common::String(ch, Common::kUtf8));
 		}
 		break;
 	case kTheKey:
 		d.type = STRING;
-		d.u.s = new Common::String(movie->_key);
+		d.u.s = newDatumString(Common::String(movie->_key));
 		break;
 	case kTheKeyCode:
 		d = movie->_keyCode;
@@ -500,20 +500,20 @@ Datum Lingo::getTheEntity(int entity, Datum &id, int field) {
 	case kTheKeyDownScript:
 		d.type = STRING;
 		if (mainArchive->primaryEventHandlers.contains(kEventKeyDown))
-			d.u.s = new Common::String(mainArchive->primaryEventHandlers[kEventKeyDown]);
+			d.u.s = newDatumString(mainArchive->primaryEventHandlers[kEventKeyDown]);
 		else
-			d.u.s = new Common::String();
+			d.u.s = newDatumString();
 		break;
 	case kTheKeyUpScript:
 		d.type = STRING;
 		if (mainArchive->primaryEventHandlers.contains(kEventKeyUp))
-			d.u.s = new Common::String(mainArchive->primaryEventHandlers[kEventKeyUp]);
+			d.u.s = newDatumString(mainArchive->primaryEventHandlers[kEventKeyUp]);
 		else
-			d.u.s = new Common::String();
+			d.u.s = newDatumString();
 		break;
 	case kTheLabelList:
 		d.type = STRING;
-		d.u.s = score->getLabelList();
+		d.u.s = newDatumString(score->getLabelList());
 		break;
 	case kTheLastClick:
 		d = (int)(_vm->getMacTicks() - movie->_lastClickTime);
@@ -591,7 +591,7 @@ Datum Lingo::getTheEntity(int entity, Datum &id, int field) {
 		} else {
 			menuRef = g_director->_wm->getMenu()->getMenuItem(id.u.menu->menuIdNum - 1);
 		}
-		d.u.s = new Common::String();
+		d.u.s = newDatumString();
 		*d.u.s = g_director->_wm->getMenu()->getName(menuRef);
 		break;
 	case kTheMenuItem:
@@ -618,7 +618,7 @@ Datum Lingo::getTheEntity(int entity, Datum &id, int field) {
 			break;
 		case kTheName:
 			d.type = STRING;
-			d.u.s = new Common::String;
+			d.u.s = newDatumString();
 			*(d.u.s) = g_director->_wm->getMenuItemName(menuItem);
 			break;
 		case kTheScript:
@@ -660,9 +660,9 @@ Datum Lingo::getTheEntity(int entity, Datum &id, int field) {
 	case kTheMouseDownScript:
 		d.type = STRING;
 		if (mainArchive->primaryEventHandlers.contains(kEventMouseDown))
-			d.u.s = new Common::String(mainArchive->primaryEventHandlers[kEventMouseDown]);
+			d.u.s = newDatumString(mainArchive->primaryEventHandlers[kEventMouseDown]);
 		else
-			d.u.s = new Common::String();
+			d.u.s = newDatumString();
 		break;
 	case kTheMouseH:
 		d = g_director->getCurrentWindow()->getMousePos().x;
@@ -689,9 +689,9 @@ Datum Lingo::getTheEntity(int entity, Datum &id, int field) {
 	case kTheMouseUpScript:
 		d.type = STRING;
 		if (mainArchive->primaryEventHandlers.contains(kEventMouseUp))
-			d.u.s = new Common::String(mainArchive->primaryEventHandlers[kEventMouseUp]);
+			d.u.s = newDatumString(mainArchive->primaryEventHandlers[kEventMouseUp]);
 		else
-			d.u.s = new Common::String();
+			d.u.s = newDatumString();
 		break;
 	case kTheMouseV:
 		d = g_director->getCurrentWindow()->getMousePos().y;
@@ -708,7 +708,7 @@ Datum Lingo::getTheEntity(int entity, Datum &id, int field) {
 	case kTheMovie:
 	case kTheMovieName:
 		d.type = STRING;
-		d.u.s = new Common::String(movie->getMacName());
+		d.u.s = newDatumString(movie->getMacName());
 		break;
 	case kTheMovieFileFreeSize:
 		d = 0;	// Let's pretend the movie is compactified
@@ -719,7 +719,7 @@ Datum Lingo::getTheEntity(int entity, Datum &id, int field) {
 	case kTheMoviePath:
 	case kThePathName:
 		d.type = STRING;
-		d.u.s = new Common::String(_vm->getCurrentAbsolutePath());
+		d.u.s = newDatumString(_vm->getCurrentAbsolutePath());
 		break;
 	case kTheMultiSound:
 		// We always support multiple sound channels!
@@ -783,7 +783,7 @@ Datum Lingo::getTheEntity(int entity, Datum &id, int field) {
 
 			if (channel->_widget) {
 				d.type = STRING;
-				d.u.s = new Common::String(Common::convertFromU32String(((Graphics::MacText *)channel->_widget)->getSelection(false, false)));
+				d.u.s = newDatumString(Common::convertFromU32String(((Graphics::MacText *)channel->_widget)->getSelection(false, false)));
 			}
 		}
 		break;
@@ -871,9 +871,9 @@ Datum Lingo::getTheEntity(int entity, Datum &id, int field) {
 	case kTheTimeoutScript:
 		d.type = STRING;
 		if (mainArchive->primaryEventHandlers.contains(kEventTimeout))
-			d.u.s = new Common::String(mainArchive->primaryEventHandlers[kEventTimeout]);
+			d.u.s = newDatumString(mainArchive->primaryEventHandlers[kEventTimeout]);
 		else
-			d.u.s = new Common::String();
+			d.u.s = newDatumString();
 		break;
 	case kTheTimer:
 		d = (int)(_vm->getMacTicks() - movie->_lastTimerReset);
@@ -886,7 +886,7 @@ Datum Lingo::getTheEntity(int entity, Datum &id, int field) {
 		break;
 	case kTheTraceLogFile:
 		d.type = STRING;
-		d.u.s = new Common::String(g_director->_traceLogFile);
+		d.u.s = newDatumString(g_director->_traceLogFile);
 		break;
 	case kTheUpdateMovieEnabled:
 		d = g_lingo->_updateMovieEnabled;
@@ -2091,7 +2091,7 @@ Datum Lingo::getTheDate(int field) {
 		break;
 	}
 
-	d.u.s = new Common::String(s);
+	d.u.s = newDatumString(s);
 
 	return d;
 }
@@ -2115,7 +2115,7 @@ Datum Lingo::getTheTime(int field) {
 		break;
 	}
 
-	d.u.s = new Common::String(s);
+	d.u.s = newDatumString(s);
 
 	return d;
 }
@@ -20,6 +20,7 @@
  */
 
 #include "common/file.h"
+#include "common/memorypool.h"
 
 #include "graphics/macgui/macwindowmanager.h"
 
@@ -53,12 +54,110 @@ int calcCodeAlignment(int l) {
 	return (l + instLen - 1) / instLen;
 }
 
+static DatumAllocStats s_datumAllocStats;
+
+/* Pool for one kind of value payload, which counts the pages it has to
+ * allocate from the heap.
+ */
+template<class T, size_t NUM_INTERNAL_CHUNKS>
+class DatumPool : public Common::ObjectPool<T, NUM_INTERNAL_CHUNKS> {
+public:
+	void *allocChunk() {
+		uint numPages = this->_pages.size();
+		void *ptr = Common::ObjectPool<T, NUM_INTERNAL_CHUNKS>::allocChunk();
+		s_datumAllocStats.poolPages += this->_pages.size() - numPages;
+		return ptr;
+	}
+};
+
+static DatumPool<int, 1024> &refCountPool() {
+	static DatumPool<int, 1024> pool;
+	return pool;
+}
+
+static DatumPool<Common::String, 256> &stringPool() {
+	static DatumPool<Common::String, 256> pool;
+	return pool;
+}
+
+static DatumPool<CastMemberID, 64> &castPool() {
+	static DatumPool<CastMemberID, 64> pool;
+	return pool;
+}
+
+static DatumPool<FArray, 64> &farrPool() {
+	static DatumPool<FArray, 64> pool;
+	return pool;
+}
+
+static DatumPool<PArray, 64> &parrPool() {
+	static DatumPool<PArray, 64> pool;
+	return pool;
+}
+
+// Short strings are kept inside the String object itself
+static bool isStringInline(const Common::String &str) {
+	const char *data = str.c_str();
+	return data >= (const char *)&str && data < (const char *)(&str + 1);
+}
+
+int *newRefCount(int value) {
+	return new (refCountPool().allocChunk()) int(value);
+}
+
+void deleteRefCount(int *refCount) {
+	refCountPool().freeChunk(refCount);
+}
+
+Common::String *newDatumString(const Common::String &str) {
+	return new (stringPool().allocChunk()) Common::String(str);
+}
+
+Common::String *newDatumString(Common::String &&str) {
+	return new (stringPool().allocChunk()) Common::String(Common::move(str));
+}
+
+void deleteDatumString(Common::String *str) {
+	if (!isStringInline(*str))
+		s_datumAllocStats.heapPayloads++;
+	stringPool().deleteChunk(str);
+}
+
+CastMemberID *newDatumCast(const CastMemberID &cast) {
+	return new (castPool().allocChunk()) CastMemberID(cast);
+}
+
+void deleteDatumCast(CastMemberID *cast) {
+	castPool().deleteChunk(cast);
+}
+
+void *FArray::operator new(size_t size) {
+	assert(size == sizeof(FArray));
+	return farrPool().allocChunk();
+}
+
+void FArray::operator delete(void *ptr) {
+	farrPool().freeChunk(ptr);
+}
+
+void *PArray::operator new(size_t size) {
+	assert(size == sizeof(PArray));
+	return parrPool().allocChunk();
+}
+
+void PArray::operator delete(void *ptr) {
+	parrPool().freeChunk(ptr);
+}
+
+const DatumAllocStats &getDatumAllocStats() {
+	return s_datumAllocStats;
+}
+
 Symbol::Symbol() {
 	name = nullptr;
 	type = VOIDSYM;
 	u.s = nullptr;
-	refCount = new int;
-	*refCount = 1;
+	refCount = newRefCount(1);
 	nargs = 0;
 	maxArgs = 0;
 	targetType = kNoneObj;
@@ -124,7 +223,7 @@ void Symbol::reset() {
 			delete argNames;
 		if (varNames)
 			delete varNames;
-		delete refCount;
+		deleteRefCount(refCount);
 	}
 #endif
 }
@@ -179,6 +278,9 @@ Lingo::Lingo(DirectorEngine *vm) : _vm(vm) {
 	_floatPrecision = 4;
 	_floatPrecisionFormat = "%.4f";
 
+	_frameAllocs = _peakFrameAllocs = DatumAllocStats();
+	_allocsAtFrameStart = getDatumAllocStats();
+
 	//kTheEntities
 	_actorList.type = ARRAY;
 	_actorList.u.farr = new FArray;
@@ -579,10 +681,58 @@ Common::String Lingo::formatFunctionBody(Symbol &sym) {
 	return result;
 }
 
+bool Lingo::canExecuteFast() const {
+	// Level 4 is the lowest level any of the tracing in execute() uses
+	return !debugChannelSet(4, kDebugLingoExec) && !debugChannelSet(-1, kDebugFewFramesOnly) &&
+		!g_debugger->needsStepHook();
+}
+
+bool Lingo::processExecuteEvents() {
+	_vm->processEvents();
+	// Also process update widgets!
+	Movie *movie = g_director->getCurrentMovie();
+	Score *score = movie->getScore();
+	score->updateWidgets(true);
+
+	g_system->updateScreen();
+	if (_vm->getCurrentMovie()->getScore()->_playState == kPlayStopped) {
+		_freezeState = true;
+		return false;
+	}
+	return true;
+}
+
 void Lingo::execute() {
 	uint localCounter = 0;
+	uint32 lastEventsTime = g_system->getMillis();
+	bool fast = canExecuteFast();
 
 	while (!_abort && !_freezeState && _state->script && (*_state->script)[_state->pc] != STOP) {
+		if (fast) {
+			// Nothing is traced and no breakpoints are set, so just run the instructions.
+			// Events are processed every so many milliseconds, checking the time every
+			// few instructions, as the instructions themselves may take long.
+			localCounter++;
+			if (localCounter % kLingoTimeCheckInstructions == 0 &&
+					g_system->getMillis() - lastEventsTime >= kLingoEventsInterval) {
+				if (!processExecuteEvents())
+					break;
+				lastEventsTime = g_system->getMillis();
+				// Tracing or breakpoints could have been enabled in the debugger
+				fast = canExecuteFast();
+			}
+
+			_state->pc++;
+			(*((*_state->script)[_state->pc - 1]))();
+			_globalCounter++;
+
+			if (!_abort && _state->pc >= (*_state->script).size()) {
+				warning("Lingo::execute(): Bad PC (%d)", _state->pc);
+				break;
+			}
+			continue;
+		}
+
 		if (_globalCounter > 1000 && debugChannelSet(-1, kDebugFewFramesOnly)) {
 			warning("Lingo::execute(): Stopping due to debug few frames only");
 			_vm->getCurrentMovie()->getScore()->_playState = kPlayStopped;
@@ -591,17 +741,9 @@ void Lingo::execute() {
 
 		// process events every so often
 		if (localCounter > 0 && localCounter % 100 == 0) {
-			_vm->processEvents();
-			// Also process update widgets!
-			Movie *movie = g_director->getCurrentMovie();
-			Score *score = movie->getScore();
-			score->updateWidgets(true);
-
-			g_system->updateScreen();
-			if (_vm->getCurrentMovie()->getScore()->_playState == kPlayStopped) {
-				_freezeState = true;
+			if (!processExecuteEvents())
 				break;
-			}
+			lastEventsTime = g_system->getMillis();
 		}
 
 		uint current = _state->pc;
@@ -641,6 +783,8 @@ void Lingo::execute() {
 			warning("Lingo::execute(): Bad PC (%d)", _state->pc);
 			break;
 		}
+
+		fast = canExecuteFast();
 	}
 
 	if (_freezeState) {
@@ -809,8 +953,7 @@ int Lingo::getAlignedType(const Datum &d1, const Datum &d2, bool equality) {
 Datum::Datum() {
 	u.s = nullptr;
 	type = VOID;
-	refCount = new int;
-	*refCount = 1;
+	refCount = newRefCount(1);
 	ignoreGlobal = false;
 }
 
@@ -837,24 +980,21 @@ Datum& Datum::operator=(const Datum &d) {
 Datum::Datum(int val) {
 	u.i = val;
 	type = INT;
-	refCount = new int;
-	*refCount = 1;
+	refCount = newRefCount(1);
 	ignoreGlobal = false;
 }
 
 Datum::Datum(double val) {
 	u.f = val;
 	type = FLOAT;
-	refCount = new int;
-	*refCount = 1;
+	refCount = newRefCount(1);
 	ignoreGlobal = false;
 }
 
 Datum::Datum(const Common::String &val) {
-	u.s = new Common::String(val);
+	u.s = newDatumString(val);
 	type = STRING;
-	refCount = new int;
-	*refCount = 1;
+	refCount = newRefCount(1);
 	ignoreGlobal = false;
 }
 
@@ -866,17 +1006,15 @@ Datum::Datum(AbstractObject *val) {
 		*refCount += 1;
 	} else {
 		type = VOID;
-		refCount = new int;
-		*refCount = 1;
+		refCount = newRefCount(1);
 	}
 	ignoreGlobal = false;
 }
 
 Datum::Datum(const CastMemberID &val) {
-	u.cast = new CastMemberID(val);
+	u.cast = newDatumCast(val);
 	type = CASTREF;
-	refCount = new int;
-	*refCount = 1;
+	refCount = newRefCount(1);
 	ignoreGlobal = false;
 }
 
@@ -887,8 +1025,7 @@ Datum::Datum(const Common::Rect &rect) {
 	u.farr->arr.push_back(Datum(rect.top));
 	u.farr->arr.push_back(Datum(rect.right));
 	u.farr->arr.push_back(Datum(rect.bottom));
-	refCount = new int;
-	*refCount = 1;
+	refCount = newRefCount(1);
 	ignoreGlobal = false;
 }
 
@@ -908,21 +1045,26 @@ void Datum::reset() {
 		case FLOAT:
 		case ARGC:
 		case ARGCNORET:
-			break;
+			deleteRefCount(refCount);
+			return;
 		case VARREF:
 		case GLOBALREF:
 		case LOCALREF:
 		case PROPREF:
 		case STRING:
 		case SYMBOL:
-			delete u.s;
+			deleteDatumString(u.s);
 			break;
 		case ARRAY:
 		case POINT:
 		case RECT:
+			if (!u.farr->arr.empty())
+				s_datumAllocStats.heapPayloads++;
 			delete u.farr;
 			break;
 		case PARRAY:
+			if (!u.parr->arr.empty())
+				s_datumAllocStats.heapPayloads++;
 			delete u.parr;
 			break;
 		case OBJECT:
@@ -934,27 +1076,31 @@ void Datum::reset() {
 				// *refCount is copied between the Datum and the Object,
 				// so should be safe to delete the Object
 				delete u.obj;
+				s_datumAllocStats.heapPayloads++;
 			}
 			break;
 		case CHUNKREF:
 			delete u.cref;
+			s_datumAllocStats.heapPayloads++;
 			break;
 		case CASTREF:
 		case FIELDREF:
-			delete u.cast;
+			deleteDatumCast(u.cast);
 			break;
 		case MENUREF:
 			delete u.menu;
+			s_datumAllocStats.heapPayloads++;
 			break;
 		case PICTUREREF:
 			delete u.picture;
+			s_datumAllocStats.heapPayloads++;
 			break;
 		default:
 			warning("Datum::reset(): Unprocessed REF type %d", type);
 			break;
 		}
 		if (type != OBJECT) // object owns refCount
-			delete refCount;
+			deleteRefCount(refCount);
 	}
 #endif
 }
@@ -1434,6 +1580,15 @@ void Lingo::runTests() {
 	}
 }
 
+void Lingo::countFrameAllocs() {
+	const DatumAllocStats &stats = getDatumAllocStats();
+	_frameAllocs.poolPages = stats.poolPages - _allocsAtFrameStart.poolPages;
+	_frameAllocs.heapPayloads = stats.heapPayloads - _allocsAtFrameStart.heapPayloads;
+	_peakFrameAllocs.poolPages = MAX(_peakFrameAllocs.poolPages, _frameAllocs.poolPages);
+	_peakFrameAllocs.heapPayloads = MAX(_peakFrameAllocs.heapPayloads, _frameAllocs.heapPayloads);
+	_allocsAtFrameStart = stats;
+}
+
 void Lingo::executeImmediateScripts(Frame *frame) {
 	for (uint16 i = 0; i <= _vm->getCurrentMovie()->getScore()->_numChannelsDisplayed; i++) {
 		if (_vm->getCurrentMovie()->getScore()->_immediateActions.contains(frame->_sprites[i]->_scriptId.member)) {
@@ -51,6 +51,11 @@ class LingoCompiler;
 typedef void (*inst)(void);
 #define	STOP (inst)0
 #define ENTITY_INDEX(t,id) ((t) * 100000 + (id))
+
+enum {
+	kLingoEventsInterval = 10,        // ms between processing events while running Lingo
+	kLingoTimeCheckInstructions = 64  // instructions between checking the time
+};
 #define printWithArgList g_lingo->printSTUBWithArglist
 
 int calcStringAlignment(const char *s);
@@ -114,6 +119,9 @@ struct PArray {
 	PArray() : _sorted(false) {}
 
 	PArray(int size) : _sorted(false), arr(size) {}
+
+	static void *operator new(size_t size);
+	static void operator delete(void *ptr);
 };
 
 struct FArray {
@@ -123,9 +131,33 @@ struct FArray {
 	FArray() : _sorted(false) {}
 
 	FArray(int size) : _sorted(false), arr(size) {}
+
+	static void *operator new(size_t size);
+	static void operator delete(void *ptr);
 };
 
 
+/* Reference counters and the string, list and cast member payloads of
+ * Datum come from pools, so values moving over the Lingo stack only go
+ * through malloc when a pool grows or a payload does not fit: strings
+ * longer than the inline buffer of Common::String, list elements, and
+ * the remaining reference types.
+ */
+int *newRefCount(int value);
+void deleteRefCount(int *refCount);
+Common::String *newDatumString(const Common::String &str = Common::String());
+Common::String *newDatumString(Common::String &&str);
+void deleteDatumString(Common::String *str);
+CastMemberID *newDatumCast(const CastMemberID &cast);
+void deleteDatumCast(CastMemberID *cast);
+
+struct DatumAllocStats {
+	uint32 poolPages;		// pages the value pools allocated from the heap
+	uint32 heapPayloads;	// released payloads which kept data on the heap
+};
+
+const DatumAllocStats &getDatumAllocStats();
+
 struct Datum {	/* interpreter stack type */
 	DatumType type;
 
@@ -376,6 +408,8 @@ public:
 
 public:
 	void execute();
+	bool canExecuteFast() const;
+	bool processExecuteEvents();
 	void switchStateFromWindow();
 	void freezeState();
 	void pushContext(const Symbol funcSym, bool allowRetVal, Datum defaultRetVal, int paramCount);
@@ -524,7 +558,15 @@ public:
 
 	Datum _windowList;
 
+	// Datum allocations during the last frame, and the most seen in one frame
+	DatumAllocStats _frameAllocs;
+	DatumAllocStats _peakFrameAllocs;
+
+private:
+	DatumAllocStats _allocsAtFrameStart;
+
 public:
+	void countFrameAllocs();
 	void executeImmediateScripts(Frame *frame);
 	void executePerFrameHook(int frame, int subframe);
 
@@ -86,6 +86,9 @@ Score::Score(Movie *movie) {
 	_curFrameNumber = 0;
 	_framesStream = nullptr;
 	_currentFrame = nullptr;
+
+	_keyframeInterval = kKeyframeInterval;
+	_keyframesSize = 0;
 }
 
 Score::~Score() {
@@ -104,6 +107,8 @@ Score::~Score() {
 	if (_currentFrame) {
 		delete _currentFrame;
 	}
+
+	clearKeyframes();
 }
 
 void Score::setPuppetTempo(int16 puppetTempo) {
@@ -155,26 +160,25 @@ uint16 Score::getLabel(Common::String &label) {
 	return 0;
 }
 
-Common::String *Score::getLabelList() {
-	Common::String *res = new Common::String;
+Common::String Score::getLabelList() {
+	Common::String res;
 
 	for (auto &i : *_labels) {
-		*res += i->name;
-		*res += '\n';
+		res += i->name;
+		res += '\n';
 	}
 
 	return res;
 }
 
-Common::String *Score::getFrameLabel(uint id) {
+Common::String Score::getFrameLabel(uint id) {
 	for (auto &i : *_labels) {
 		if (i->number == id) {
-			return new Common::String(i->name);
-			break;
+			return i->name;
 		}
 	}
 
-	return new Common::String;
+	return Common::String();
 }
 
 void Score::setStartToLabel(Common::String &label) {
@@ -300,6 +304,7 @@ void Score::step() {
 	}
 
 	update();
+	_lingo->countFrameAllocs();
 
 	if (debugChannelSet(-1, kDebugFewFramesOnly) || debugChannelSet(-1, kDebugScreenshot)) {
 		warning("Score::startLoop(): ran frame %0d", g_director->_framesRan);
@@ -1444,6 +1449,7 @@ void Score::loadFrames(Common::SeekableReadStreamEndian &stream, uint16 version)
 	// Prepare frameOffsets
 	_version = version;
 	_firstFramePosition = _framesStream->pos();
+	clearKeyframes();
 
 	// Pre-computing number of frames, as sometimes the frameNumber in stream mismatches
 	debugC(1, kDebugLoading, "Score::loadFrames(): Precomputing total number of frames!");
@@ -1468,20 +1474,41 @@ bool Score::loadFrame(int frameNum, bool loadCast) {
 	int sourceFrame = _curFrameNumber;
 	int targetFrame = frameNum;
 
+	// Frame states are only saved while rebuilding them from the score data,
+	// because the current frame may have been changed since it was loaded
+	bool rebuilding = false;
+
 	if (frameNum <= (int)_curFrameNumber) {
-		debugC(7, kDebugLoading, "****** Resetting frame %d to start %ld", sourceFrame, _framesStream->pos());
-		// If we are going back, we need to rebuild frames from start
-		_currentFrame->reset();
-		sourceFrame = 0;
+		// If we are going back, we need to rebuild frames from the closest saved state,
+		// or from start if there's none
+		rebuilding = true;
+		_seekStats.seeks++;
+
+		const Keyframe *keyframe = findKeyframe(targetFrame);
+		if (keyframe) {
+			debugC(7, kDebugLoading, "****** Restoring frame %d from keyframe %d", sourceFrame, keyframe->frameNum);
+			restoreKeyframe(*keyframe);
+			sourceFrame = keyframe->frameNum;
+			_seekStats.keyframeHits++;
+		} else {
+			debugC(7, kDebugLoading, "****** Resetting frame %d to start %ld", sourceFrame, _framesStream->pos());
+			_currentFrame->reset();
+			sourceFrame = 0;
 
-		// Reset position to start
-		_framesStream->seek(_firstFramePosition);
+			// Reset position to start
+			_framesStream->seek(_firstFramePosition);
+		}
 	}
 
 	debugC(7, kDebugLoading, "****** Source frame %d to Destination frame %d, current offset %ld", sourceFrame, targetFrame, _framesStream->pos());
 
 	while (sourceFrame < targetFrame - 1 && readOneFrame()) {
 		sourceFrame++;
+		if (rebuilding) {
+			_seekStats.framesDecoded++;
+			if (sourceFrame % _keyframeInterval == 0)
+				addKeyframe(sourceFrame);
+		}
 	}
 
 	// Finally read the target frame!
@@ -1492,6 +1519,12 @@ bool Score::loadFrame(int frameNum, bool loadCast) {
 	// We have read the frame, now update current frame number
 	_curFrameNumber = targetFrame;
 
+	if (rebuilding) {
+		_seekStats.framesDecoded++;
+		// Saved before the cast members are assigned, to match the state of a rebuilt frame
+		saveKeyframe(_lastDecodedFrame, targetFrame);
+	}
+
 	if (loadCast) {
 		// Load frame cast
 		setSpriteCasts();
@@ -1500,6 +1533,91 @@ bool Score::loadFrame(int frameNum, bool loadCast) {
 	return true;
 }
 
+void Score::clearKeyframes() {
+	for (uint i = 0; i < _keyframes.size(); i++)
+		delete _keyframes[i].frame;
+	_keyframes.clear();
+	delete _lastDecodedFrame.frame;
+	_lastDecodedFrame = Keyframe();
+	_keyframeInterval = kKeyframeInterval;
+	_keyframesSize = 0;
+}
+
+const Keyframe *Score::findKeyframe(uint32 frameNum) const {
+	const Keyframe *result = nullptr;
+
+	// Last saved keyframe before the requested frame
+	uint lo = 0, hi = _keyframes.size();
+	while (lo < hi) {
+		uint mid = (lo + hi) / 2;
+		if (_keyframes[mid].frameNum < frameNum)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	if (lo > 0)
+		result = &_keyframes[lo - 1];
+
+	// Sequential playback is served by the last loaded frame
+	if (_lastDecodedFrame.frame && _lastDecodedFrame.frameNum < frameNum &&
+			(!result || _lastDecodedFrame.frameNum > result->frameNum))
+		result = &_lastDecodedFrame;
+
+	return result;
+}
+
+void Score::restoreKeyframe(const Keyframe &keyframe) {
+	_currentFrame->_mainChannels = keyframe.frame->_mainChannels;
+	for (uint i = 0; i < _currentFrame->_sprites.size() && i < keyframe.frame->_sprites.size(); i++) {
+		*_currentFrame->_sprites[i] = *keyframe.frame->_sprites[i];
+		_currentFrame->_sprites[i]->_frame = _currentFrame;
+	}
+	_framesStream->seek(keyframe.streamPos);
+}
+
+void Score::saveKeyframe(Keyframe &keyframe, uint32 frameNum) {
+	if (keyframe.frame && keyframe.frame->_sprites.size() == _currentFrame->_sprites.size()) {
+		keyframe.frame->_mainChannels = _currentFrame->_mainChannels;
+		for (uint i = 0; i < _currentFrame->_sprites.size(); i++)
+			*keyframe.frame->_sprites[i] = *_currentFrame->_sprites[i];
+	} else {
+		delete keyframe.frame;
+		keyframe.frame = new Frame(*_currentFrame);
+		keyframe.frame->_mainChannels = _currentFrame->_mainChannels;
+	}
+	keyframe.frameNum = frameNum;
+	keyframe.streamPos = _framesStream->pos();
+}
+
+void Score::addKeyframe(uint32 frameNum) {
+	uint pos = 0;
+	while (pos < _keyframes.size() && _keyframes[pos].frameNum < frameNum)
+		pos++;
+	if (pos < _keyframes.size() && _keyframes[pos].frameNum == frameNum)
+		return; // already saved
+
+	Keyframe keyframe;
+	saveKeyframe(keyframe, frameNum);
+	_keyframes.insert_at(pos, keyframe);
+	_keyframesSize += sizeof(Frame) + keyframe.frame->_sprites.size() * sizeof(Sprite);
+
+	// When out of memory budget, drop every other keyframe and save them less often
+	if (_keyframesSize > kKeyframeMemoryLimit) {
+		_keyframeInterval *= 2;
+		uint kept = 0;
+		for (uint i = 0; i < _keyframes.size(); i++) {
+			if (_keyframes[i].frameNum % _keyframeInterval == 0) {
+				_keyframes[kept++] = _keyframes[i];
+			} else {
+				_keyframesSize -= sizeof(Frame) + _keyframes[i].frame->_sprites.size() * sizeof(Sprite);
+				delete _keyframes[i].frame;
+			}
+		}
+		_keyframes.resize(kept);
+		debugC(5, kDebugLoading, "Score::addKeyframe(): Keyframe interval is now %d, %d keyframes kept", _keyframeInterval, kept);
+	}
+}
+
 bool Score::readOneFrame() {
 	uint16 channelSize;
 	uint16 channelOffset;
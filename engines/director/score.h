@@ -58,6 +58,28 @@ enum RenderMode {
 	kRenderForceUpdate
 };
 
+enum {
+	kKeyframeInterval = 16,                  // initial number of frames between saved states
+	kKeyframeMemoryLimit = 8 * 1024 * 1024   // memory the saved states may take, in bytes
+};
+
+// Decoded frame state saved for seeking within the score
+struct Keyframe {
+	uint32 frameNum;
+	uint32 streamPos; // position of the following frame
+	Frame *frame;
+
+	Keyframe() : frameNum(0), streamPos(0), frame(nullptr) {}
+};
+
+struct FrameSeekStats {
+	uint32 seeks;         // frame loads which had to rebuild the channel state
+	uint32 framesDecoded; // frames read while rebuilding
+	uint32 keyframeHits;  // rebuilds which started from a saved state
+
+	FrameSeekStats() : seeks(0), framesDecoded(0), keyframeHits(0) {}
+};
+
 struct Label {
 	Common::String comment;
 	Common::String name;
@@ -75,6 +97,11 @@ public:
 	void loadFrames(Common::SeekableReadStreamEndian &stream, uint16 version);
 	bool loadFrame(int frame, bool loadCast);
 	bool readOneFrame();
+	void clearKeyframes();
+	uint getKeyframeCount() const { return _keyframes.size(); }
+	uint32 getKeyframesSize() const { return _keyframesSize; }
+	uint getKeyframeInterval() const { return _keyframeInterval; }
+	const FrameSeekStats &getSeekStats() const { return _seekStats; }
 	void updateFrame(Frame *frame);
 	Frame *getFrameData(int frameNum);
 
@@ -84,8 +111,8 @@ public:
 
 	static int compareLabels(const void *a, const void *b);
 	uint16 getLabel(Common::String &label);
-	Common::String *getLabelList();
-	Common::String *getFrameLabel(uint id);
+	Common::String getLabelList();
+	Common::String getFrameLabel(uint id);
 	void setStartToLabel(Common::String &label);
 	void gotoLoop();
 	void gotoNext();
@@ -198,6 +225,19 @@ private:
 	DirectorSound *_soundManager;
 
 	int _previousBuildBotBuild = -1;
+
+	// Decoded states of every _keyframeInterval'th frame, sorted by frame number
+	Common::Array<Keyframe> _keyframes;
+	// Decoded state of the most recently loaded frame
+	Keyframe _lastDecodedFrame;
+	uint _keyframeInterval;
+	uint32 _keyframesSize;
+	FrameSeekStats _seekStats;
+
+	const Keyframe *findKeyframe(uint32 frameNum) const;
+	void restoreKeyframe(const Keyframe &keyframe);
+	void saveKeyframe(Keyframe &keyframe, uint32 frameNum);
+	void addKeyframe(uint32 frameNum);
 };
 
 } // End of namespace Director
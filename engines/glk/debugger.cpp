@@ -22,7 +22,10 @@
 #include "glk/debugger.h"
 #include "glk/glk.h"
 #include "glk/raw_decoder.h"
+#include "glk/window_text_buffer.h"
+#include "glk/windows.h"
 #include "common/file.h"
+#include "common/system.h"
 #include "graphics/managed_surface.h"
 #include "image/png.h"
 
@@ -30,6 +33,7 @@ namespace Glk {
 
 Debugger::Debugger() : GUI::Debugger() {
 	registerCmd("dumppic", WRAP_METHOD(Debugger, cmdDumpPic));
+	registerCmd("textbench", WRAP_METHOD(Debugger, cmdTextBench));
 }
 
 int Debugger::strToInt(const char *s) {
@@ -99,6 +103,65 @@ bool Debugger::cmdDumpPic(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmdTextBench(int argc, const char **argv) {
+	static const char *const TEXT = "You are standing in an open field west of a white house, "
+		"with a boarded front door. There is a small mailbox here. ";
+	int turns = (argc >= 2) ? strToInt(argv[1]) : 200;
+	int paragraphs = (argc >= 3) ? strToInt(argv[2]) : 10;
+	TextBufferWindow *win = nullptr;
+
+	for (Windows::iterator it = g_vm->_windows->begin(); it != g_vm->_windows->end(); ++it) {
+		if ((*it)->_type == wintype_TextBuffer) {
+			win = static_cast<TextBufferWindow *>(*it);
+			break;
+		}
+	}
+
+	if (argc > 3 || turns <= 0 || paragraphs <= 0) {
+		debugPrintf("Format: textbench [turns] [paragraphs per turn]\n");
+		return true;
+	} else if (!win) {
+		debugPrintf("There is no text buffer window\n");
+		return true;
+	}
+
+	// Report the first and last tenth of the turns, to show how the time grows with the transcript
+	int sample = MAX(turns / 10, 1);
+	uint32 firstLayout = 0, firstDraw = 0, lastLayout = 0, lastDraw = 0, maxTurn = 0;
+
+	for (int turn = 0; turn < turns; turn++) {
+		uint32 start = g_system->getMillis();
+		for (int line = 0; line < paragraphs; line++) {
+			for (const char *p = TEXT; *p; p++)
+				win->putCharUni((byte)*p);
+			win->putCharUni('\n');
+		}
+
+		uint32 middle = g_system->getMillis();
+		g_vm->_windows->redraw();
+		uint32 end = g_system->getMillis();
+
+		if (turn < sample) {
+			firstLayout += middle - start;
+			firstDraw += end - middle;
+		}
+		if (turn >= turns - sample) {
+			lastLayout += middle - start;
+			lastDraw += end - middle;
+		}
+		maxTurn = MAX(maxTurn, end - start);
+	}
+
+	debugPrintf("%d turns of %d paragraphs, average milliseconds per turn:\n", turns, paragraphs);
+	debugPrintf("first %d turns: layout %.2f, draw %.2f\n", sample,
+		(double)firstLayout / sample, (double)firstDraw / sample);
+	debugPrintf("last %d turns: layout %.2f, draw %.2f\n", sample,
+		(double)lastLayout / sample, (double)lastDraw / sample);
+	debugPrintf("slowest turn: %u\n", maxTurn);
+
+	return true;
+}
+
 void Debugger::saveRawPicture(const RawDecoder &rd, Common::WriteStream &ws) {
 #ifdef USE_PNG
 	const Graphics::Surface *surface = rd.getSurface();
@@ -42,6 +42,12 @@ private:
 	 * Dump a picture
 	 */
 	bool cmdDumpPic(int argc, const char **argv);
+
+	/**
+	 * Appends a long transcript to a text buffer window, and reports how long each turn
+	 * took to lay out and draw
+	 */
+	bool cmdTextBench(int argc, const char **argv);
 protected:
 	/**
 	 * Convert a numeric string to an integer
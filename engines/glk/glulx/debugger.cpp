@@ -0,0 +1,119 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "glk/glulx/debugger.h"
+#include "glk/glulx/glulx.h"
+#include "common/algorithm.h"
+
+namespace Glk {
+namespace Glulx {
+
+struct ProfileEntry {
+	uint _key;
+	uint _count;
+
+	ProfileEntry(uint key, uint count) : _key(key), _count(count) {}
+
+	bool operator<(const ProfileEntry &other) const {
+		return _count > other._count || (_count == other._count && _key < other._key);
+	}
+};
+
+Debugger::Debugger() : Glk::Debugger() {
+	registerCmd("profile", WRAP_METHOD(Debugger, cmdProfile));
+	registerCmd("opcodes", WRAP_METHOD(Debugger, cmdOpcodes));
+	registerCmd("functions", WRAP_METHOD(Debugger, cmdFunctions));
+	registerCmd("undo", WRAP_METHOD(Debugger, cmdUndo));
+	registerCmd("strings", WRAP_METHOD(Debugger, cmdStrings));
+}
+
+bool Debugger::cmdProfile(int argc, const char **argv) {
+	if (argc == 2 && !strcmp(argv[1], "on")) {
+		g_vm->opcode_profiling = true;
+	} else if (argc == 2 && !strcmp(argv[1], "off")) {
+		g_vm->opcode_profiling = false;
+	} else if (argc == 2 && !strcmp(argv[1], "reset")) {
+		memset(g_vm->opcode_counts, 0, sizeof(g_vm->opcode_counts));
+		g_vm->func_counts.clear();
+	} else if (argc != 1) {
+		debugPrintf("Format: profile [on | off | reset]\n");
+		return true;
+	}
+
+	debugPrintf("Profiling is %s, %u instructions decoded\n",
+		g_vm->opcode_profiling ? "on" : "off", g_vm->decode_count);
+	return true;
+}
+
+bool Debugger::cmdOpcodes(int argc, const char **argv) {
+	int limit = (argc == 2) ? strToInt(argv[1]) : 20;
+	Common::Array<ProfileEntry> entries;
+	uint64 total = 0;
+
+	for (uint ix = 0; ix < ARRAYSIZE(g_vm->opcode_counts); ix++) {
+		if (g_vm->opcode_counts[ix]) {
+			entries.push_back(ProfileEntry(ix, g_vm->opcode_counts[ix]));
+			total += g_vm->opcode_counts[ix];
+		}
+	}
+	Common::sort(entries.begin(), entries.end());
+
+	for (uint ix = 0; ix < entries.size() && (int)ix < limit; ix++)
+		debugPrintf("%03xh  %10u  %5.1f%%\n", entries[ix]._key, entries[ix]._count,
+			100.0 * entries[ix]._count / total);
+	debugPrintf("%u distinct opcodes, %llu instructions\n", entries.size(), (unsigned long long)total);
+	return true;
+}
+
+bool Debugger::cmdFunctions(int argc, const char **argv) {
+	int limit = (argc == 2) ? strToInt(argv[1]) : 20;
+	Common::Array<ProfileEntry> entries;
+
+	for (Common::HashMap<uint, uint>::const_iterator it = g_vm->func_counts.begin();
+			it != g_vm->func_counts.end(); ++it)
+		entries.push_back(ProfileEntry(it->_key, it->_value));
+	Common::sort(entries.begin(), entries.end());
+
+	for (uint ix = 0; ix < entries.size() && (int)ix < limit; ix++)
+		debugPrintf("%08xh  %10u%s\n", entries[ix]._key, entries[ix]._count,
+			g_vm->accel_get_func(entries[ix]._key) ? "  (accelerated)" : "");
+	debugPrintf("%u distinct functions\n", entries.size());
+	return true;
+}
+
+bool Debugger::cmdUndo(int argc, const char **argv) {
+	debugPrintf("%d undo states of %d, %u bytes of %u\n", g_vm->undo_chain_num, g_vm->undo_chain_size,
+		g_vm->undo_chain_bytes, g_vm->undo_chain_budget);
+	debugPrintf("saveundo: %u calls, %u ms\n", g_vm->undo_save_count, g_vm->undo_save_time);
+	debugPrintf("restoreundo: %u calls, %u ms\n", g_vm->undo_restore_count, g_vm->undo_restore_time);
+	return true;
+}
+
+bool Debugger::cmdStrings(int argc, const char **argv) {
+	debugPrintf("%u strings cached, %u characters\n", g_vm->stringcache.size(), g_vm->stringcache_chars);
+	debugPrintf("cached: %u strings, %u characters\n", g_vm->stringcache_hits, g_vm->stringcache_hitchars);
+	debugPrintf("decoded: %u strings, %u characters\n", g_vm->stringcache_misses, g_vm->stringcache_misschars);
+	return true;
+}
+
+} // End of namespace Glulx
+} // End of namespace Glk
@@ -29,6 +29,7 @@ void Glulx::execute_loop() {
 	int ix;
 	uint opcode;
 	const operandlist_t *oplist;
+	const decodedinst_t *dec;
 	oparg_t inst[MAX_OPERANDS];
 	uint value, addr, val0, val1;
 	int vals0, vals1;
@@ -48,6 +49,22 @@ void Glulx::execute_loop() {
 		/* Stash the current opcode's address, in case the interpreter needs to serialize the VM state out-of-band. */
 		prevpc = pc;
 
+		/* Instructions in ROM never change, so their opcode and operand
+		   modes only need to be parsed once. */
+		dec = nullptr;
+		if (pc < ramstart && decodecache) {
+			dec = &decodecache[pc & (DECODE_CACHE_SIZE - 1)];
+			if (dec->addr != pc)
+				dec = decode_instruction(pc);
+		}
+
+		if (dec) {
+			opcode = dec->opcode;
+			pc = dec->nextpc;
+			load_decoded_operands(inst, dec);
+			goto Execute;
+		}
+
 		/* Fetch the opcode number. */
 		opcode = Mem1(pc);
 		pc++;
@@ -87,6 +104,10 @@ void Glulx::execute_loop() {
 		   into inst. This moves the PC up to the end of the instruction. */
 		parse_operands(inst, oplist);
 
+Execute:
+		if (opcode_profiling)
+			opcode_counts[MIN<uint>(opcode, ARRAYSIZE(opcode_counts) - 1)]++;
+
 		/* Perform the opcode. This switch statement is split in two, based
 		   on some paranoid suspicions about the ability of compilers to
 		   optimize large-range switches. Ignore that. */
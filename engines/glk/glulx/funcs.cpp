@@ -33,6 +33,9 @@ void Glulx::enter_function(uint funcaddr, uint argc, uint *argv) {
 	int loctype, locnum;
 	uint addr = funcaddr;
 
+	if (opcode_profiling)
+		func_counts[funcaddr]++;
+
 	accelFunc = accel_get_func(addr);
 	if (accelFunc) {
 		profile_in(addr, stackptr, true);
@@ -20,6 +20,7 @@
  */
 
 #include "glk/glulx/glulx.h"
+#include "glk/glulx/debugger.h"
 #include "common/config-manager.h"
 #include "common/translation.h"
 
@@ -42,15 +43,26 @@ Glulx::Glulx(OSystem *syst, const GlkGameDescription &gameDesc) : GlkAPI(syst, g
 		accelentries(nullptr),
 		// heap
 		heap_start(0), alloc_count(0), heap_head(nullptr), heap_tail(nullptr),
+		// operand
+		decodecache(nullptr), opcode_profiling(false), decode_count(0),
 		// serial
-		max_undo_level(8), undo_chain_size(0), undo_chain_num(0), undo_chain(nullptr), ramcache(nullptr),
+		max_undo_level(32), undo_chain_size(0), undo_chain_num(0), undo_chain(nullptr),
+		undo_chain_bytes(0), undo_chain_budget(0), undo_ram(nullptr), undo_ram_len(0), undo_ram_size(0),
+		undo_save_count(0), undo_save_time(0), undo_restore_count(0), undo_restore_time(0), ramcache(nullptr),
 		// string
-		iosys_mode(0), iosys_rock(0), tablecache_valid(false), glkio_unichar_han_ptr(nullptr) {
+		iosys_mode(0), iosys_rock(0), tablecache_valid(false), stringcache_head(nullptr),
+		stringcache_tail(nullptr), stringcache_chars(0), stringcache_hits(0), stringcache_misses(0),
+		stringcache_hitchars(0), stringcache_misschars(0), glkio_unichar_han_ptr(nullptr) {
 	g_vm = this;
+	memset(opcode_counts, 0, sizeof(opcode_counts));
 
 	glkopInit();
 }
 
+void Glulx::createDebugger() {
+	setDebugger(new Debugger());
+}
+
 void Glulx::runGame() {
 	if (!is_gamefile_valid())
 		return;
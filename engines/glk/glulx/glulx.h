@@ -25,6 +25,8 @@
 #define GLK_GLULXE
 
 #include "common/scummsys.h"
+#include "common/array.h"
+#include "common/hashmap.h"
 #include "common/random.h"
 #include "glk/glk_api.h"
 #include "glk/glulx/glulx_types.h"
@@ -33,6 +35,7 @@ namespace Glk {
 namespace Glulx {
 
 class Glulx;
+class Debugger;
 typedef void (Glulx::*CharHandler)(unsigned char);
 typedef void (Glulx::*UnicharHandler)(uint32);
 
@@ -40,6 +43,7 @@ typedef void (Glulx::*UnicharHandler)(uint32);
  * Glulx game interpreter
  */
 class Glulx : public GlkAPI {
+	friend class Debugger;
 private:
 	/**
 	 * \defgroup vm fields
@@ -145,6 +149,24 @@ private:
 	 */
 	const operandlist_t *fast_operandlist[0x80];
 
+	/**
+	 * Direct-mapped cache of decoded ROM instructions, indexed by instruction address. Allocated
+	 * along with main memory, so that execute_loop() only has to parse each instruction once.
+	 */
+	decodedinst_t *decodecache;
+
+	/**@}*/
+
+	/**
+	 * \defgroup opcode profiler fields
+	 * @{
+	 */
+
+	bool opcode_profiling;          ///< whether the counts below are being gathered
+	uint opcode_counts[0x200];      ///< executions per opcode; opcodes above 0x1FF share the last slot
+	uint decode_count;              ///< number of instructions decoded into decodecache
+	Common::HashMap<uint, uint> func_counts;  ///< calls per function address
+
 	/**@}*/
 
 	/**
@@ -160,6 +182,20 @@ private:
 	int undo_chain_size;
 	int undo_chain_num;
 	byte **undo_chain;
+	uint undo_chain_bytes;      ///< total size of the undo chain entries
+	uint undo_chain_budget;     ///< older undo states are dropped to keep within this size
+
+	/**
+	 * Copy of RAM (from ramstart) as it was in the newest undo state. Each undo chain entry stores the
+	 * difference between its RAM and that of the state before it, so restoring only has to copy this back
+	 * and then roll it back by one entry. Bytes past undo_ram_len are always zero.
+	 */
+	byte *undo_ram;
+	uint undo_ram_len;          ///< endmem of the newest undo state
+	uint undo_ram_size;         ///< allocated size of undo_ram
+
+	uint undo_save_count, undo_save_time;         ///< number and total milliseconds of saveundos
+	uint undo_restore_count, undo_restore_time;   ///< number and total milliseconds of restoreundos
 
 	/**
 	 * This will contain a copy of RAM (ramstate to endmem) as it exists in the game file.
@@ -182,6 +218,16 @@ private:
 	bool tablecache_valid;
 	cacheblock_t tablecache;
 
+	/**
+	 * Decoded compressed strings, looked up by address. This is only used while the decoding table
+	 * is cached, that is, when both the table and the strings are in ROM and so can't change.
+	 */
+	Common::HashMap<uint, stringcache_t *> stringcache;
+	stringcache_t *stringcache_head, *stringcache_tail;
+	uint stringcache_chars;
+	uint stringcache_hits, stringcache_misses;
+	uint stringcache_hitchars, stringcache_misschars;
+
 	/* This misbehaves if a Glk function has more than one S argument. */
 #define STATIC_TEMP_BUFSIZE (127)
 	char temp_buf[STATIC_TEMP_BUFSIZE + 1];
@@ -403,6 +449,11 @@ public:
 	 */
 	void runGame() override;
 
+	/**
+	 * Create the debugger
+	 */
+	void createDebugger() override;
+
 	/**
 	 * Returns the running interpreter type
 	 */
@@ -551,6 +602,20 @@ public:
 	*/
 	void parse_operands(oparg_t *opargs, const operandlist_t *oplist);
 
+	/**
+	 * Decode the instruction at addr, which must lie in ROM, into the decoded instruction cache
+	 * and return the cache entry. Constant operands, addresses and store destinations are parsed
+	 * once here, rather than every time the instruction is executed.
+	 */
+	const decodedinst_t *decode_instruction(uint addr);
+
+	/**
+	 * Equivalent of parse_operands() for an instruction that has been through decode_instruction().
+	 * This only does the work that depends on the current machine state: stack pops and reads
+	 * of memory and locals.
+	 */
+	void load_decoded_operands(oparg_t *opargs, const decodedinst_t *dec);
+
 	/**
 	 * Store a result value, according to the desttype and destaddress given. This is usually used to store
 	 * the result of an opcode, but it's also used by any code that pulls a call-stub off the stack.
@@ -953,6 +1018,28 @@ public:
 	 */
 	uint perform_restoreundo();
 
+	/**
+	 * Write the difference between the current RAM and undo_ram, as a run-length encoded XOR
+	 * like the one write_memstate() uses. prevlen is the endmem of the state held in undo_ram.
+	 */
+	uint write_undo_memdelta(dest_t *dest, uint prevlen);
+
+	/**
+	 * Apply a difference written by write_undo_memdelta() to undo_ram, turning it back into the
+	 * state before it, whose endmem was prevlen.
+	 */
+	uint apply_undo_memdelta(dest_t *dest, uint chunklen, uint prevlen);
+
+	/**
+	 * Make sure undo_ram can hold RAM up to an endmem of len. Returns 0 on success, 1 on failure.
+	 */
+	uint grow_undo_ram(uint len);
+
+	/**
+	 * Free the oldest state in the undo chain
+	 */
+	void drop_oldest_undo();
+
 	uint perform_verify();
 
 	/**@}*/
@@ -983,6 +1070,27 @@ public:
 	 */
 	void stream_set_table(uint addr);
 
+	/**
+	 * Look up the compressed string at addr in the string cache, making it the most recently used.
+	 */
+	stringcache_t *stringcache_find(uint addr);
+
+	/**
+	 * Print a cached string to the current output stream.
+	 */
+	void stringcache_print(const stringcache_t *entry);
+
+	/**
+	 * Add the decoded characters of the compressed string at addr to the string cache, where bit 31
+	 * marks the 8-bit characters. A null chars marks a string which can't be cached.
+	 */
+	void stringcache_add(uint addr, const Common::Array<uint32> *chars, bool unicode);
+
+	/**
+	 * Empty the string cache.
+	 */
+	void stringcache_clear();
+
 	void stream_get_iosys(uint *mode, uint *rock);
 	void stream_set_iosys(uint mode, uint rock);
 	char *make_temp_string(uint addr);
@@ -70,6 +70,12 @@ class Glulx;
  */
 #define SERIALIZE_CACHE_RAM (1)
 
+/**
+ * Memory budget of the undo chain, as a number of copies of RAM. Undo states only store the bytes that
+ * changed since the previous state, so this normally holds many more than this number of undo levels.
+ */
+#define UNDO_MEMORY_LEVELS (8)
+
 /**
  * Some macros to read and write integers to memory, always in big-endian format.
  */
@@ -351,6 +357,34 @@ typedef oparg_struct oparg_t;
 
 #define MAX_OPERANDS (8)
 
+/**
+ * A decodedinst_t is an instruction whose opcode and operand modes have already been parsed. Only
+ * instructions in ROM are decoded this way, since that part of memory can never change while the game
+ * is running. Load operands keep a normalized mode in modes[] (one of the decodedmode values); store
+ * operands keep their final desttype, with values[] holding the constant, address or locals offset.
+ */
+struct decodedinst_struct {
+	uint addr;      ///< address of the instruction, or 0 for an empty slot
+	uint nextpc;    ///< address of the following instruction
+	uint opcode;
+	const operandlist_t *oplist;
+	byte modes[MAX_OPERANDS];
+	uint values[MAX_OPERANDS];
+};
+typedef decodedinst_struct decodedinst_t;
+
+enum decodedmode {
+	decodedmode_Constant = 0,
+	decodedmode_Stack = 1,
+	decodedmode_Memory = 2,
+	decodedmode_Locals = 3
+};
+
+/**
+ * Number of slots in the direct-mapped decoded instruction cache. Must be a power of two.
+ */
+#define DECODE_CACHE_SIZE (0x2000)
+
 typedef uint(Glulx::*acceleration_func)(uint argc, uint *argv);
 
 struct accelentry_struct {
@@ -401,12 +435,12 @@ enum iosys {
 	iosys_Glk    = 2
 };
 
-#define CACHEBITS (4)
+#define CACHEBITS (8)
 #define CACHESIZE (1 << CACHEBITS)
-#define CACHEMASK (15)
+#define CACHEMASK (CACHESIZE - 1)
 
 struct cacheblock_struct {
-	int depth; /* 1 to 4 */
+	int depth; /* 1 to CACHEBITS */
 	int type;
 	union {
 		struct cacheblock_struct *branches;
@@ -417,6 +451,27 @@ struct cacheblock_struct {
 };
 typedef cacheblock_struct cacheblock_t;
 
+/**
+ * A compressed string in ROM which has already been decoded for Glk output. Entries are kept in a
+ * doubly-linked list, most recently printed first, so that the least recently printed ones can be
+ * dropped when the cache grows too large. Entries with neither bytes nor uchars set are for strings that
+ * can't be cached, usually because they call functions, so that they aren't recorded again.
+ */
+struct stringcache_struct {
+	uint addr;
+	uint len;            ///< number of characters
+	char *bytes;         ///< the string, if it only has 8-bit characters
+	uint32 *uchars;      ///< otherwise, the string, with bit 31 set on the 8-bit characters
+	stringcache_struct *prev;
+	stringcache_struct *next;
+};
+typedef stringcache_struct stringcache_t;
+
+/**
+ * Maximum number of decoded characters held in the string cache.
+ */
+#define STRING_CACHE_CHARS (0x10000)
+
 } // End of namespace Glulx
 } // End of namespace Glk
 
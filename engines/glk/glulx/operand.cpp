@@ -516,6 +516,216 @@ WrLocalsAddr:
 	}
 }
 
+const decodedinst_t *Glulx::decode_instruction(uint addr) {
+	decodedinst_t *dec = &decodecache[addr & (DECODE_CACHE_SIZE - 1)];
+	const operandlist_t *oplist;
+	uint opcode, modeaddr, pos = addr;
+	int ix, numops;
+	int modeval = 0;
+
+	/* Fetch the opcode number, exactly as execute_loop() does. */
+	opcode = Mem1(pos);
+	pos++;
+	if (opcode & 0x80) {
+		if (opcode & 0x40) {
+			opcode &= 0x3F;
+			opcode = (opcode << 8) | Mem1(pos);
+			opcode = (opcode << 8) | Mem1(pos + 1);
+			opcode = (opcode << 8) | Mem1(pos + 2);
+			pos += 3;
+		} else {
+			opcode &= 0x7F;
+			opcode = (opcode << 8) | Mem1(pos);
+			pos++;
+		}
+	}
+
+	if (opcode < 0x80)
+		oplist = fast_operandlist[opcode];
+	else
+		oplist = lookup_operandlist(opcode);
+
+	if (!oplist)
+		fatal_error_i("Encountered unknown opcode.", opcode);
+
+	numops = oplist->num_ops;
+	modeaddr = pos;
+	pos += (numops + 1) / 2;
+
+	for (ix = 0; ix < numops; ix++) {
+		int mode;
+		uint value = 0;
+
+		if ((ix & 1) == 0) {
+			modeval = Mem1(modeaddr);
+			mode = (modeval & 0x0F);
+		} else {
+			mode = ((modeval >> 4) & 0x0F);
+			modeaddr++;
+		}
+
+		/* Fetch the constant or address that follows the mode bytes. */
+		switch (mode) {
+		case 1:
+		case 5:
+		case 9:
+		case 13:
+			value = (mode == 1) ? (uint)(int)(signed char)Mem1(pos) : (uint)Mem1(pos);
+			pos++;
+			break;
+		case 2:
+			value = (uint)(int)(signed char)Mem1(pos);
+			value = (value << 8) | (uint)Mem1(pos + 1);
+			pos += 2;
+			break;
+		case 6:
+		case 10:
+		case 14:
+			value = (uint)Mem2(pos);
+			pos += 2;
+			break;
+		case 3:
+		case 7:
+		case 11:
+		case 15:
+			value = Mem4(pos);
+			pos += 4;
+			break;
+		default:
+			break;
+		}
+		if (mode >= 13)
+			value += ramstart;
+
+		if (oplist->formlist[ix] == modeform_Load) {
+			switch (mode) {
+			case 0:
+			case 1:
+			case 2:
+			case 3:
+				dec->modes[ix] = decodedmode_Constant;
+				break;
+			case 8:
+				dec->modes[ix] = decodedmode_Stack;
+				break;
+			case 5:
+			case 6:
+			case 7:
+			case 13:
+			case 14:
+			case 15:
+				dec->modes[ix] = decodedmode_Memory;
+				break;
+			case 9:
+			case 10:
+			case 11:
+				dec->modes[ix] = decodedmode_Locals;
+				break;
+			default:
+				fatal_error("Unknown addressing mode in load operand.");
+			}
+		} else { /* modeform_Store */
+			/* The mode holds the desttype, which is the same every time. */
+			switch (mode) {
+			case 0:
+				dec->modes[ix] = 0;
+				break;
+			case 8:
+				dec->modes[ix] = 3;
+				break;
+			case 5:
+			case 6:
+			case 7:
+			case 13:
+			case 14:
+			case 15:
+				dec->modes[ix] = 1;
+				break;
+			case 9:
+			case 10:
+			case 11:
+				dec->modes[ix] = 2;
+				break;
+			case 1:
+			case 2:
+			case 3:
+				fatal_error("Constant addressing mode in store operand.");
+				break;
+			default:
+				fatal_error("Unknown addressing mode in store operand.");
+			}
+		}
+
+		dec->values[ix] = value;
+	}
+
+	/* An instruction which runs on into RAM could change under us, so it is
+	   parsed every time instead. */
+	if (pos > ramstart) {
+		dec->addr = 0;
+		return nullptr;
+	}
+
+	dec->addr = addr;
+	dec->nextpc = pos;
+	dec->opcode = opcode;
+	dec->oplist = oplist;
+	decode_count++;
+
+	return dec;
+}
+
+void Glulx::load_decoded_operands(oparg_t *args, const decodedinst_t *dec) {
+	int numops = dec->oplist->num_ops;
+	int argsize = dec->oplist->arg_size;
+
+	for (int ix = 0; ix < numops; ix++) {
+		uint addr = dec->values[ix];
+
+		if (dec->oplist->formlist[ix] != modeform_Load) {
+			args[ix].desttype = dec->modes[ix];
+			args[ix].value = addr;
+			continue;
+		}
+
+		args[ix].desttype = 0;
+		switch (dec->modes[ix]) {
+		case decodedmode_Constant:
+			args[ix].value = addr;
+			break;
+
+		case decodedmode_Stack:
+			if (stackptr < valstackbase + 4) {
+				fatal_error("Stack underflow in operand.");
+			}
+			stackptr -= 4;
+			args[ix].value = Stk4(stackptr);
+			break;
+
+		case decodedmode_Memory:
+			if (argsize == 4) {
+				args[ix].value = Mem4(addr);
+			} else if (argsize == 2) {
+				args[ix].value = Mem2(addr);
+			} else {
+				args[ix].value = Mem1(addr);
+			}
+			break;
+
+		default: /* decodedmode_Locals */
+			addr += localsbase;
+			if (argsize == 4) {
+				args[ix].value = Stk4(addr);
+			} else if (argsize == 2) {
+				args[ix].value = Stk2(addr);
+			} else {
+				args[ix].value = Stk1(addr);
+			}
+			break;
+		}
+	}
+}
+
 void Glulx::store_operand(uint desttype, uint destaddr, uint storeval) {
 	switch (desttype) {
 
@@ -29,6 +29,8 @@ namespace Glulx {
 bool Glulx::init_serial() {
 	undo_chain_num = 0;
 	undo_chain_size = max_undo_level;
+	undo_chain_bytes = 0;
+	undo_chain_budget = UNDO_MEMORY_LEVELS * (endmem - ramstart);
 	undo_chain = (unsigned char **)glulx_malloc(sizeof(unsigned char *) * undo_chain_size);
 	if (!undo_chain)
 		return false;
@@ -62,6 +64,14 @@ void Glulx::final_serial() {
 	undo_chain = nullptr;
 	undo_chain_size = 0;
 	undo_chain_num = 0;
+	undo_chain_bytes = 0;
+
+	if (undo_ram) {
+		glulx_free(undo_ram);
+		undo_ram = nullptr;
+	}
+	undo_ram_len = 0;
+	undo_ram_size = 0;
 
 #ifdef SERIALIZE_CACHE_RAM
 	if (ramcache) {
@@ -75,13 +85,20 @@ uint Glulx::perform_saveundo() {
 	dest_t dest;
 	uint res;
 	uint memstart = 0, memlen = 0, heapstart = 0, heaplen = 0;
-	uint stackstart = 0, stacklen = 0;
+	uint stackstart = 0, stacklen = 0, entrylen = 0;
+	uint prevlen = undo_chain_num ? undo_ram_len : 0;
+	uint32 startTime = g_system->getMillis();
 
 	/* The format for undo-saves is simpler than for saves on disk. We
-	   just have a memory chunk, a heap chunk, and a stack chunk, in
-	   that order. We skip the IFF chunk headers (although the size
+	   have the length of the whole entry, the endmem of the previous
+	   undo state, then a memory chunk, a heap chunk, and a stack chunk,
+	   in that order. We skip the IFF chunk headers (although the size
 	   fields are still there.) We also don't bother with IFF's 16-bit
-	   alignment. */
+	   alignment.
+
+	   Rather than the current RAM, the memory chunk holds its difference
+	   from the previous undo state. The current RAM is kept in undo_ram
+	   instead, until the next saveundo. */
 
 	if (undo_chain_size == 0)
 		return 1;
@@ -89,12 +106,21 @@ uint Glulx::perform_saveundo() {
 	dest._isMem = true;
 
 	res = 0;
+	if (res == 0) {
+		res = write_long(&dest, 0); /* space for entry length */
+	}
+	if (res == 0) {
+		res = write_long(&dest, prevlen);
+	}
 	if (res == 0) {
 		res = write_long(&dest, 0); /* space for chunk length */
 	}
 	if (res == 0) {
 		memstart = dest._pos;
-		res = write_memstate(&dest);
+		/* The oldest state never has to be rolled back, so it doesn't
+		   need a difference. */
+		if (undo_chain_num)
+			res = write_undo_memdelta(&dest, prevlen);
 		memlen = dest._pos - memstart;
 	}
 	if (res == 0) {
@@ -116,10 +142,17 @@ uint Glulx::perform_saveundo() {
 
 	if (res == 0) {
 		/* Trim it down to the perfect size. */
+		entrylen = dest._pos;
 		dest._ptr = (byte *)glulx_realloc(dest._ptr, dest._pos);
 		if (!dest._ptr)
 			res = 1;
 	}
+	if (res == 0) {
+		res = reposition_write(&dest, 0);
+	}
+	if (res == 0) {
+		res = write_long(&dest, entrylen);
+	}
 	if (res == 0) {
 		res = reposition_write(&dest, memstart - 4);
 	}
@@ -138,20 +171,32 @@ uint Glulx::perform_saveundo() {
 	if (res == 0) {
 		res = write_long(&dest, stacklen);
 	}
+	if (res == 0) {
+		/* Remember the current RAM for the next difference. */
+		res = grow_undo_ram(endmem);
+	}
 
 	if (res == 0) {
 		/* It worked. */
-		if (undo_chain_num >= undo_chain_size) {
-			glulx_free(undo_chain[undo_chain_num - 1]);
-			undo_chain[undo_chain_num - 1] = nullptr;
-		}
-		if (undo_chain_size > 1)
+		memcpy(undo_ram, memmap + ramstart, endmem - ramstart);
+		if (undo_ram_len > endmem)
+			memset(undo_ram + (endmem - ramstart), 0, undo_ram_len - endmem);
+		undo_ram_len = endmem;
+
+		if (undo_chain_num >= undo_chain_size)
+			drop_oldest_undo();
+		if (undo_chain_num > 0)
 			memmove(undo_chain + 1, undo_chain,
-			        (undo_chain_size - 1) * sizeof(unsigned char *));
+			        undo_chain_num * sizeof(unsigned char *));
 		undo_chain[0] = dest._ptr;
-		if (undo_chain_num < undo_chain_size)
-			undo_chain_num += 1;
+		undo_chain_num += 1;
+		undo_chain_bytes += entrylen;
 		dest._ptr = nullptr;
+
+		/* Keep the chain within its memory budget, but always keep the
+		   state we just saved. */
+		while (undo_chain_num > 1 && undo_chain_bytes > undo_chain_budget)
+			drop_oldest_undo();
 	} else {
 		/* It didn't work. */
 		if (dest._ptr) {
@@ -160,14 +205,20 @@ uint Glulx::perform_saveundo() {
 		}
 	}
 
+	undo_save_count++;
+	undo_save_time += g_system->getMillis() - startTime;
+
 	return res;
 }
 
 uint Glulx::perform_restoreundo() {
 	dest_t dest;
 	uint res, val = 0;
+	uint entrylen = 0, prevlen = 0, memstart = 0, memlen = 0;
+	uint protstart, protend;
 	uint heapsumlen = 0;
 	uint *heapsumarr = nullptr;
+	uint32 startTime = g_system->getMillis();
 
 	/* If profiling is enabled and active then fail. */
 #ifdef VM_PROFILING
@@ -183,10 +234,29 @@ uint Glulx::perform_restoreundo() {
 
 	res = 0;
 	if (res == 0) {
-		res = read_long(&dest, &val);
+		res = read_long(&dest, &entrylen);
+	}
+	if (res == 0) {
+		res = read_long(&dest, &prevlen);
+	}
+	if (res == 0) {
+		res = read_long(&dest, &memlen);
 	}
 	if (res == 0) {
-		res = read_memstate(&dest, val);
+		/* The memory chunk is only needed to roll undo_ram back afterwards;
+		   the RAM of this state is in undo_ram itself. */
+		memstart = dest._pos;
+		dest._pos += memlen;
+
+		heap_clear();
+		res = change_memsize(undo_ram_len, false);
+	}
+	if (res == 0) {
+		/* Copy everything except the protected range. */
+		protstart = CLIP(protectstart, ramstart, endmem);
+		protend = CLIP(protectend, protstart, endmem);
+		memcpy(memmap + ramstart, undo_ram, protstart - ramstart);
+		memcpy(memmap + protend, undo_ram + (protend - ramstart), endmem - protend);
 	}
 	if (res == 0) {
 		res = read_long(&dest, &val);
@@ -210,10 +280,23 @@ uint Glulx::perform_restoreundo() {
 
 	if (res == 0) {
 		/* It worked. */
-		if (undo_chain_size > 1)
+		if (undo_chain_num > 1)
 			memmove(undo_chain, undo_chain + 1,
-			        (undo_chain_size - 1) * sizeof(unsigned char *));
+			        (undo_chain_num - 1) * sizeof(unsigned char *));
 		undo_chain_num -= 1;
+		undo_chain[undo_chain_num] = nullptr;
+		undo_chain_bytes -= entrylen;
+
+		/* Roll undo_ram back to the state now at the head of the chain. If
+		   that fails, the remaining states can't be restored any more. */
+		if (undo_chain_num > 0) {
+			dest._pos = memstart;
+			if (apply_undo_memdelta(&dest, memlen, prevlen)) {
+				while (undo_chain_num > 0)
+					drop_oldest_undo();
+			}
+		}
+
 		glulx_free(dest._ptr);
 		dest._ptr = nullptr;
 	} else {
@@ -221,9 +304,109 @@ uint Glulx::perform_restoreundo() {
 		dest._ptr = nullptr;
 	}
 
+	undo_restore_count++;
+	undo_restore_time += g_system->getMillis() - startTime;
+
 	return res;
 }
 
+uint Glulx::write_undo_memdelta(dest_t *dest, uint prevlen) {
+	uint res, pos;
+	uint len = MAX(endmem, prevlen);
+	uint runlen = 0, val;
+	byte ch;
+
+	for (pos = ramstart; pos < len; pos++) {
+		ch = (pos < endmem) ? memmap[pos] : 0;
+		if (pos < prevlen)
+			ch ^= undo_ram[pos - ramstart];
+
+		if (ch == 0) {
+			runlen++;
+		} else {
+			/* Write any run we've got. */
+			while (runlen) {
+				val = MIN<uint>(runlen, 0x100);
+				res = write_byte(dest, 0);
+				if (res)
+					return res;
+				res = write_byte(dest, (val - 1));
+				if (res)
+					return res;
+				runlen -= val;
+			}
+			/* Write the byte we got. */
+			res = write_byte(dest, ch);
+			if (res)
+				return res;
+		}
+	}
+	/* As with write_memstate(), a final run is left implied. */
+
+	return 0;
+}
+
+uint Glulx::apply_undo_memdelta(dest_t *dest, uint chunklen, uint prevlen) {
+	uint chunkend = dest->_pos + chunklen;
+	uint res, pos;
+	byte ch;
+
+	res = grow_undo_ram(prevlen);
+	if (res)
+		return res;
+
+	for (pos = 0; dest->_pos < chunkend; ) {
+		res = read_byte(dest, &ch);
+		if (res)
+			return res;
+		if (ch == 0) {
+			res = read_byte(dest, &ch);
+			if (res)
+				return res;
+			pos += (uint)ch + 1;
+		} else {
+			if (pos >= undo_ram_size)
+				return 1;
+			undo_ram[pos] ^= ch;
+			pos++;
+		}
+	}
+
+	undo_ram_len = prevlen;
+
+	return 0;
+}
+
+uint Glulx::grow_undo_ram(uint len) {
+	uint size = (len > ramstart) ? len - ramstart : 0;
+	byte *newram;
+
+	if (size <= undo_ram_size)
+		return 0;
+
+	if (!undo_ram)
+		newram = (byte *)glulx_malloc(size);
+	else
+		newram = (byte *)glulx_realloc(undo_ram, size);
+	if (!newram)
+		return 1;
+
+	memset(newram + undo_ram_size, 0, size - undo_ram_size);
+	undo_ram = newram;
+	undo_ram_size = size;
+
+	return 0;
+}
+
+void Glulx::drop_oldest_undo() {
+	byte *entry = undo_chain[undo_chain_num - 1];
+
+	undo_chain_bytes -= Read4(entry);
+	glulx_free(entry);
+	undo_chain[undo_chain_num - 1] = nullptr;
+	undo_chain_num -= 1;
+}
+
 Common::Error Glulx::readSaveData(Common::SeekableReadStream *rs) {
 	Common::ErrorCode errCode = Common::kNoError;
 	QuetzalReader r;
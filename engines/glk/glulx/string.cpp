@@ -165,10 +165,27 @@ void Glulx::stream_string(uint addr, int inmiddle, int bitnum) {
 	int alldone = false;
 	int substring = (inmiddle != 0);
 	uint ival;
+	uint cacheaddr = 0;
+	bool unicode = false;
+	Common::Array<uint32> decoded;
 
 	if (!addr)
 		fatal_error("Called stream_string with null address.");
 
+	/* A compressed string in ROM, decoded with a table in ROM, always prints
+	   the same characters. So once it's been decoded, it can be replayed
+	   from the string cache. */
+	if (inmiddle == 0 && iosys_mode == iosys_Glk && tablecache_valid
+			&& addr < ramstart && Mem1(addr) == 0xE1) {
+		stringcache_t *entry = stringcache_find(addr);
+		if (entry && (entry->bytes || entry->uchars)) {
+			stringcache_print(entry);
+			return;
+		}
+		if (!entry)
+			cacheaddr = addr;
+	}
+
 	while (!alldone) {
 
 		if (inmiddle == 0) {
@@ -244,6 +261,8 @@ void Glulx::stream_string(uint addr, int inmiddle, int bitnum) {
 						switch (iosys_mode) {
 						case iosys_Glk:
 							glk_put_char(cab->u.ch);
+							if (cacheaddr)
+								decoded.push_back(cab->u.ch | 0x80000000);
 							break;
 						case iosys_Filter:
 							ival = cab->u.ch & 0xFF;
@@ -262,6 +281,10 @@ void Glulx::stream_string(uint addr, int inmiddle, int bitnum) {
 						switch (iosys_mode) {
 						case iosys_Glk:
 							(this->*glkio_unichar_han_ptr)(cab->u.uch);
+							if (cacheaddr) {
+								decoded.push_back(cab->u.uch);
+								unicode = true;
+							}
 							break;
 						case iosys_Filter:
 							ival = cab->u.uch;
@@ -279,8 +302,11 @@ void Glulx::stream_string(uint addr, int inmiddle, int bitnum) {
 					case 0x03: /* C string */
 						switch (iosys_mode) {
 						case iosys_Glk:
-							for (tmpaddr = cab->u.addr; (ch = Mem1(tmpaddr)) != '\0'; tmpaddr++)
+							for (tmpaddr = cab->u.addr; (ch = Mem1(tmpaddr)) != '\0'; tmpaddr++) {
 								glk_put_char(ch);
+								if (cacheaddr)
+									decoded.push_back(ch | 0x80000000);
+							}
 							cablist = tablecache.u.branches;
 							break;
 						case iosys_Filter:
@@ -302,8 +328,13 @@ void Glulx::stream_string(uint addr, int inmiddle, int bitnum) {
 					case 0x05: /* C Unicode string */
 						switch (iosys_mode) {
 						case iosys_Glk:
-							for (tmpaddr = cab->u.addr; (ival = Mem4(tmpaddr)) != 0; tmpaddr += 4)
+							for (tmpaddr = cab->u.addr; (ival = Mem4(tmpaddr)) != 0; tmpaddr += 4) {
 								(this->*glkio_unichar_han_ptr)(ival);
+								if (cacheaddr) {
+									decoded.push_back(ival);
+									unicode = true;
+								}
+							}
 							cablist = tablecache.u.branches;
 							break;
 						case iosys_Filter:
@@ -334,6 +365,11 @@ void Glulx::stream_string(uint addr, int inmiddle, int bitnum) {
 						if (cab->type == 0x0B)
 							oaddr = Mem4(oaddr);
 						otype = Mem1(oaddr);
+						/* What this prints can change, so don't try caching the string again. */
+						if (cacheaddr) {
+							stringcache_add(cacheaddr, nullptr, false);
+							cacheaddr = 0;
+						}
 						if (!substring) {
 							push_callstub(0x11, 0);
 							substring = true;
@@ -368,6 +404,10 @@ void Glulx::stream_string(uint addr, int inmiddle, int bitnum) {
 						break;
 					}
 				}
+				if (cacheaddr && done == 1) {
+					stringcache_add(cacheaddr, &decoded, unicode);
+					cacheaddr = 0;
+				}
 				if (done > 1) {
 					continue; /* restart the top-level loop */
 				}
@@ -619,6 +659,7 @@ void Glulx::stream_set_table(uint addr) {
 		return;
 
 	/* Drop cache. */
+	stringcache_clear();
 	if (tablecache_valid) {
 		if (tablecache.type == 0)
 			dropcache(tablecache.u.branches);
@@ -643,6 +684,123 @@ void Glulx::stream_set_table(uint addr) {
 	}
 }
 
+stringcache_t *Glulx::stringcache_find(uint addr) {
+	Common::HashMap<uint, stringcache_t *>::iterator it = stringcache.find(addr);
+	if (it == stringcache.end())
+		return nullptr;
+
+	stringcache_t *entry = it->_value;
+	if (entry != stringcache_head) {
+		/* Move it to the front of the list. */
+		entry->prev->next = entry->next;
+		if (entry->next)
+			entry->next->prev = entry->prev;
+		else
+			stringcache_tail = entry->prev;
+		entry->prev = nullptr;
+		entry->next = stringcache_head;
+		stringcache_head->prev = entry;
+		stringcache_head = entry;
+	}
+
+	return entry;
+}
+
+void Glulx::stringcache_print(const stringcache_t *entry) {
+	uint ix;
+
+	stringcache_hits++;
+	stringcache_hitchars += entry->len;
+
+	if (entry->uchars) {
+		for (ix = 0; ix < entry->len; ix++) {
+			uint32 val = entry->uchars[ix];
+			if (val & 0x80000000)
+				glk_put_char(val & 0xFF);
+			else
+				(this->*glkio_unichar_han_ptr)(val);
+		}
+	} else if (glk_stream_get_current()) {
+		glk_put_buffer(entry->bytes, entry->len);
+	} else {
+		/* Let glk_put_char() report the missing stream. */
+		for (ix = 0; ix < entry->len; ix++)
+			glk_put_char(entry->bytes[ix]);
+	}
+}
+
+void Glulx::stringcache_add(uint addr, const Common::Array<uint32> *chars, bool unicode) {
+	stringcache_t *entry;
+	uint ix, len = chars ? chars->size() : 0;
+
+	if (chars) {
+		stringcache_misses++;
+		stringcache_misschars += len;
+	}
+
+	/* Strings too large for the cache are treated like ones that can't be
+	   cached at all, so that they aren't recorded every time. */
+	if (len > STRING_CACHE_CHARS / 4)
+		chars = nullptr;
+	if (!chars)
+		len = 0;
+
+	entry = (stringcache_t *)glulx_malloc(sizeof(stringcache_t));
+	if (!entry)
+		return;
+	entry->addr = addr;
+	entry->len = len;
+	entry->bytes = nullptr;
+	entry->uchars = nullptr;
+
+	if (chars && unicode) {
+		entry->uchars = (uint32 *)glulx_malloc(sizeof(uint32) * MAX<uint>(len, 1));
+		if (entry->uchars)
+			memcpy(entry->uchars, chars->begin(), sizeof(uint32) * len);
+	} else if (chars) {
+		entry->bytes = (char *)glulx_malloc(MAX<uint>(len, 1));
+		if (entry->bytes) {
+			for (ix = 0; ix < len; ix++)
+				entry->bytes[ix] = (char)((*chars)[ix] & 0xFF);
+		}
+	}
+
+	entry->prev = nullptr;
+	entry->next = stringcache_head;
+	if (stringcache_head)
+		stringcache_head->prev = entry;
+	else
+		stringcache_tail = entry;
+	stringcache_head = entry;
+	stringcache[addr] = entry;
+	stringcache_chars += len + 1;
+
+	/* Drop the least recently printed strings to stay within the limit. */
+	while (stringcache_chars > STRING_CACHE_CHARS && stringcache_tail != entry) {
+		stringcache_t *old = stringcache_tail;
+		stringcache_tail = old->prev;
+		stringcache_tail->next = nullptr;
+		stringcache.erase(old->addr);
+		stringcache_chars -= old->len + 1;
+		glulx_free(old->bytes);
+		glulx_free(old->uchars);
+		glulx_free(old);
+	}
+}
+
+void Glulx::stringcache_clear() {
+	while (stringcache_head) {
+		stringcache_t *entry = stringcache_head;
+		stringcache_head = entry->next;
+		glulx_free(entry->bytes);
+		glulx_free(entry->uchars);
+		glulx_free(entry);
+	}
+	stringcache_tail = nullptr;
+	stringcache_chars = 0;
+	stringcache.clear();
+}
+
 void Glulx::buildcache(cacheblock_t *cablist, uint nodeaddr, int depth, int mask) {
 	int ix, type;
 
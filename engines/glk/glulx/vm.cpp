@@ -85,6 +85,11 @@ void Glulx::setup_vm() {
 		memmap = nullptr;
 		fatal_error("Unable to allocate Glulx stack space.");
 	}
+	decodecache = (decodedinst_t *)glulx_malloc(DECODE_CACHE_SIZE * sizeof(decodedinst_t));
+	if (decodecache) {
+		/* Empty slots have an address of zero, which is inside the header and never executed. */
+		memset(decodecache, 0, DECODE_CACHE_SIZE * sizeof(decodedinst_t));
+	}
 	stringtable = 0;
 
 	// Initialize various other things in the terp.
@@ -114,6 +119,11 @@ void Glulx::finalize_vm() {
 		glulx_free(stack);
 		stack = nullptr;
 	}
+	if (decodecache) {
+		glulx_free(decodecache);
+		decodecache = nullptr;
+	}
+	stringcache_clear();
 
 	final_serial();
 }
@@ -39,7 +39,8 @@ TextBufferWindow::TextBufferWindow(Windows *windows, uint rock) : TextWindow(win
 		_font(g_conf->_propInfo), _historyPos(0), _historyFirst(0), _historyPresent(0),
 		_lastSeen(0), _scrollPos(0), _scrollMax(0), _scrollBack(SCROLLBACK), _width(-1), _height(-1),
 		_inBuf(nullptr), _lineTerminators(nullptr), _echoLineInput(true), _ladjw(0), _radjw(0),
-		_ladjn(0), _radjn(0), _numChars(0), _chars(nullptr), _attrs(nullptr), _spaced(0), _dashed(0),
+		_ladjn(0), _radjn(0), _numChars(0), _chars(nullptr), _attrs(nullptr), _lineWidthChars(0),
+		_lineWidth(0), _spaced(0), _dashed(0),
 		_copyBuf(nullptr), _copyPos(0) {
 	_type = wintype_TextBuffer;
 	_history.resize(HISTORYLEN);
@@ -240,7 +241,9 @@ void TextBufferWindow::touchScroll() {
 	g_vm->_selection->clearSelection();
 	_windows->repaint(_bbox);
 
-	for (int i = 0; i < _scrollMax; i++)
+	// Only the rows on screen get redrawn, and scrolling again touches the new ones
+	int last = MIN(_scrollMax, _scrollPos + _height);
+	for (int i = _scrollPos; i < last; i++)
 		_lines[i]._dirty = true;
 }
 
@@ -317,6 +320,7 @@ void TextBufferWindow::putText(const char *buf, int len, int pos, int oldlen) {
 				_attrs + pos + oldlen,
 				(_numChars - (pos + oldlen)) * sizeof(Attributes));
 	}
+	_lineWidthChars = _lineWidth = 0;
 	if (len > 0) {
 		for (int i = 0; i < len; i++) {
 			_chars[pos + i] = buf[i];
@@ -349,6 +353,7 @@ void TextBufferWindow::putTextUni(const uint32 *buf, int len, int pos, int oldle
 				_attrs + pos + oldlen,
 				(_numChars - (pos + oldlen)) * sizeof(Attributes));
 	}
+	_lineWidthChars = _lineWidth = 0;
 	if (len > 0) {
 		int i;
 		memmove(_chars + pos, buf, len * 4);
@@ -431,6 +436,7 @@ void TextBufferWindow::putCharUni(uint32 ch) {
 			_dashed++;
 			if (_dashed == 2) {
 				_numChars--;
+				_lineWidthChars = _lineWidth = 0;
 				if (_font._dashes == 2)
 					ch = UNI_NDASH;
 				else
@@ -438,6 +444,7 @@ void TextBufferWindow::putCharUni(uint32 ch) {
 			}
 			if (_dashed == 3) {
 				_numChars--;
+				_lineWidthChars = _lineWidth = 0;
 				ch = UNI_MDASH;
 				_dashed = 0;
 			}
@@ -489,7 +496,7 @@ void TextBufferWindow::putCharUni(uint32 ch) {
 			&& !_styles[_attrs[linelen - 1].style].reverse)
 		linelen--;
 
-	if (calcWidth(_chars, _attrs, 0, linelen, -1) >= pw) {
+	if (calcLineWidth(linelen) >= pw) {
 		bpoint = _numChars;
 
 		for (i = _numChars - 1; i > 0; i--) {
@@ -518,6 +525,7 @@ void TextBufferWindow::putCharUni(uint32 ch) {
 bool TextBufferWindow::unputCharUni(uint32 ch) {
 	if (_numChars > 0 && _chars[_numChars - 1] == ch) {
 		_numChars--;
+		_lineWidthChars = _lineWidth = 0;
 		touch(0);
 		return true;
 	}
@@ -541,6 +549,7 @@ void TextBufferWindow::clear() {
 	_dashed = 0;
 
 	_numChars = 0;
+	_lineWidthChars = _lineWidth = 0;
 
 	for (i = 0; i < _scrollBack; i++) {
 		_lines[i]._len = 0;
@@ -798,6 +807,7 @@ void TextBufferWindow::cancelLineEvent(Event *ev) {
 		putCharUni('\n');
 	} else {
 		_numChars = _inFence;
+		_lineWidthChars = _lineWidth = 0;
 		touch(0);
 	}
 
@@ -856,12 +866,12 @@ void TextBufferWindow::redraw() {
 		if (selrow)
 			_lines[i]._dirty = true;
 
-		TextBufferRow ln(_lines[i]);
-
 		// skip if we can
-		if (!ln._dirty && !ln._repaint && !Windows::_forceRedraw && _scrollPos == 0)
+		if (!_lines[i]._dirty && !_lines[i]._repaint && !Windows::_forceRedraw && _scrollPos == 0)
 			continue;
 
+		TextBufferRow ln(_lines[i]);
+
 		// repaint previously selected lines if needed
 		if (ln._repaint && !Windows::_forceRedraw)
 			_windows->redrawRect(Rect(x0 / GLI_SUBPIX, y,
@@ -1087,7 +1097,10 @@ void TextBufferWindow::redraw() {
 	 * draw the images
 	 */
 	for (i = 0; i < _scrollBack; i++) {
-		TextBufferRow ln(_lines[i]);
+		const TextBufferRow &ln = _lines[i];
+
+		if (!ln._lPic && !ln._rPic)
+			continue;
 
 		y = y0 + (_height - (i - _scrollPos) - 1) * _font._leading;
 
@@ -1490,6 +1503,7 @@ void TextBufferWindow::acceptLine(uint32 keycode) {
 		putCharUni('\n');
 	} else {
 		_numChars = _inFence;
+		_lineWidthChars = _lineWidth = 0;
 		touch(0);
 	}
 
@@ -1549,11 +1563,19 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 	_lines[0]._len = _numChars;
 	_lines[0]._newLine = forced;
 
-	for (int i = _scrollBack - 1; i > 0; i--) {
-		memcpy(&_lines[i], &_lines[i - 1], sizeof(TextBufferRow));
-		if (i < _height)
-			touch(i);
-	}
+	// The oldest row drops off the end of the scrollback, and is reused as the new row 0
+	_lines.scroll();
+	_chars = _lines[0]._chars;
+	_attrs = _lines[0]._attrs;
+	_lineWidthChars = _lineWidth = 0;
+
+	if (_lines[0]._lPic)
+		_lines[0]._lPic->decrement();
+	if (_lines[0]._rPic)
+		_lines[0]._rPic->decrement();
+
+	for (int i = 1; i < _height && i < _scrollBack; i++)
+		touch(i);
 
 	if (_radjn)
 		_radjn--;
@@ -1588,7 +1610,6 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 void TextBufferWindow::scrollResize() {
 	int i;
 
-	_lines.clear();
 	_lines.resize(_scrollBack + SCROLLBACK);
 
 	_chars = _lines[0]._chars;
@@ -1631,6 +1652,29 @@ int TextBufferWindow::calcWidth(const uint32 *chars, const Attributes *attrs, in
 	return w;
 }
 
+int TextBufferWindow::calcLineWidth(int linelen) {
+	Screen &screen = *g_vm->_screen;
+	int a, b;
+
+	// Characters may have been removed from the end of the line since
+	if (_lineWidthChars > linelen)
+		_lineWidthChars = _lineWidth = 0;
+
+	// Remember the width of every attribute run that has been completed
+	a = _lineWidthChars;
+	for (b = a; b < linelen; b++) {
+		if (_attrs[a] != _attrs[b]) {
+			_lineWidth += screen.stringWidthUni(_attrs[a].attrFont(_styles),
+												Common::U32String(_chars + a, b - a), -1);
+			a = b;
+			_lineWidthChars = a;
+		}
+	}
+
+	return _lineWidth + screen.stringWidthUni(_attrs[a].attrFont(_styles),
+											  Common::U32String(_chars + a, linelen - a), -1);
+}
+
 void TextBufferWindow::getSize(uint *width, uint *height) const {
 	if (width)
 		*width = (_bbox.width() - g_conf->_tMarginX * 2) / _font._cellW;
@@ -1645,6 +1689,19 @@ void TextBufferWindow::flowBreak() {
 
 /*--------------------------------------------------------------------------*/
 
+void TextBufferWindow::TextBufferRows::resize(uint newSize) {
+	Common::Array<TextBufferRow> rows;
+	rows.resize(newSize);
+
+	for (uint i = 0; i < _rows.size() && i < newSize; i++)
+		rows[i] = (*this)[i];
+
+	_rows.swap(rows);
+	_head = 0;
+}
+
+/*--------------------------------------------------------------------------*/
+
 TextBufferWindow::TextBufferRow::TextBufferRow() : _len(0), _newLine(0), _dirty(false),
 	_repaint(false), _lPic(nullptr), _rPic(nullptr), _lHyper(0), _rHyper(0),
 	_lm(0), _rm(0) {
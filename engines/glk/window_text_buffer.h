@@ -52,7 +52,41 @@ class TextBufferWindow : public TextWindow, Speech {
 		 */
 		TextBufferRow();
 	};
-	typedef Common::Array<TextBufferRow> TextBufferRows;
+
+	/**
+	 * The rows of the window, with row 0 being the one currently written to. They're kept in
+	 * a ring, so that scrolling a new line in doesn't have to move the whole scrollback.
+	 */
+	class TextBufferRows {
+	private:
+		Common::Array<TextBufferRow> _rows;
+		uint _head;
+	public:
+		TextBufferRows() : _head(0) {}
+
+		TextBufferRow &operator[](int idx) {
+			return _rows[(_head + idx) % _rows.size()];
+		}
+		const TextBufferRow &operator[](int idx) const {
+			return _rows[(_head + idx) % _rows.size()];
+		}
+
+		uint size() const {
+			return _rows.size();
+		}
+
+		/**
+		 * Change the number of rows, keeping the contents of the existing ones
+		 */
+		void resize(uint newSize);
+
+		/**
+		 * Move every row up by one. The previous last row becomes row 0.
+		 */
+		void scroll() {
+			_head = (_head + _rows.size() - 1) % _rows.size();
+		}
+	};
 private:
 	PropFontInfo &_font;
 private:
@@ -91,6 +125,12 @@ private:
 	void scrollOneLine(bool forced);
 	void scrollResize();
 	int calcWidth(const uint32 *chars, const Attributes *attrs, int startchar, int numchars, int spw);
+
+	/**
+	 * Returns the width of the first linelen characters of the current line. Attribute runs which
+	 * are complete are measured once and remembered, rather than for every new character.
+	 */
+	int calcLineWidth(int linelen);
 public:
 	int _width, _height;
 	int _spaced;
@@ -103,6 +143,9 @@ public:
 	uint32 *_chars;       ///< alias to lines[0].chars
 	Attributes *_attrs;   ///< alias to lines[0].attrs
 
+	int _lineWidthChars;  ///< number of chars of lines[0] already measured by calcLineWidth
+	int _lineWidth;       ///< width of those characters
+
 	///< adjust margins temporarily for images
 	int _ladjw;
 	int _ladjn;
@@ -416,6 +416,7 @@ void cPhysicsBodyNewton::ClearForces() {
 //-----------------------------------------------------------------------
 
 void cPhysicsBodyNewton::OnTransformCallback(const NewtonBody *apBody, const dFloat *apMatrix, int32) {
+	cNewtonCallbackLock lock(apBody);
 	cPhysicsBodyNewton *pRigidBody = (cPhysicsBodyNewton *)NewtonBodyGetUserData(apBody);
 
 	pRigidBody->m_mtxLocalTransform.FromTranspose(apMatrix);
@@ -441,6 +442,7 @@ int cPhysicsBodyNewton::BuoyancyPlaneCallback(const int32 alCollisionID, void *a
 }
 
 void cPhysicsBodyNewton::OnUpdateCallback(NewtonBody *apBody, float, int32) {
+	cNewtonCallbackLock lock(apBody);
 	float fMass;
 	float fX, fY, fZ;
 
@@ -123,6 +123,7 @@ float cPhysicsJointHingeNewton::GetAngle() {
 //-----------------------------------------------------------------------
 
 unsigned cPhysicsJointHingeNewton::LimitCallback(const NewtonJoint *pHinge, NewtonHingeSliderUpdateDesc *pDesc) {
+	cNewtonCallbackLock lock(NewtonJointGetBody0(pHinge));
 	cPhysicsJointHingeNewton *pHingeJoint = (cPhysicsJointHingeNewton *)NewtonJointGetUserData(pHinge);
 
 	// pHingeJoint->OnPhysicsUpdate();
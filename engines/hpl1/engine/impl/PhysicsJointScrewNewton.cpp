@@ -119,6 +119,7 @@ float cPhysicsJointScrewNewton::GetAngle() {
 //-----------------------------------------------------------------------
 
 unsigned cPhysicsJointScrewNewton::LimitCallback(const NewtonJoint *pScrew, NewtonHingeSliderUpdateDesc *pDesc) {
+	cNewtonCallbackLock lock(NewtonJointGetBody0(pScrew));
 	cPhysicsJointScrewNewton *pScrewJoint = (cPhysicsJointScrewNewton *)NewtonJointGetUserData(pScrew);
 
 	// pScrewJoint->OnPhysicsUpdate();
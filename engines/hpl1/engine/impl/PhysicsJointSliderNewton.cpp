@@ -125,6 +125,7 @@ float cPhysicsJointSliderNewton::GetAngle() {
 //-----------------------------------------------------------------------
 
 unsigned cPhysicsJointSliderNewton::LimitCallback(const NewtonJoint *pSlider, NewtonHingeSliderUpdateDesc *pDesc) {
+	cNewtonCallbackLock lock(NewtonJointGetBody0(pSlider));
 	cPhysicsJointSliderNewton *pSliderJoint = (cPhysicsJointSliderNewton *)NewtonJointGetUserData(pSlider);
 
 	// pSliderJoint->OnPhysicsUpdate();
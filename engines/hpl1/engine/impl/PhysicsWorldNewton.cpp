@@ -50,6 +50,9 @@
 #include "hpl1/engine/math/Math.h"
 #include "hpl1/engine/system/low_level_system.h"
 
+#include "common/system.h"
+#include "common/threadpool.h"
+
 namespace hpl {
 
 //////////////////////////////////////////////////////////////////////////
@@ -64,6 +67,9 @@ cPhysicsWorldNewton::cPhysicsWorldNewton()
 
 	if (mpNewtonWorld == NULL) {
 		Warning("Couldn't create newton world!\n");
+	} else {
+		// Solve islands and the broadphase on the worker threads too
+		NewtonSetThreadsCount(mpNewtonWorld, g_system->getThreadPool()->getNumWorkers() + 1);
 	}
 
 	/////////////////////////////////
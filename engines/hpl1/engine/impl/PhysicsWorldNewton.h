@@ -33,6 +33,25 @@
 #include "hpl1/engine/libraries/newton/Newton.h"
 
 namespace hpl {
+
+/**
+ * Newton calls the body, material and joint callbacks from its worker
+ * threads. They change game objects, play sounds and create effects, so
+ * each callback holds the critical section of the world while it runs.
+ */
+class cNewtonCallbackLock {
+public:
+	cNewtonCallbackLock(const NewtonBody *apBody) : mpWorld(NewtonBodyGetWorld(apBody)) {
+		NewtonWorldCriticalSectionLock(mpWorld);
+	}
+	~cNewtonCallbackLock() {
+		NewtonWorldCriticalSectionUnlock(mpWorld);
+	}
+
+private:
+	NewtonWorld *mpWorld;
+};
+
 class cPhysicsWorldNewton : public iPhysicsWorld {
 public:
 	cPhysicsWorldNewton();
@@ -23,21 +23,12 @@
 #include "dgTypes.h"
 #include "dgThreads.h"
 
-inline void dgSpinUnlock(dgInt32 *spin) {
-	*spin = 0;
-}
+#include "common/system.h"
 
 dgThreads::dgThreads() {
-	m_numberOfCPUCores = 0;
-
+	m_pool = NULL;
 	m_numOfThreads = 0;
-	m_exit = false;
-
-	m_topIndex = 0;
-	m_bottomIndex = 0;
-	m_workInProgress = 0;
-	m_globalSpinLock = 0;
-	m_workToDoSpinLock = 0;
+	m_queuedJobs = 0;
 
 	m_getPerformanceCount = NULL;
 	for (dgInt32 i = 0; i < DG_MAXIMUN_THREADS; i++) {
@@ -45,10 +36,13 @@ dgThreads::dgThreads() {
 		m_localData[i].m_threadIndex = i;
 		m_localData[i].m_manager = this;
 	}
+	for (dgInt32 i = 0; i < DG_MAXQUEUE; i++) {
+		m_queue[i].m_manager = this;
+	}
 }
 
 dgThreads::~dgThreads() {
-
+	DestroydgThreads();
 }
 
 dgInt32 dgThreads::GetThreadCount() const {
@@ -56,7 +50,9 @@ dgInt32 dgThreads::GetThreadCount() const {
 }
 
 void dgThreads::ClearTimers() {
-
+	for (dgInt32 i = 0; i < DG_MAXIMUN_THREADS; i++) {
+		m_localData[i].m_ticks = 0;
+	}
 }
 
 void dgThreads::SetPerfomanceCounter(OnGetPerformanceCountCallback callback) {
@@ -73,40 +69,62 @@ dgUnsigned32 dgThreads::GetPerfomanceTicks(dgUnsigned32 threadIndex) const {
 }
 
 void dgThreads::CreateThreaded(dgInt32 threads) {
-
+	DestroydgThreads();
+
+#ifndef DG_USE_THREADS
+	// the atomic operations are needed by the memory counters and indirect locks
+	threads = 0;
+#endif
+	if (threads > 1) {
+		// the thread submitting the jobs runs them too while waiting
+		m_pool = g_system->getThreadPool();
+		threads = GetMin(threads, dgInt32(m_pool->getNumWorkers()) + 1, dgInt32(DG_MAXIMUN_THREADS));
+	}
+	m_numOfThreads = (threads > 1) ? threads : 0;
 }
 
 void dgThreads::DestroydgThreads() {
-
+	SynchronizationBarrier();
+	m_numOfThreads = 0;
+	m_pool = NULL;
 }
 
 //Queues up another to work
 dgInt32 dgThreads::SubmitJob(dgWorkerThread *const job) {
 	NEWTON_ASSERT(job->m_threadIndex != -1);
-	job->ThreadExecute();
-	return 1;
-}
-
-void *dgThreads::ThreadExecute(void *param) {
-	dgLocadData &data = *(dgLocadData *) param;
-	data.m_manager->DoWork(data.m_threadIndex);
-	return 0;
-}
+	if (!m_numOfThreads) {
+		DoWork(job);
+		return 1;
+	}
 
-dgInt32 dgThreads::GetWork(dgWorkerThread **job) {
-	dgWorkerThread *cWorker = m_queue[m_bottomIndex];
-	*job = cWorker;
+	if (m_queuedJobs == DG_MAXQUEUE) {
+		SynchronizationBarrier();
+	}
+	dgJobTask &task = m_queue[m_queuedJobs++];
+	task.m_job = job;
+	m_pool->submit(&task, m_jobs);
 	return 1;
 }
 
-void dgThreads::DoWork(dgInt32 mythreadIndex) {
-//	dgWorkerThread *job;
+void dgThreads::dgJobTask::run() {
+	m_manager->DoWork(m_job);
+}
 
-//	job->ThreadExecute();
+void dgThreads::DoWork(dgWorkerThread *const job) {
+	if (m_getPerformanceCount) {
+		dgUnsigned32 ticks = m_getPerformanceCount();
+		job->ThreadExecute();
+		m_localData[job->m_threadIndex].m_ticks += dgInt32(m_getPerformanceCount() - ticks);
+	} else {
+		job->ThreadExecute();
+	}
 }
 
 void dgThreads::SynchronizationBarrier() {
-
+	if (m_queuedJobs) {
+		m_pool->wait(m_jobs);
+		m_queuedJobs = 0;
+	}
 }
 
 void dgThreads::CalculateChunkSizes(dgInt32 elements,
@@ -127,24 +145,23 @@ void dgThreads::CalculateChunkSizes(dgInt32 elements,
 }
 
 void dgThreads::dgGetLock() const {
-	NEWTON_ASSERT(sizeof(dgInt32) == sizeof(long));
-
-	//spinLock( &m_globalSpinLock );
-// linux and mac may need to yeald time
-//	while(! __sync_bool_compare_and_swap(&m_globalSpinLock, 0, 1) ) {
-//		ThreadYield();
-//	}
+	m_globalLock.lock();
 }
 
 void dgThreads::dgReleaseLock() const {
-	dgSpinUnlock(&m_globalSpinLock);
+	m_globalLock.unlock();
 }
 
 void dgThreads::dgGetIndirectLock(dgInt32 *lockVar) {
-	NEWTON_ASSERT(sizeof(dgInt32) == sizeof(long));
+	// the lock variables are spin locks, which are only held for a few instructions
+	if (m_numOfThreads) {
+		while (!dgSpinTryLock(lockVar)) {
+		}
+	}
 }
 
 void dgThreads::dgReleaseIndirectLock(dgInt32 *lockVar) {
-	NEWTON_ASSERT(sizeof(dgInt32) == sizeof(long));
-	dgSpinUnlock(lockVar);
+	if (m_numOfThreads) {
+		dgSpinUnlock(lockVar);
+	}
 }
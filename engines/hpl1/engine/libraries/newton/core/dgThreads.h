@@ -22,6 +22,9 @@
 #if !defined(AFX_DG_THREADS_42YH_HY78GT_YHJ63Y__INCLUDED_)
 #define AFX_DG_THREADS_42YH_HY78GT_YHJ63Y__INCLUDED_
 
+#include "common/mutex.h"
+#include "common/threadpool.h"
+
 #define DG_MAXQUEUE     16
 
 
@@ -67,26 +70,25 @@ private:
 		dgThreads *m_manager;
 	};
 
-	void DoWork(dgInt32 threadIndex);
-	dgInt32 GetWork(dgWorkerThread **cWork);
+	// runs a submitted job on the thread pool of the system
+	class dgJobTask : public Common::Task {
+	public:
+		dgJobTask() : m_job(NULL), m_manager(NULL) {}
+		void run() override;
 
+		dgWorkerThread *m_job;
+		dgThreads *m_manager;
+	};
 
-	static void *ThreadExecute(void *Param);
+	void DoWork(dgWorkerThread *const job);
 
+	Common::ThreadPool *m_pool;
+	Common::TaskGroup m_jobs;
+	dgJobTask m_queue[DG_MAXQUEUE];
 	dgInt32 m_numOfThreads;
-	dgInt32 m_numberOfCPUCores;
-	dgInt32 m_topIndex;
-	dgInt32 m_bottomIndex;
-	dgInt32 m_workInProgress;
-	mutable dgInt32 m_globalSpinLock;
-
-	bool m_exit;
-	//dgInt32 m_emptySlot;
-	//dgInt32 m_workToDo;
-	//dgInt32 m_criticalSection;
-	dgInt32 m_workToDoSpinLock;
-	dgWorkerThread *m_queue[DG_MAXQUEUE];
-	//pthread_t m_threadhandles[DG_MAXIMUN_THREADS];
+	dgInt32 m_queuedJobs;
+
+	mutable Common::Mutex m_globalLock;
 
 	OnGetPerformanceCountCallback m_getPerformanceCount;
 	dgLocadData m_localData[DG_MAXIMUN_THREADS];
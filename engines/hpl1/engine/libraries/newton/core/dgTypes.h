@@ -602,8 +602,49 @@ typedef dgUnsigned32(dgApi *OnGetPerformanceCountCallback)();
 
 dgCpuClass dgApi dgGetCpuType();
 
+// The worker threads are only used when the compiler offers atomic operations
+#if defined(__GNUC__)
+#define DG_USE_THREADS
+
+inline dgInt32 dgAtomicAdd(dgInt32 *const addend, dgInt32 amount) {
+	return __sync_add_and_fetch(addend, amount);
+}
+
+inline bool dgSpinTryLock(dgInt32 *const spin) {
+	return __sync_bool_compare_and_swap(spin, 0, 1);
+}
+
+inline void dgSpinUnlock(dgInt32 *const spin) {
+	__sync_lock_release(spin);
+}
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define DG_USE_THREADS
+
+inline dgInt32 dgAtomicAdd(dgInt32 *const addend, dgInt32 amount) {
+	return dgInt32(_InterlockedExchangeAdd((volatile long *)addend, long(amount))) + amount;
+}
+
+inline bool dgSpinTryLock(dgInt32 *const spin) {
+	return _InterlockedCompareExchange((volatile long *)spin, 1, 0) == 0;
+}
+
+inline void dgSpinUnlock(dgInt32 *const spin) {
+	_InterlockedExchange((volatile long *)spin, 0);
+}
+#else
 inline dgInt32 dgAtomicAdd(dgInt32 *const addend, dgInt32 amount) {
 	return *addend += amount;
 }
 
+inline bool dgSpinTryLock(dgInt32 *const spin) {
+	*spin = 1;
+	return true;
+}
+
+inline void dgSpinUnlock(dgInt32 *const spin) {
+	*spin = 0;
+}
+#endif
+
 #endif
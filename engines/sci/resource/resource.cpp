@@ -383,9 +383,10 @@ Common::SeekableReadStream *ResourceManager::getVolumeFile(ResourceSource *sourc
 		}
 		++it;
 	}
-	// adding a new file
+	// adding a new file. Volumes stay open and are only read from, so map
+	// them into memory where possible instead of reading them through stdio
 	file = new Common::File;
-	if (file->open(filename)) {
+	if (file->open(SearchMan.createMappedReadStreamForMember(Common::Path(filename)), filename)) {
 		if (_volumeFiles.size() == MAX_OPENED_VOLUMES) {
 			it = --_volumeFiles.end();
 			delete *it;
@@ -326,6 +326,7 @@ MODULE_OBJS += \
 	nuvie/pathfinder/dir_finder.o \
 	nuvie/pathfinder/party_path_finder.o \
 	nuvie/pathfinder/path.o \
+	nuvie/pathfinder/path_cache.o \
 	nuvie/pathfinder/path_finder.o \
 	nuvie/pathfinder/sched_path_finder.o \
 	nuvie/pathfinder/seek_path.o \
@@ -527,6 +528,7 @@ MODULE_OBJS += \
 	ultima8/usecode/uc_list.o \
 	ultima8/usecode/uc_machine.o \
 	ultima8/usecode/uc_process.o \
+	ultima8/usecode/uc_profiler.o \
 	ultima8/usecode/uc_stack.o \
 	ultima8/usecode/usecode.o \
 	ultima8/usecode/usecode_flex.o \
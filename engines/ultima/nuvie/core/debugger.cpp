@@ -20,11 +20,90 @@
  */
 
 #include "ultima/nuvie/core/debugger.h"
+#include "ultima/nuvie/core/game.h"
+#include "ultima/nuvie/core/map.h"
+#include "ultima/nuvie/core/player.h"
+#include "ultima/nuvie/actors/actor.h"
+#include "ultima/nuvie/pathfinder/path_cache.h"
+#include "ultima/nuvie/pathfinder/sched_path_finder.h"
+#include "ultima/nuvie/pathfinder/u6_astar_path.h"
+#include "common/random.h"
+#include "common/system.h"
 
 namespace Ultima {
 namespace Nuvie {
 
 Debugger::Debugger() : Shared::Debugger() {
+	registerCmd("pathbench", WRAP_METHOD(Debugger, cmdPathBench));
+}
+
+bool Debugger::cmdPathBench(int argc, const char **argv) {
+	Game *game = Game::get_game();
+	if (!game || !game->get_player() || !game->get_path_cache()) {
+		debugPrintf("No game is loaded\n");
+		return true;
+	}
+	const int count = (argc > 1) ? strToInt(argv[1]) : 200;
+	const int range = (argc > 2) ? strToInt(argv[2]) : 32;
+	if (count <= 0 || range <= 0) {
+		debugPrintf("pathbench [searches] [range]\n");
+		return true;
+	}
+
+	Actor *actor = game->get_player()->get_actor();
+	PathCache *cache = game->get_path_cache();
+	MapCoord center = actor->get_location();
+	const uint16 width = game->get_game_map()->get_width(center.z);
+
+	// Use the same locations every time, so runs can be compared
+	Common::RandomSource rnd("nuviepathbench");
+	rnd.setSeed(1);
+	Std::vector<MapCoord> starts, goals;
+	for (int tries = 0; (int)starts.size() < count && tries < count * 100; tries++) {
+		MapCoord s((center.x + width + rnd.getRandomNumberRngSigned(-range, range)) % width,
+		           (center.y + width + rnd.getRandomNumberRngSigned(-range, range)) % width, center.z);
+		MapCoord g((s.x + width + rnd.getRandomNumberRngSigned(-range, range)) % width,
+		           (s.y + width + rnd.getRandomNumberRngSigned(-range, range)) % width, center.z);
+		if (actor->check_move(s.x, s.y, s.z, ACTOR_IGNORE_OTHERS)
+		        && actor->check_move(g.x, g.y, g.z, ACTOR_IGNORE_OTHERS)) {
+			starts.push_back(s);
+			goals.push_back(g);
+		}
+	}
+	if (starts.empty()) {
+		debugPrintf("No open locations near %x,%x,%d\n", center.x, center.y, center.z);
+		return true;
+	}
+
+	// pass 0 searches every path, pass 1 fills the cache and pass 2 reads it
+	uint32 times[3], found = 0;
+	for (int pass = 0; pass < 3; pass++) {
+		if (pass < 2)
+			cache->clear();
+		cache->reset_stats();
+		uint32 start = g_system->getMillis();
+		for (uint i = 0; i < starts.size(); i++) {
+			SchedPathFinder pf(actor, goals[i], new U6AStarPath);
+			pf.set_location(starts[i]);
+			if (pass == 0)
+				cache->clear();
+			if (pf.find_path() && pass == 0)
+				found++;
+		}
+		times[pass] = g_system->getMillis() - start;
+	}
+
+	const uint searches = starts.size();
+	debugPrintf("%d searches within %d tiles of %x,%x,%d, %d found\n", searches, range, center.x, center.y, center.z, found);
+	debugPrintf("Uncached: %d ms, %d paths/second\n", times[0], times[0] ? searches * 1000 / times[0] : 0);
+	debugPrintf("Filling cache: %d ms, %d paths/second\n", times[1], times[1] ? searches * 1000 / times[1] : 0);
+	debugPrintf("Cached: %d ms, %d paths/second (%d hits, %d misses, %d stale)\n", times[2], times[2] ? searches * 1000 / times[2] : 0,
+	            cache->get_hits(), cache->get_misses(), cache->get_stale());
+
+	// The benchmark's routes are for the avatar, not for schedules
+	cache->clear();
+	cache->reset_stats();
+	return true;
 }
 
 } // End of namespace Ultima8
@@ -31,6 +31,12 @@ namespace Nuvie {
  * Debugger base class
  */
 class Debugger : public Shared::Debugger {
+private:
+	/**
+	 * Times path searches between random locations near the avatar,
+	 * with and without the path cache
+	 */
+	bool cmdPathBench(int argc, const char **argv);
 public:
 	Debugger();
 	~Debugger() override {}
@@ -60,6 +60,7 @@
 #include "ultima/nuvie/core/cursor.h"
 #include "ultima/nuvie/core/weather.h"
 #include "ultima/nuvie/core/book.h"
+#include "ultima/nuvie/pathfinder/path_cache.h"
 #include "ultima/nuvie/keybinding/keys.h"
 #include "ultima/nuvie/files/utils.h"
 #include "ultima/nuvie/core/game.h"
@@ -89,6 +90,7 @@ Game::Game(Configuration *cfg, Events *evt, Screen *scr, GUI *g, nuvie_game_t ty
 	dither = NULL;
 	tile_manager = NULL;
 	obj_manager = NULL;
+	path_cache = NULL;
 	palette = NULL;
 	font_manager = NULL;
 	scroll = NULL;
@@ -175,6 +177,7 @@ Game::~Game() {
 	// AddWidget()!
 	if (dither) delete dither;
 	if (tile_manager) delete tile_manager;
+	if (path_cache) delete path_cache;
 	if (obj_manager) delete obj_manager;
 	if (palette) delete palette;
 	if (font_manager) delete font_manager;
@@ -241,6 +244,7 @@ bool Game::loadGame(Script *s) {
 
 	ConsoleAddInfo("Loading ObjManager()");
 	obj_manager = new ObjManager(config, tile_manager, egg_manager);
+	path_cache = new PathCache(obj_manager);
 
 	if (game_type == NUVIE_GAME_U6) {
 		book = new Book(config);
@@ -61,6 +61,7 @@ class CommandBar;
 class Weather;
 class Book;
 class KeyBinder;
+class PathCache;
 
 typedef enum {
 	PAUSE_UNPAUSED = 0x00,
@@ -84,6 +85,7 @@ private:
 	FontManager *font_manager;
 	TileManager *tile_manager;
 	ObjManager *obj_manager;
+	PathCache *path_cache;
 	ActorManager *actor_manager;
 	Magic *magic;
 	Map *game_map;
@@ -339,6 +341,9 @@ public:
 	ObjManager *get_obj_manager()     {
 		return (obj_manager);
 	}
+	PathCache *get_path_cache()       {
+		return (path_cache);
+	}
 	ActorManager *get_actor_manager() {
 		return (actor_manager);
 	}
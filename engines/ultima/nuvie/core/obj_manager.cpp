@@ -58,6 +58,7 @@ ObjManager::ObjManager(Configuration *cfg, TileManager *tm, EggManager *em) {
 	egg_manager = em;
 	usecode = NULL;
 	obj_save_count = 0;
+	map_changes = 0;
 
 	load_basetile();
 	load_weight_table();
@@ -1277,6 +1278,7 @@ bool ObjManager::remove_obj_from_map(Obj *obj) {
 
 	obj_list->remove(obj);
 	remove_obj(obj);
+	map_changed();
 
 	return true;
 }
@@ -1607,6 +1609,7 @@ bool ObjManager::add_obj(Obj *obj, bool addOnTop) {
 		temp_obj_list_add(obj);
 
 	obj->set_on_map(obj_list); //mark object as on map.
+	map_changed();
 
 	return true;
 }
@@ -100,6 +100,8 @@ class ObjManager {
 
 	bool custom_actor_tiles;
 
+	uint32 map_changes; // objects added to or removed from the map, and doors used
+
 public:
 
 	ObjManager(Configuration *cfg, TileManager *tm, EggManager *em);
@@ -115,6 +117,15 @@ public:
 		show_eggs = value;
 	}
 
+	/* Count changes to the objects on the map that can open or close a path,
+	   so cached paths can be dropped. */
+	void map_changed() {
+		map_changes++;
+	}
+	uint32 get_map_changes() const {
+		return map_changes;
+	}
+
 	bool loadObjs();
 	bool load_super_chunk(NuvieIO *chunk_buf, uint8 level, uint8 chunk_offset);
 	void startObjs();
@@ -92,6 +92,8 @@ bool AStarPath::search_node_neighbors(astar_node *nnode, MapCoord &goal,
 			remove_closed_node(in_closed);
 		if (!in_open)
 			push_open_node(neighbor);
+		else
+			delete neighbor;
 	}
 	return true;
 }/* Do A* search of tiles to create a path from `start' to `goal'.
@@ -124,7 +126,7 @@ bool AStarPath::search_node_neighbors(astar_node *nnode, MapCoord &goal,
 		// check cardinal neighbors (starting at top going clockwise)
 		search_node_neighbors(nnode, goal, max_score);
 		// node and neighbors checked, put into closed
-		closed_nodes.push_back(nnode);
+		push_closed_node(nnode);
 	}
 //DEBUG(0,LEVEL_DEBUGGING,"FAIL\n");
 	delete_nodes();
@@ -139,21 +141,14 @@ sint32 AStarPath::step_cost(MapCoord &c1, MapCoord &c2) {
 	return (1);
 }/* Return an item in the list of closed nodes whose location matches `ncmp'.
  */astar_node *AStarPath::find_closed_node(astar_node *ncmp) {
-	Std::list<astar_node *>::iterator n;
-	for (n = closed_nodes.begin(); n != closed_nodes.end(); n++)
-		if ((*n)->loc == ncmp->loc)
-			return (*n);
-	return (NULL);
-}/* Return an item in the list of closed nodes whose location matches `ncmp'.
+	return closed_index.getValOrDefault(node_key(ncmp), NULL);
+}/* Return an item in the list of open nodes whose location matches `ncmp'.
  */astar_node *AStarPath::find_open_node(astar_node *ncmp) {
-	Std::list<astar_node *>::iterator n;
-	for (n = open_nodes.begin(); n != open_nodes.end(); n++)
-		if ((*n)->loc == ncmp->loc)
-			return (*n);
-	return (NULL);
+	return open_index.getValOrDefault(node_key(ncmp), NULL);
 }/* Add new node pointer to the list of open nodes (sorting by score).
  */void AStarPath::push_open_node(astar_node *node) {
 	Std::list<astar_node *>::iterator n, next;
+	open_index[node_key(node)] = node;
 	if (open_nodes.empty()) {
 		open_nodes.push_front(node);
 		return;
@@ -167,19 +162,23 @@ sint32 AStarPath::step_cost(MapCoord &c1, MapCoord &c2) {
  */astar_node *AStarPath::pop_open_node() {
 	astar_node *best = open_nodes.front();
 	open_nodes.pop_front(); // remove it
+	open_index.erase(node_key(best));
 	return (best);
 }
 
+/* Add node pointer to the list of closed nodes.
+ */
+void AStarPath::push_closed_node(astar_node *node) {
+	closed_nodes.push_back(node);
+	closed_index[node_key(node)] = node;
+}
+
 /* Find item in the list of closed nodes whose location matched `ncmp', and
- * remove it from the list.
+ * remove it from the list. The node stays in closed_nodes until the search is
+ * finished, as it may still be the parent of other nodes.
  */
 void AStarPath::remove_closed_node(astar_node *ncmp) {
-	Std::list<astar_node *>::iterator n;
-	for (n = closed_nodes.begin(); n != closed_nodes.end(); n++)
-		if ((*n)->loc == ncmp->loc) {
-			closed_nodes.erase(n);
-			return;
-		}
+	closed_index.erase(node_key(ncmp));
 }
 
 /* Delete nodes dereferenced from pointers in the lists.
@@ -195,6 +194,8 @@ void AStarPath::delete_nodes() {
 		closed_nodes.pop_front();
 		delete delnode;
 	}
+	open_index.clear(true);
+	closed_index.clear(true);
 }
 
 } // End of namespace Nuvie
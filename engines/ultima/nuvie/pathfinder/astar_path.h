@@ -24,6 +24,7 @@
 
 #include "ultima/nuvie/core/map.h"
 #include "ultima/nuvie/pathfinder/path.h"
+#include "common/hashmap.h"
 
 namespace Ultima {
 namespace Nuvie {
@@ -42,6 +43,9 @@ typedef struct astar_node_s {
  */class AStarPath: public Path {
 protected:
 	Std::list<astar_node *> open_nodes, closed_nodes; // nodes seen
+	/* Open and closed nodes by location. A search stays on one level, so the
+	   key is only made of the x and y coordinates. */
+	Common::HashMap<uint32, astar_node *> open_index, closed_index;
 	astar_node *final_node; // last node in path search, used by create_path()
 	/* Forms a usable path from results of a search. */
 	void create_path();
@@ -72,8 +76,12 @@ protected:
 	void push_open_node(astar_node *node);
 	astar_node *pop_open_node();
 	astar_node *find_closed_node(astar_node *ncmp);
+	void push_closed_node(astar_node *node);
 	void remove_closed_node(astar_node *ncmp);
 	void delete_nodes();
+	static uint32 node_key(const astar_node *node) {
+		return node->loc.x | ((uint32)node->loc.y << 16);
+	}
 };
 
 } // End of namespace Nuvie
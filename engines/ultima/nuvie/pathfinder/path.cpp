@@ -95,6 +95,13 @@ void Path::get_path(MapCoord **path_start, uint32 &pathSize) {
 	pathSize = step_count;
 }
 
+void Path::set_path(const MapCoord *steps, uint32 count) {
+	delete_path();
+	for (uint32 i = 0; i < count; i++)
+		add_step(steps[i]);
+	set_path_size(step_count);
+}
+
 /* Increases path size in blocks and adds a step to the end of the path. */
 void Path::add_step(MapCoord loc) {
 	const int path_block_size = 8;
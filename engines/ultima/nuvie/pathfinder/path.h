@@ -71,6 +71,8 @@ public:
 	virtual MapCoord get_last_step();
 	virtual MapCoord get_step(uint32 step_index);
 	virtual void get_path(MapCoord **path_start, uint32 &path_size);
+	/* Replace the path with a copy of `count' steps, such as a cached route. */
+	void set_path(const MapCoord *steps, uint32 count);
 	uint32 get_num_steps() {
 		return step_count;
 	}
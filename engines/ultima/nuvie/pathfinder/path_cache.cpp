@@ -0,0 +1,105 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "ultima/nuvie/core/nuvie_defs.h"
+#include "ultima/nuvie/core/obj_manager.h"
+#include "ultima/nuvie/actors/actor.h"
+#include "ultima/nuvie/pathfinder/path.h"
+#include "ultima/nuvie/pathfinder/path_cache.h"
+
+namespace Ultima {
+namespace Nuvie {
+
+PathCache::PathCache(ObjManager *om) : obj_manager(om), map_changes(0),
+	hits(0), misses(0), stale(0), flushes(0) {
+	if (obj_manager)
+		map_changes = obj_manager->get_map_changes();
+}
+
+PathCache::RouteKey PathCache::make_key(Actor *actor, const MapCoord &start, const MapCoord &goal) {
+	RouteKey key;
+	key.obj_n = actor->get_obj_n();
+	key.actor_num = actor->get_actor_num();
+	key.start = start;
+	key.goal = goal;
+	return key;
+}
+
+/* Drop all routes if something on the map changed since they were found. */
+void PathCache::check_map_changes() {
+	if (obj_manager && obj_manager->get_map_changes() != map_changes) {
+		map_changes = obj_manager->get_map_changes();
+		if (!routes.empty()) {
+			routes.clear();
+			flushes++;
+		}
+	}
+}
+
+/* Look for a route from `start' to `goal' searched by the same actor. A found
+ * route is copied into `path' if each of its steps can still be taken.
+ */
+PathCacheResult PathCache::find(Actor *actor, const MapCoord &start, const MapCoord &goal, Path *path) {
+	check_map_changes();
+
+	RouteMap::iterator i = routes.find(make_key(actor, start, goal));
+	if (i == routes.end()) {
+		misses++;
+		return PATH_CACHE_MISS;
+	}
+	Std::vector<MapCoord> &steps = i->_value;
+	for (uint32 n = 1; n < steps.size(); n++) {
+		if (path->step_cost(steps[n - 1], steps[n]) == -1) {
+			routes.erase(i); // blocked by something not seen as a map change
+			stale++;
+			misses++;
+			return PATH_CACHE_MISS;
+		}
+	}
+	path->set_path(&steps[0], steps.size());
+	hits++;
+	return PATH_CACHE_FOUND;
+}
+
+/* Keep the route currently in `path'. */
+void PathCache::add(Actor *actor, const MapCoord &start, const MapCoord &goal, Path *path) {
+	MapCoord *steps = NULL;
+	uint32 count = 0;
+	path->get_path(&steps, count);
+	if (!count)
+		return;
+
+	check_map_changes();
+	if (routes.size() >= PATH_CACHE_SIZE)
+		routes.clear();
+	Std::vector<MapCoord> &route = routes[make_key(actor, start, goal)];
+	route.clear();
+	for (uint32 n = 0; n < count; n++)
+		route.push_back(steps[n]);
+}
+
+void PathCache::clear() {
+	routes.clear();
+}
+
+} // End of namespace Nuvie
+} // End of namespace Ultima
@@ -0,0 +1,116 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef NUVIE_PATHFINDER_PATH_CACHE_H
+#define NUVIE_PATHFINDER_PATH_CACHE_H
+
+#include "ultima/nuvie/core/map.h"
+#include "ultima/shared/std/containers.h"
+#include "common/hashmap.h"
+
+namespace Ultima {
+namespace Nuvie {
+
+class Actor;
+class ObjManager;
+class Path;
+
+#define PATH_CACHE_SIZE 512 // routes kept before the cache is emptied
+
+typedef enum {
+	PATH_CACHE_MISS,
+	PATH_CACHE_FOUND // the cached path was copied to the search
+} PathCacheResult;
+
+/* Keeps recently found routes, so actors walking the same schedule
+ * don't repeat the same tile search every time. Routes are kept per actor, as
+ * actors don't all move over the same tiles. All routes are dropped when an
+ * object is added to or removed from the map, or a door is opened or closed.
+ * Found routes are also checked step by step before they are used.
+ *
+ * Moving actors are not map changes, so only routes searched by a path finder
+ * that ignores other actors (SchedPathFinder) may be added. Otherwise a route
+ * could be a detour around an actor that has long since moved on.
+ */
+class PathCache {
+	struct RouteKey {
+		uint16 obj_n;
+		uint8 actor_num;
+		MapCoord start, goal;
+	};
+	struct RouteKeyHash {
+		uint operator()(const RouteKey &k) const {
+			return ((uint)k.start.x | ((uint)k.start.y << 10) | ((uint)k.start.z << 20))
+			       ^ (((uint)k.goal.x << 13) | ((uint)k.goal.y << 3) | ((uint)k.goal.z << 23))
+			       ^ ((uint)k.actor_num << 24) ^ ((uint)k.obj_n << 7);
+		}
+	};
+	struct RouteKeyEqual {
+		bool operator()(const RouteKey &a, const RouteKey &b) const {
+			return a.obj_n == b.obj_n && a.actor_num == b.actor_num
+			       && a.start.x == b.start.x && a.start.y == b.start.y && a.start.z == b.start.z
+			       && a.goal.x == b.goal.x && a.goal.y == b.goal.y && a.goal.z == b.goal.z;
+		}
+	};
+	typedef Common::HashMap<RouteKey, Std::vector<MapCoord>, RouteKeyHash, RouteKeyEqual> RouteMap;
+
+	ObjManager *obj_manager;
+	RouteMap routes;
+	uint32 map_changes; // ObjManager change count the routes are valid for
+
+	uint32 hits, misses, stale, flushes;
+
+	RouteKey make_key(Actor *actor, const MapCoord &start, const MapCoord &goal);
+	void check_map_changes();
+
+public:
+	PathCache(ObjManager *om);
+	~PathCache() { }
+
+	PathCacheResult find(Actor *actor, const MapCoord &start, const MapCoord &goal, Path *path);
+	void add(Actor *actor, const MapCoord &start, const MapCoord &goal, Path *path);
+	void clear();
+
+	uint32 get_size() const {
+		return routes.size();
+	}
+	uint32 get_hits() const {
+		return hits;
+	}
+	uint32 get_misses() const {
+		return misses;
+	}
+	uint32 get_stale() const {
+		return stale;
+	}
+	uint32 get_flushes() const {
+		return flushes;
+	}
+	void reset_stats() {
+		hits = misses = stale = flushes = 0;
+	}
+};
+
+} // End of namespace Nuvie
+} // End of namespace Ultima
+
+#endif
@@ -22,7 +22,9 @@
 #include "ultima/nuvie/core/nuvie_defs.h"
 #include "ultima/nuvie/actors/actor.h"
 #include "ultima/nuvie/core/map.h"
+#include "ultima/nuvie/core/game.h"
 #include "ultima/nuvie/pathfinder/path.h"
+#include "ultima/nuvie/pathfinder/path_cache.h"
 #include "ultima/nuvie/pathfinder/sched_path_finder.h"
 
 namespace Ultima {
@@ -56,12 +58,21 @@ bool SchedPathFinder::get_next_move(MapCoord &step) {
 	return true;
 }
 
+/* Schedules send actors along the same routes every day, so the routes are
+ * kept in the game's path cache. This is only safe because check_loc() ignores
+ * other actors, whose moves are not map changes. Failed searches are not kept,
+ * so a change the cache is not told about can't leave the actor stuck. */
 bool SchedPathFinder::find_path() {
+	PathCache *cache = Game::get_game()->get_path_cache();
 	if (search->have_path())
 		search->delete_path();
-	if (!search->path_search(loc, goal)) {
-		DEBUG(0, LEVEL_WARNING, "actor %d failed to find a path to %x,%x\n", actor->get_actor_num(), goal.x, goal.y);
-		return false;
+	if (!cache || cache->find(actor, loc, goal, search) == PATH_CACHE_MISS) {
+		if (!search->path_search(loc, goal)) {
+			DEBUG(0, LEVEL_WARNING, "actor %d failed to find a path to %x,%x\n", actor->get_actor_num(), goal.x, goal.y);
+			return false;
+		}
+		if (cache)
+			cache->add(actor, loc, goal, search);
 	}
 	prev_step_i = next_step_i = 0;
 	incr_step(); // the first step is the start location, so skip it
@@ -1839,11 +1839,15 @@ static int nscript_obj_set(lua_State *L) {
 
 	if (!strcmp(key, "obj_n")) {
 		obj->obj_n = (uint16)lua_tointeger(L, 3);
+		if (obj->is_on_map())
+			Game::get_game()->get_obj_manager()->map_changed();
 		return 0;
 	}
 
 	if (!strcmp(key, "frame_n")) {
 		obj->frame_n = (uint8)lua_tointeger(L, 3);
+		if (obj->is_on_map())
+			Game::get_game()->get_obj_manager()->map_changed();
 		return 0;
 	}
 
@@ -410,13 +410,17 @@ bool U6UseCode::uc_event(const U6ObjectType *type, UseCodeEvent ev, Obj *obj) {
 
 
 void U6UseCode::lock_door(Obj *obj) {
-	if (is_unlocked_door(obj))
+	if (is_unlocked_door(obj)) {
 		obj->frame_n += 4;
+		obj_manager->map_changed();
+	}
 }
 
 void U6UseCode::unlock_door(Obj *obj) {
-	if (is_locked_door(obj))
+	if (is_locked_door(obj)) {
 		obj->frame_n -= 4;
+		obj_manager->map_changed();
+	}
 }
 
 void U6UseCode::unlock(Obj *obj) {
@@ -463,11 +467,13 @@ bool U6UseCode::use_door(Obj *obj, UseCodeEvent ev) {
 			if (print) scroll->display_string("\nNot now!\n");
 		} else { //close the door
 			obj->frame_n += 4;
+			obj_manager->map_changed();
 			if (print) scroll->display_string("\nclosed!\n");
 		}
 	} else {
 		process_effects(obj, items.actor_ref); //process traps.
 		obj->frame_n -= 4;
+		obj_manager->map_changed();
 		if (print) scroll->display_string("\nopened!\n");
 	}
 
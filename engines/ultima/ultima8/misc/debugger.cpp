@@ -44,9 +44,11 @@
 #include "ultima/ultima8/misc/id_man.h"
 #include "ultima/ultima8/misc/util.h"
 #include "ultima/ultima8/usecode/uc_machine.h"
+#include "ultima/ultima8/usecode/uc_profiler.h"
 #include "ultima/ultima8/usecode/bit_set.h"
 #include "ultima/ultima8/world/current_map.h"
 #include "ultima/ultima8/world/world.h"
+#include "ultima/ultima8/world/item_sorter.h"
 #include "ultima/ultima8/world/camera_process.h"
 #include "ultima/ultima8/world/get_object.h"
 #include "ultima/ultima8/world/item_factory.h"
@@ -132,6 +134,9 @@ Debugger::Debugger() : GUI::Debugger() {
 	registerCmd("Cheat::items", WRAP_METHOD(Debugger, cmdCheatItems));
 	registerCmd("Cheat::equip", WRAP_METHOD(Debugger, cmdCheatEquip));
 
+	registerCmd("CurrentMap::toggleQueryProfiling", WRAP_METHOD(Debugger, cmdToggleQueryProfiling));
+	registerCmd("CurrentMap::queryStats", WRAP_METHOD(Debugger, cmdQueryStats));
+
 	registerCmd("GameMapGump::startHighlightItems", WRAP_METHOD(Debugger, cmdStartHighlightItems));
 	registerCmd("GameMapGump::stopHighlightItems", WRAP_METHOD(Debugger, cmdStopHighlightItems));
 	registerCmd("GameMapGump::toggleHighlightItems", WRAP_METHOD(Debugger, cmdToggleHighlightItems));
@@ -140,6 +145,7 @@ Debugger::Debugger() : GUI::Debugger() {
 	registerCmd("GameMapGump::dumpAllMaps", WRAP_METHOD(Debugger, cmdDumpAllMaps));
 	registerCmd("GameMapGump::incrementSortOrder", WRAP_METHOD(Debugger, cmdIncrementSortOrder));
 	registerCmd("GameMapGump::decrementSortOrder", WRAP_METHOD(Debugger, cmdDecrementSortOrder));
+	registerCmd("GameMapGump::sortStats", WRAP_METHOD(Debugger, cmdSortStats));
 
 	registerCmd("Kernel::processTypes", WRAP_METHOD(Debugger, cmdProcessTypes));
 	registerCmd("Kernel::processInfo", WRAP_METHOD(Debugger, cmdProcessInfo));
@@ -194,6 +200,9 @@ Debugger::Debugger() : GUI::Debugger() {
 	registerCmd("UCMachine::traceClass", WRAP_METHOD(Debugger, cmdTraceClass));
 	registerCmd("UCMachine::traceAll", WRAP_METHOD(Debugger, cmdTraceAll));
 	registerCmd("UCMachine::stopTrace", WRAP_METHOD(Debugger, cmdStopTrace));
+	registerCmd("UCMachine::profile", WRAP_METHOD(Debugger, cmdProfile));
+	registerCmd("UCMachine::profileReport", WRAP_METHOD(Debugger, cmdProfileReport));
+	registerCmd("UCMachine::profileDump", WRAP_METHOD(Debugger, cmdProfileDump));
 
 	registerCmd("FastAreaVisGump::toggle", WRAP_METHOD(Debugger, cmdToggleFastArea));
 	registerCmd("InverterProcess::invertScreen", WRAP_METHOD(Debugger, cmdInvertScreen));
@@ -654,6 +663,33 @@ bool Debugger::cmdToggleInvincibility(int argc, const char **argv) {
 }
 
 
+bool Debugger::cmdToggleQueryProfiling(int argc, const char **argv) {
+	CurrentMap *map = World::get_instance()->getCurrentMap();
+	map->setQueryProfiling(!map->isQueryProfiling());
+	debugPrintf("Map query profiling %s.\n", map->isQueryProfiling() ? "enabled" : "disabled");
+	return true;
+}
+
+bool Debugger::cmdQueryStats(int argc, const char **argv) {
+	const CurrentMap *map = World::get_instance()->getCurrentMap();
+	if (!map->isQueryProfiling()) {
+		debugPrintf("Map query profiling is disabled, use CurrentMap::toggleQueryProfiling\n");
+		return true;
+	}
+
+	uint32 frames = map->getQueryFrames();
+	debugPrintf("%u frames, %u ms updating the world\n", frames, map->getQueryFrameTime());
+
+	debugPrintf("%-22s %8s %10s %10s %10s\n", "query", "calls", "items", "culled", "per frame");
+	for (int i = 0; i < CurrentMap::QUERY_COUNT; i++) {
+		CurrentMap::QueryType type = static_cast<CurrentMap::QueryType>(i);
+		const CurrentMap::QueryStats &stats = map->getQueryStats(type);
+		debugPrintf("%-22s %8u %10u %10u %10u\n", CurrentMap::getQueryName(type),
+					stats._calls, stats._items, stats._culled, frames ? stats._calls / frames : 0);
+	}
+	return true;
+}
+
 bool Debugger::cmdStartHighlightItems(int argc, const char **argv) {
 	GameMapGump::Set_highlightItems(true);
 	return false;
@@ -689,7 +725,7 @@ void Debugger::dumpCurrentMap() {
 	// Work out the map limits in chunks
 	for (int32 y = 0; y < MAP_NUM_CHUNKS; y++) {
 		for (int32 x = 0; x < MAP_NUM_CHUNKS; x++) {
-			const Std::list<Item *> *list = curmap->getItemList(x, y);
+			const Std::vector<Item *> *list = curmap->getItemList(x, y);
 
 			// Should iterate the items!
 			// (items could extend outside of this chunk and they have height)
@@ -859,6 +895,19 @@ bool Debugger::cmdDecrementSortOrder(int argc, const char **argv) {
 	return false;
 }
 
+bool Debugger::cmdSortStats(int argc, const char **argv) {
+	const GameMapGump *gump = Ultima8Engine::get_instance()->getGameMapGump();
+	if (!gump) {
+		debugPrintf("No game map\n");
+		return true;
+	}
+
+	const ItemSorter::Stats &stats = gump->getDisplayList()->getStats();
+	debugPrintf("Last frame: %u items, %u comparisons, %u ms\n",
+				stats._items, stats._comparisons, stats._time);
+	return true;
+}
+
 
 bool Debugger::cmdProcessTypes(int argc, const char **argv) {
 	Kernel::get_instance()->processTypes();
@@ -1689,6 +1738,45 @@ bool Debugger::cmdStopTrace(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmdProfile(int argc, const char **argv) {
+	UCProfiler *profiler = UCMachine::get_instance()->getProfiler();
+	if (argc == 2 && !strcmp(argv[1], "on")) {
+		profiler->start();
+		debugPrintf("UCMachine: profiling usecode\n");
+	} else if (argc == 2 && !strcmp(argv[1], "off")) {
+		profiler->stop();
+		debugPrintf("UCMachine: profiling stopped\n");
+	} else if (argc == 2 && !strcmp(argv[1], "reset")) {
+		profiler->reset();
+		debugPrintf("UCMachine: profile cleared\n");
+	} else {
+		debugPrintf("Usage: UCMachine::profile on|off|reset\n");
+		debugPrintf("Profiling is %s\n", profiler->isActive() ? "on" : "off");
+	}
+	return true;
+}
+
+bool Debugger::cmdProfileReport(int argc, const char **argv) {
+	unsigned int count = 20;
+	if (argc == 2)
+		count = static_cast<unsigned int>(strtol(argv[1], 0, 0));
+
+	UCMachine::get_instance()->getProfiler()->printReport(count);
+	return true;
+}
+
+bool Debugger::cmdProfileDump(int argc, const char **argv) {
+	Std::string filename = "usecode_profile.folded";
+	if (argc == 2)
+		filename = argv[1];
+
+	if (UCMachine::get_instance()->getProfiler()->writeFolded(filename))
+		debugPrintf("Profile dumped: %s\n", filename.c_str());
+	else
+		debugPrintf("Could not write file: %s\n", filename.c_str());
+	return true;
+}
+
 bool Debugger::cmdVerifyQuit(int argc, const char **argv) {
 	QuitGump::verifyQuit();
 	return false;
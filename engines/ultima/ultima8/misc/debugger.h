@@ -104,6 +104,10 @@ private:
 	bool cmdHeal(int argc, const char **argv);
 	bool cmdToggleInvincibility(int argc, const char **argv);
 
+	// Current Map
+	bool cmdToggleQueryProfiling(int argc, const char **argv);
+	bool cmdQueryStats(int argc, const char **argv);
+
 	// Game Map Gump
 	bool cmdStartHighlightItems(int argc, const char **argv);
 	bool cmdStopHighlightItems(int argc, const char **argv);
@@ -113,6 +117,7 @@ private:
 	bool cmdDumpAllMaps(int argc, const char **argv);
 	bool cmdIncrementSortOrder(int argc, const char **argv);
 	bool cmdDecrementSortOrder(int argc, const char **argv);
+	bool cmdSortStats(int argc, const char **argv);
 
 	// Kernel
 	bool cmdProcessTypes(int argc, const char **argv);
@@ -172,6 +177,9 @@ private:
 	bool cmdTraceClass(int argc, const char **argv);
 	bool cmdTraceAll(int argc, const char **argv);
 	bool cmdStopTrace(int argc, const char **argv);
+	bool cmdProfile(int argc, const char **argv);
+	bool cmdProfileReport(int argc, const char **argv);
+	bool cmdProfileDump(int argc, const char **argv);
 
 	// Miscellaneous
 	bool cmdToggleFastArea(int argc, const char **argv);
@@ -36,6 +36,7 @@
 #include "ultima/ultima8/graphics/render_surface.h"
 #include "ultima/ultima8/games/game_data.h"
 #include "ultima/ultima8/world/world.h"
+#include "ultima/ultima8/world/current_map.h"
 #include "ultima/ultima8/world/get_object.h"
 #include "ultima/ultima8/filesys/savegame.h"
 #include "ultima/ultima8/gumps/game_map_gump.h"
@@ -594,10 +595,7 @@ Common::Error Ultima8Engine::runGame() {
 		_inBetweenFrame = true;  // Will get set false if it's not an _inBetweenFrame
 
 		if (!_frameLimit) {
-			for (unsigned int tick = 0; tick < Kernel::TICKS_PER_FRAME; tick++) {
-				_kernel->runProcesses();
-				_desktopGump->run();
-			}
+			runFrameTicks();
 			_inBetweenFrame = false;
 			next_ticks = _animationRate + _fastTicksNow();
 			_lerpFactor = 256;
@@ -607,10 +605,7 @@ Common::Error Ultima8Engine::runGame() {
 
 			while (diff < 0) {
 				next_ticks += _animationRate;
-				for (unsigned int tick = 0; tick < Kernel::TICKS_PER_FRAME; tick++) {
-					_kernel->runProcesses();
-					_desktopGump->run();
-				}
+				runFrameTicks();
 #if 0
 				debug(MM_INFO, "--- NEW FRAME ---");
 #endif
@@ -655,6 +650,22 @@ Common::Error Ultima8Engine::runGame() {
 	return Common::kNoError;
 }
 
+void Ultima8Engine::runFrameTicks() {
+	uint32 start = g_system->getMillis();
+
+	for (unsigned int tick = 0; tick < Kernel::TICKS_PER_FRAME; tick++) {
+		_kernel->runProcesses();
+		_desktopGump->run();
+	}
+
+	// Single queries mostly take well under a millisecond, so the
+	// profiler times the whole frame update they are made from. Loading
+	// a game during the ticks replaces the map, so look it up again.
+	CurrentMap *map = _world->getCurrentMap();
+	if (map && map->isQueryProfiling())
+		map->addQueryFrame(g_system->getMillis() - start);
+}
+
 // Paint the _screen
 void Ultima8Engine::paint() {
 #ifdef PAINT_TIMING
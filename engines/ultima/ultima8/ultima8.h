@@ -165,6 +165,9 @@ private:
 
 	void handleDelayedEvents();
 
+	//! run the processes and gumps for one frame's worth of ticks
+	void runFrameTicks();
+
 	bool pollEvent(Common::Event &event);
 protected:
 	// Engine APIs
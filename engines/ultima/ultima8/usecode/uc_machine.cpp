@@ -23,6 +23,7 @@
 
 #include "ultima/ultima8/usecode/uc_machine.h"
 #include "ultima/ultima8/usecode/uc_process.h"
+#include "ultima/ultima8/usecode/uc_profiler.h"
 #include "ultima/ultima8/usecode/usecode.h"
 #include "ultima/ultima8/kernel/kernel.h"
 #include "ultima/ultima8/kernel/delay_process.h"
@@ -104,6 +105,7 @@ UCMachine::UCMachine(Intrinsic *iset, unsigned int icount) {
 	}
 
 	loadIntrinsics(iset, icount); //!...
+	_profiler = new UCProfiler(_convUse->intrinsics(), icount);
 
 	_listIDs = new idMan(1, 65534, 128);
 	_stringIDs = new idMan(1, 65534, 256);
@@ -117,6 +119,7 @@ UCMachine::~UCMachine() {
 	debug(MM_INFO, "Destroying UCMachine...");
 	_ucMachine = nullptr;
 
+	delete _profiler;
 	delete _globals;
 	delete _convUse;
 	delete _listIDs;
@@ -168,10 +171,17 @@ void UCMachine::execProcess(UCProcess *p) {
 	bool error = false;
 	bool go_until_cede = false;
 
+	bool profile = _profiler->isActive();
+	if (profile)
+		_profiler->beginProcess();
+
 	while (!cede && !error && !p->is_terminated()) {
 		//! guard against reading past end of class
 		//! guard against other error conditions
 
+		if (profile)
+			_profiler->opcode(p);
+
 		uint8 opcode = cs->readByte();
 
 #ifdef DEBUG_USECODE
@@ -398,6 +408,8 @@ void UCMachine::execProcess(UCProcess *p) {
 				p->_stack.addSP(-arg_bytes); // don't really pop the args
 
 				p->_temp32 = _intrinsics[func](argbuf, arg_bytes);
+				if (profile)
+					_profiler->intrinsic(p, func);
 
 				delete[] argbuf;
 			}
@@ -433,6 +445,8 @@ void UCMachine::execProcess(UCProcess *p) {
 
 			p->_ip = static_cast<uint16>(cs->pos());   // Truncates!!
 			p->call(new_classid, new_offset);
+			if (profile)
+				_profiler->enterFunction(p);
 
 			// Update the code segment
 			uint32 base_ = p->_usecode->get_class_base_offset(p->_classId);
@@ -1253,6 +1267,8 @@ void UCMachine::execProcess(UCProcess *p) {
 				// So, we can't delete ourselves just yet.
 			} else {
 				TRACE_OP("%s\tret\t\tto %04X:%04X", op_info, p->_classId, p->_ip);
+				if (profile)
+					_profiler->leaveFunction(p);
 
 				// return value is stored in _temp32 register
 
@@ -1276,6 +1292,8 @@ void UCMachine::execProcess(UCProcess *p) {
 			if (!ui16b) {
 				ui16a = cs->pos() + si16a;
 				cs->seek(ui16a);
+				if (profile && si16a < 0)
+					_profiler->loop(p->_classId, ui16a);
 				TRACE_OP("%s\tjne\t\t%04hXh\t(to %04X) (taken)", op_info, si16a, cs->pos());
 			} else {
 				TRACE_OP("%s\tjne\t\t%04hXh\t(to %04X) (not taken)", op_info, si16a, cs->pos());
@@ -1288,6 +1306,8 @@ void UCMachine::execProcess(UCProcess *p) {
 			si16a = static_cast<int16>(cs->readUint16LE());
 			ui16a = cs->pos() + si16a;
 			cs->seek(ui16a);
+			if (profile && si16a < 0)
+				_profiler->loop(p->_classId, ui16a);
 			TRACE_OP("%s\tjmp\t\t%04hXh\t(to %04X)", op_info, si16a, cs->pos());
 			break;
 
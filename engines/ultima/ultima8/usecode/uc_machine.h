@@ -36,6 +36,7 @@ class UCProcess;
 class ConvertUsecode;
 class GlobalStorage;
 class UCList;
+class UCProfiler;
 class idMan;
 
 class UCMachine {
@@ -63,6 +64,10 @@ public:
 
 	void usecodeStats() const;
 
+	UCProfiler *getProfiler() const {
+		return _profiler;
+	}
+
 	static uint32 listToPtr(uint16 l);
 	static uint32 stringToPtr(uint16 s);
 	static uint32 stackToPtr(uint16 pid, uint16 offset);
@@ -119,6 +124,9 @@ private:
 	Std::set<ProcId> _tracePIDs;
 	Std::set<uint16> _traceClasses;
 
+	// profiling
+	UCProfiler *_profiler;
+
 	inline bool trace_show(ProcId pid, ObjId objid, uint16 ucclass) {
 		if (!_tracingEnabled) return false;
 		if (_traceAll) return true;
@@ -21,6 +21,7 @@
 
 #include "ultima/ultima8/usecode/uc_process.h"
 #include "ultima/ultima8/usecode/uc_machine.h"
+#include "ultima/ultima8/usecode/uc_profiler.h"
 #include "ultima/ultima8/usecode/usecode.h"
 #include "ultima/ultima8/games/game_data.h"
 
@@ -53,6 +54,7 @@ void UCProcess::load(uint16 classid, uint16 offset, uint32 this_ptr,
 	_classId = 0xFFFF;
 	_ip = 0xFFFF;
 	_bp = 0x0000;
+	_funcStack.clear();
 	uint16 thissp = 0;
 
 	// first, push the derefenced this pointer
@@ -72,6 +74,10 @@ void UCProcess::load(uint16 classid, uint16 offset, uint32 this_ptr,
 
 	// finally, call the specified function
 	call(classid, offset);
+
+	UCProfiler *profiler = UCMachine::get_instance()->getProfiler();
+	if (profiler->isActive())
+		profiler->enterFunction(this);
 }
 
 void UCProcess::run() {
@@ -33,6 +33,7 @@ class Usecode;
 // probably won't inherit from Process directly in the future
 class UCProcess : public Process {
 	friend class UCMachine;
+	friend class UCProfiler;
 	friend class Kernel;
 public:
 	UCProcess();
@@ -76,6 +77,14 @@ protected:
 	// data stack
 	UCStack _stack;
 
+	// The functions in the call stack, for the profiler. Only kept while
+	// the profiler runs and not saved, so callers may be missing.
+	struct FuncFrame {
+		uint32 _key; //!< class << 16 | function offset
+		uint16 _bp;  //!< base pointer of the function's frame
+	};
+	Std::vector<FuncFrame> _funcStack;
+
 	// "Free Me" list
 	Std::list<Common::Pair<uint16, int> > _freeOnTerminate;
 };
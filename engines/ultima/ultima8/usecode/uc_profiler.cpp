@@ -0,0 +1,231 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/algorithm.h"
+#include "common/file.h"
+#include "ultima/ultima8/usecode/uc_profiler.h"
+#include "ultima/ultima8/usecode/uc_process.h"
+#include "ultima/ultima8/usecode/usecode.h"
+#include "ultima/ultima8/games/game_data.h"
+#include "ultima/ultima8/misc/debugger.h"
+
+namespace Ultima {
+namespace Ultima8 {
+
+UCProfiler::UCProfiler(const char *const *intrinsicNames, unsigned int intrinsicCount)
+	: _intrinsicNames(intrinsicNames), _intrinsicCount(intrinsicCount),
+	  _active(false), _lastMillis(0), _totalMillis(0), _totalOpcodes(0),
+	  _lastKey(0), _lastFunction(nullptr) {
+}
+
+UCProfiler::~UCProfiler() {
+}
+
+void UCProfiler::start() {
+	_active = true;
+	_lastMillis = g_system->getMillis();
+}
+
+void UCProfiler::stop() {
+	_active = false;
+}
+
+void UCProfiler::reset() {
+	_totalMillis = 0;
+	_totalOpcodes = 0;
+	_lastFunction = nullptr;
+	_functions.clear();
+	_intrinsics.clear();
+	_loops.clear();
+	_stacks.clear();
+}
+
+void UCProfiler::enterFunction(UCProcess *p) {
+	// The stack grows down, so frames at or below the new one are left over
+	// from before the profiler was last stopped
+	while (!p->_funcStack.empty() && p->_funcStack.back()._bp <= p->_bp)
+		p->_funcStack.pop_back();
+
+	UCProcess::FuncFrame frame;
+	frame._key = (static_cast<uint32>(p->_classId) << 16) | p->_ip;
+	frame._bp = p->_bp;
+	p->_funcStack.push_back(frame);
+}
+
+void UCProfiler::leaveFunction(UCProcess *p) {
+	while (!p->_funcStack.empty() && p->_funcStack.back()._bp < p->_bp)
+		p->_funcStack.pop_back();
+}
+
+uint32 UCProfiler::functionKey(const UCProcess *p) {
+	if (p->_funcStack.empty() || p->_funcStack.back()._bp != p->_bp)
+		return (static_cast<uint32>(p->_classId) << 16) | 0xFFFF;
+	return p->_funcStack.back()._key;
+}
+
+void UCProfiler::opcode(const UCProcess *p) {
+	uint32 key = functionKey(p);
+	if (!_lastFunction || key != _lastKey) {
+		_lastKey = key;
+		_lastFunction = &_functions[key];
+	}
+	_lastFunction->_opcodes++;
+	_totalOpcodes++;
+
+	uint32 now = g_system->getMillis();
+	if (now != _lastMillis) {
+		sample(p, now - _lastMillis, -1);
+		_lastMillis = now;
+	}
+}
+
+void UCProfiler::intrinsic(const UCProcess *p, uint16 func) {
+	_intrinsics[func]._calls++;
+
+	uint32 now = g_system->getMillis();
+	if (now != _lastMillis) {
+		sample(p, now - _lastMillis, func);
+		_lastMillis = now;
+	}
+}
+
+void UCProfiler::loop(uint16 classId, uint16 target) {
+	_loops[(static_cast<uint32>(classId) << 16) | target]++;
+}
+
+void UCProfiler::sample(const UCProcess *p, uint32 millis, int intrinsic) {
+	_totalMillis += millis;
+
+	FunctionStats &function = _functions[functionKey(p)];
+	if (intrinsic >= 0) {
+		function._intrinsicMillis += millis;
+		_intrinsics[intrinsic]._millis += millis;
+	} else {
+		function._millis += millis;
+	}
+
+	Common::String stack;
+	for (unsigned int i = 0; i < p->_funcStack.size(); i++) {
+		if (i > 0)
+			stack += ';';
+		stack += Common::String::format("%08X", p->_funcStack[i]._key);
+	}
+	uint32 key = functionKey(p);
+	if (p->_funcStack.empty() || key != p->_funcStack.back()._key)
+		stack += Common::String::format(stack.empty() ? "%08X" : ";%08X", key);
+	if (intrinsic >= 0)
+		stack += Common::String::format(";I%04X", intrinsic);
+	_stacks[stack] += millis;
+}
+
+Std::string UCProfiler::frameName(uint32 key) const {
+	uint16 classId = key >> 16;
+	uint16 offset = key & 0xFFFF;
+	const char *name = GameData::get_instance()->getMainUsecode()->get_class_name(classId);
+	Std::string className = (name && *name) ? Std::string(name) : Std::string::format("%04X", classId);
+	if (offset == 0xFFFF)
+		return className + "::?";
+	return className + Std::string::format("::%04X", offset);
+}
+
+Std::string UCProfiler::intrinsicName(uint16 func) const {
+	if (func < _intrinsicCount && _intrinsicNames[func])
+		return Std::string::format("%04X %s", func, _intrinsicNames[func]);
+	return Std::string::format("%04X", func);
+}
+
+namespace {
+
+struct SortFunctions {
+	bool operator()(const Common::Pair<uint32, uint32> &a, const Common::Pair<uint32, uint32> &b) const {
+		return a.second > b.second;
+	}
+};
+
+} // End of anonymous namespace
+
+void UCProfiler::printReport(unsigned int count) const {
+	g_debugger->debugPrintf("Usecode profile: %u ms sampled, %u opcodes\n", _totalMillis, _totalOpcodes);
+
+	// Functions by their own time and then by opcodes
+	Common::Array<Common::Pair<uint32, uint32> > functions;
+	for (Common::HashMap<uint32, FunctionStats>::const_iterator i = _functions.begin(); i != _functions.end(); ++i)
+		functions.push_back(Common::Pair<uint32, uint32>(i->_key, i->_value._millis + i->_value._intrinsicMillis));
+	Common::sort(functions.begin(), functions.end(), SortFunctions());
+	g_debugger->debugPrintf("\nFunctions:      ms  intr. ms     opcodes\n");
+	for (unsigned int i = 0; i < functions.size() && i < count; i++) {
+		const FunctionStats &stats = _functions[functions[i].first];
+		g_debugger->debugPrintf("%8u %10u %12u  %s\n", stats._millis, stats._intrinsicMillis,
+		                        stats._opcodes, frameName(functions[i].first).c_str());
+	}
+
+	Common::Array<Common::Pair<uint32, uint32> > intrinsics;
+	for (Common::HashMap<uint16, IntrinsicStats>::const_iterator i = _intrinsics.begin(); i != _intrinsics.end(); ++i)
+		intrinsics.push_back(Common::Pair<uint32, uint32>(i->_key, i->_value._millis));
+	Common::sort(intrinsics.begin(), intrinsics.end(), SortFunctions());
+	g_debugger->debugPrintf("\nIntrinsics:     ms       calls\n");
+	for (unsigned int i = 0; i < intrinsics.size() && i < count; i++) {
+		const IntrinsicStats &stats = _intrinsics[intrinsics[i].first];
+		g_debugger->debugPrintf("%8u %12u  %s\n", stats._millis, stats._calls,
+		                        intrinsicName(intrinsics[i].first).c_str());
+	}
+
+	Common::Array<Common::Pair<uint32, uint32> > loops;
+	for (Common::HashMap<uint32, uint32>::const_iterator i = _loops.begin(); i != _loops.end(); ++i)
+		loops.push_back(Common::Pair<uint32, uint32>(i->_key, i->_value));
+	Common::sort(loops.begin(), loops.end(), SortFunctions());
+	g_debugger->debugPrintf("\nLoops:  iterations\n");
+	for (unsigned int i = 0; i < loops.size() && i < count; i++) {
+		g_debugger->debugPrintf("%12u  %s\n", loops[i].second, frameName(loops[i].first).c_str());
+	}
+}
+
+bool UCProfiler::writeFolded(const Std::string &filename) const {
+	Common::DumpFile dumpFile;
+	if (!dumpFile.open(filename))
+		return false;
+
+	for (Common::HashMap<Common::String, uint32>::const_iterator i = _stacks.begin(); i != _stacks.end(); ++i) {
+		Std::string line;
+		const char *frame = i->_key.c_str();
+		while (*frame) {
+			if (!line.empty())
+				line += ';';
+			if (*frame == 'I')
+				line += intrinsicName(strtol(frame + 1, nullptr, 16));
+			else
+				line += frameName(strtoul(frame, nullptr, 16));
+			frame = strchr(frame, ';');
+			if (!frame)
+				break;
+			frame++;
+		}
+		line += Std::string::format(" %u\n", i->_value);
+		dumpFile.writeString(line);
+	}
+
+	dumpFile.flush();
+	return !dumpFile.err();
+}
+
+} // End of namespace Ultima8
+} // End of namespace Ultima
@@ -0,0 +1,128 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef ULTIMA8_USECODE_UCPROFILER_H
+#define ULTIMA8_USECODE_UCPROFILER_H
+
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/system.h"
+#include "ultima/shared/std/containers.h"
+#include "ultima/shared/std/string.h"
+
+namespace Ultima {
+namespace Ultima8 {
+
+class UCProcess;
+
+//! Opt-in profiler for the usecode interpreter.
+//! Whenever the millisecond clock moves on while usecode runs, the elapsed
+//! time is charged to the running function (class and offset), or to the
+//! intrinsic that was just called, and to the whole call stack.
+//! Executed opcodes, intrinsic calls and backward jumps are counted too.
+class UCProfiler {
+public:
+	UCProfiler(const char *const *intrinsicNames, unsigned int intrinsicCount);
+	~UCProfiler();
+
+	void start();
+	void stop();
+	void reset();
+	bool isActive() const {
+		return _active;
+	}
+
+	//! Start timing a process, so time spent outside usecode isn't counted
+	void beginProcess() {
+		_lastMillis = g_system->getMillis();
+	}
+
+	//! Record the function the process just called, so samples can name it
+	//! and its callers
+	void enterFunction(UCProcess *p);
+
+	//! Forget the function the process just returned from
+	void leaveFunction(UCProcess *p);
+
+	//! Count an opcode of the process' current function, and sample the clock
+	void opcode(const UCProcess *p);
+
+	//! Count a finished intrinsic call, and charge it the time since the
+	//! last opcode
+	void intrinsic(const UCProcess *p, uint16 func);
+
+	//! Count a backward jump, i.e. a loop iteration
+	//! \param target class offset the jump went to
+	void loop(uint16 classId, uint16 target);
+
+	//! Print the busiest functions, intrinsics and loops to the debugger
+	//! \param count maximum number of lines in each list
+	void printReport(unsigned int count) const;
+
+	//! Write the sampled call stacks as "frame;frame;... milliseconds" lines,
+	//! as read by flame graph tools
+	bool writeFolded(const Std::string &filename) const;
+
+private:
+	struct FunctionStats {
+		uint32 _opcodes;
+		uint32 _millis; // time in the function itself, without intrinsics
+		uint32 _intrinsicMillis;
+		FunctionStats() : _opcodes(0), _millis(0), _intrinsicMillis(0) {}
+	};
+	struct IntrinsicStats {
+		uint32 _calls;
+		uint32 _millis;
+		IntrinsicStats() : _calls(0), _millis(0) {}
+	};
+
+	//! class << 16 | function offset of the running function, or the class
+	//! with offset FFFF if the function isn't known (it was called before
+	//! the profiler started, or a game was loaded)
+	static uint32 functionKey(const UCProcess *p);
+	void sample(const UCProcess *p, uint32 millis, int intrinsic);
+	Std::string frameName(uint32 key) const;
+	Std::string intrinsicName(uint16 func) const;
+
+	const char *const *_intrinsicNames;
+	unsigned int _intrinsicCount;
+
+	bool _active;
+	uint32 _lastMillis;
+	uint32 _totalMillis;
+	uint32 _totalOpcodes;
+
+	// the stats of the last function that ran, to avoid a lookup per opcode
+	uint32 _lastKey;
+	FunctionStats *_lastFunction;
+
+	Common::HashMap<uint32, FunctionStats> _functions;
+	Common::HashMap<uint16, IntrinsicStats> _intrinsics;
+	Common::HashMap<uint32, uint32> _loops;
+	//! call stacks, as frame keys in hex, with an intrinsic number as leaf
+	Common::HashMap<Common::String, uint32> _stacks;
+};
+
+} // End of namespace Ultima8
+} // End of namespace Ultima
+
+#endif
@@ -19,6 +19,7 @@
  *
  */
 
+#include "common/system.h"
 #include "ultima/ultima.h"
 #include "ultima/ultima8/misc/debugger.h"
 #include "ultima/ultima8/world/current_map.h"
@@ -46,13 +47,56 @@
 namespace Ultima {
 namespace Ultima8 {
 
-typedef Std::list<Item *> item_list;
+typedef Std::vector<Item *> item_list;
 
 const int INT_MAX_VALUE = 0x7fffffff;
 const int INT_MIN_VALUE = -INT_MAX_VALUE - 1;
 
+/**
+ * Counts the items a spatial query looks at, and adds them to the
+ * CurrentMap query stats when the query ends if profiling is enabled.
+ */
+class QueryProfile {
+public:
+	QueryProfile(const CurrentMap *map, CurrentMap::QueryType type) :
+		_items(0), _culled(0), _map(map), _type(type) {
+	}
+
+	~QueryProfile() {
+		if (!_map->_queryProfiling)
+			return;
+
+		CurrentMap::QueryStats &stats = _map->_queryStats[_type];
+		stats._calls++;
+		stats._items += _items;
+		stats._culled += _culled;
+	}
+
+	uint32 _items;
+	uint32 _culled;
+
+private:
+	const CurrentMap *_map;
+	CurrentMap::QueryType _type;
+};
+
+// Index of the item to visit after calling into item at index i while
+// walking a chunk. Handles the item removing itself, or items being
+// inserted at the front of the chunk, as a linked list would.
+static unsigned int nextItemIndex(const item_list &items, unsigned int i, const Item *item) {
+	if (i < items.size() && items[i] == item)
+		return i + 1;
+
+	for (unsigned int j = 0; j < items.size(); j++) {
+		if (items[j] == item)
+			return j + 1;
+	}
+	return i;
+}
+
 CurrentMap::CurrentMap() : _currentMap(0), _eggHatcher(0),
-	  _fastXMin(-1), _fastYMin(-1), _fastXMax(-1), _fastYMax(-1) {
+	  _fastXMin(-1), _fastYMin(-1), _fastXMax(-1), _fastYMax(-1),
+	  _queryProfiling(false), _queryFrames(0), _queryFrameTime(0) {
 	for (unsigned int i = 0; i < MAP_NUM_CHUNKS; i++) {
 		memset(_fast[i], false, sizeof(uint32)*MAP_NUM_CHUNKS / 32);
 	}
@@ -68,6 +112,8 @@ CurrentMap::CurrentMap() : _currentMap(0), _eggHatcher(0),
 	for (unsigned int i = 0; i < MAP_NUM_TARGET_ITEMS; i++) {
 		_targets[i] = 0;
 	}
+
+	memset(_queryStats, 0, sizeof(_queryStats));
 }
 
 
@@ -161,7 +207,7 @@ void CurrentMap::writeback() {
 }
 
 void CurrentMap::loadItems(const Std::list<Item *> &itemlist, bool callCacheIn) {
-	item_list::const_iterator iter;
+	Std::list<Item *>::const_iterator iter;
 	for (iter = itemlist.begin(); iter != itemlist.end(); ++iter) {
 		Item *item = *iter;
 
@@ -258,7 +304,7 @@ void CurrentMap::addItem(Item *item) {
 	}
 #endif
 
-	_items[cx][cy].push_front(item);
+	_items[cx][cy].insert_at(0, item);
 	item->setExtFlag(Item::EXT_INCURMAP);
 
 	Egg *egg = dynamic_cast<Egg *>(item);
@@ -411,7 +457,13 @@ void CurrentMap::removeItemFromList(Item *item, int32 oldx, int32 oldy) {
 	int32 cx = oldx / _mapChunkSize;
 	int32 cy = oldy / _mapChunkSize;
 
-	_items[cx][cy].remove(item);
+	item_list &items = _items[cx][cy];
+	for (item_list::iterator iter = items.begin(); iter != items.end(); ++iter) {
+		if (*iter == item) {
+			items.erase(iter);
+			break;
+		}
+	}
 	item->clearExtFlag(Item::EXT_INCURMAP);
 }
 
@@ -524,20 +576,22 @@ void CurrentMap::updateFastArea(int32 from_x, int32 from_y, int32 from_z, int32
 void CurrentMap::setChunkFast(int32 cx, int32 cy) {
 	_fast[cy][cx / 32] |= 1 << (cx & 31);
 
-	item_list::iterator iter;
-	for (iter = _items[cx][cy].begin();
-	        iter != _items[cx][cy].end(); ++iter) {
-		(*iter)->enterFastArea();
+	const item_list &items = _items[cx][cy];
+	unsigned int i = 0;
+	while (i < items.size()) {
+		Item *item = items[i];
+		item->enterFastArea();
+		i = nextItemIndex(items, i, item);
 	}
 }
 
 void CurrentMap::unsetChunkFast(int32 cx, int32 cy) {
 	_fast[cy][cx / 32] &= ~(1 << (cx & 31));
 
-	item_list::iterator iter = _items[cx][cy].begin();
-	while (iter != _items[cx][cy].end()) {
-		Item *item = *iter;
-		++iter;
+	const item_list &items = _items[cx][cy];
+	unsigned int i = 0;
+	while (i < items.size()) {
+		Item *item = items[i];
 #ifdef VALIDATE_CHUNKS
 		int32 x, y, z;
 		item->getLocation(x, y, z);
@@ -547,6 +601,7 @@ void CurrentMap::unsetChunkFast(int32 cx, int32 cy) {
 		}
 #endif
 		item->leaveFastArea();  // Can destroy the item
+		i = nextItemIndex(items, i, item);
 	}
 }
 
@@ -560,6 +615,7 @@ inline void CurrentMap::clipMapChunks(int &minx, int &maxx, int &miny, int &maxy
 void CurrentMap::areaSearch(UCList *itemlist, const uint8 *loopscript,
 							uint32 scriptsize, const Item *check, uint16 range,
 							bool recurse, int32 x, int32 y) const {
+	QueryProfile profile(this, QUERY_AREA_SEARCH);
 	int32 xd = 0, yd = 0;
 
 	// if item != 0, search an area around item. Otherwise, search an area
@@ -602,6 +658,7 @@ void CurrentMap::areaSearch(UCList *itemlist, const uint8 *loopscript,
 			        iter != _items[cx][cy].end(); ++iter) {
 
 				const Item *item = *iter;
+				profile._items++;
 
 				if (item->hasExtFlags(Item::EXT_SPRITE))
 					continue;
@@ -637,6 +694,7 @@ void CurrentMap::surfaceSearch(UCList *itemlist, const uint8 *loopscript,
 	check->getLocationAbsolute(x, y, z);
 	check->getFootpadWorld(xd, yd, zd);
 	const Box searchrange(x, y, z, xd, yd, zd);
+	QueryProfile profile(this, QUERY_SURFACE_SEARCH);
 
 	int minx = ((x - xd) / _mapChunkSize) - 1;
 	int maxx = (x / _mapChunkSize) + 1;
@@ -651,12 +709,22 @@ void CurrentMap::surfaceSearch(UCList *itemlist, const uint8 *loopscript,
 			        iter != _items[cx][cy].end(); ++iter) {
 
 				const Item *item = *iter;
+				profile._items++;
 
 				if (item->getObjId() == check->getObjId())
 					continue;
 				if (item->hasExtFlags(Item::EXT_SPRITE))
 					continue;
 
+				// Items extend back from their location in x and y and up
+				// from it in z, so some can be rejected without their shape
+				int32 ix, iy, iz;
+				item->getLocation(ix, iy, iz);
+				if (ix <= x - xd || iy <= y - yd || (!below && iz != z + zd)) {
+					profile._culled++;
+					continue;
+				}
+
 				// check if item is in range?
 				const Box ib = item->getWorldBox();
 				if (searchrange.overlapsXY(ib)) {
@@ -706,7 +774,7 @@ TeleportEgg *CurrentMap::findDestination(uint16 id) {
 	return nullptr;
 }
 
-const Std::list<Item *> *CurrentMap::getItemList(int32 gx, int32 gy) const {
+const Std::vector<Item *> *CurrentMap::getItemList(int32 gx, int32 gy) const {
 	if (gx < 0 || gy < 0 || gx >= MAP_NUM_CHUNKS || gy >= MAP_NUM_CHUNKS)
 		return nullptr;
 	return &_items[gx][gy];
@@ -737,6 +805,8 @@ PositionInfo CurrentMap::getPositionInfo(const Box &target, const Box &start, ui
 	int32 midx = target._x - target._xd / 2;
 	int32 midy = target._y - target._yd / 2;
 
+	QueryProfile profile(this, QUERY_POSITION_INFO);
+
 	int minx = ((target._x - target._xd) / _mapChunkSize) - 1;
 	int maxx = (target._x / _mapChunkSize) + 1;
 	int miny = ((target._y - target._yd) / _mapChunkSize) - 1;
@@ -749,11 +819,21 @@ PositionInfo CurrentMap::getPositionInfo(const Box &target, const Box &start, ui
 			for (iter = _items[cx][cy].begin();
 				 iter != _items[cx][cy].end(); ++iter) {
 				const Item *item = *iter;
+				profile._items++;
 				if (item->getObjId() == id)
 					continue;
 				if (item->hasExtFlags(Item::EXT_SPRITE))
 					continue;
 
+				// Items entirely behind the target in x or y can neither
+				// overlap it nor be below its center
+				int32 ix, iy, iz;
+				item->getLocation(ix, iy, iz);
+				if (ix < target._x - target._xd || iy < target._y - target._yd) {
+					profile._culled++;
+					continue;
+				}
+
 				const ShapeInfo *si = item->getShapeInfo();
 				if (!(si->_flags & flagmask))
 					continue; // not an interesting item
@@ -857,23 +937,35 @@ bool CurrentMap::scanForValidPosition(int32 x, int32 y, int32 z, const Item *ite
 	int maxy = (y / _mapChunkSize) + 1;
 	clipMapChunks(minx, maxx, miny, maxy);
 
+	QueryProfile profile(this, QUERY_SCAN_VALID_POSITION);
+
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
 			for (item_list::const_iterator iter = _items[cx][cy].begin();
 			        iter != _items[cx][cy].end(); ++iter) {
 				const Item *citem = *iter;
+				profile._items++;
 				if (citem->getObjId() == item->getObjId())
 					continue;
 				if (citem->hasExtFlags(Item::EXT_SPRITE))
 					continue;
 
+				int32 ix, iy, iz, ixd, iyd, izd;
+				citem->getLocation(ix, iy, iz);
+
+				// Items too far behind or above the scanned area can't mark
+				// any of it, whatever their shape
+				if (ix + xd - 1 - x < -scansize || iy + yd - 1 - y < -scansize ||
+				        (iz - z - zd + 1 > scansize && iz - z > scansize)) {
+					profile._culled++;
+					continue;
+				}
+
 				const ShapeInfo *si = citem->getShapeInfo();
 				//!! need to check is_sea() and is_land() maybe?
 				if (!(si->_flags & blockflagmask))
 					continue; // not an interesting item
 
-				int32 ix, iy, iz, ixd, iyd, izd;
-				citem->getLocation(ix, iy, iz);
 				citem->getFootpadWorld(ixd, iyd, izd);
 
 				int minv = iz - z - zd + 1;
@@ -1027,6 +1119,14 @@ bool CurrentMap::sweepTest(const int32 start[3], const int32 end[3],
 	// Z is opposite direction to x and y..
 	centre[2] = start[2] + ext[2];
 
+	// Bounds of the whole sweep. Items more than a unit behind it in x or y,
+	// or above it in z, can neither be hit nor touched.
+	const int32 sweepMinX = MIN(start[0], end[0]) - dims[0];
+	const int32 sweepMinY = MIN(start[1], end[1]) - dims[1];
+	const int32 sweepMaxZ = MAX(start[2], end[2]) + dims[2];
+
+	QueryProfile profile(this, QUERY_SWEEP_TEST);
+
 	debugC(kDebugCollision, "Sweeping from (%d, %d, %d) - (%d, %d, %d) to (%d, %d, %d) - (%d, %d, %d)",
 		   -ext[0], -ext[1], -ext[2],
 		   ext[0], ext[1], ext[2],
@@ -1042,11 +1142,20 @@ bool CurrentMap::sweepTest(const int32 start[3], const int32 end[3],
 			for (iter = _items[cx][cy].begin();
 			        iter != _items[cx][cy].end(); ++iter) {
 				const Item *other_item = *iter;
+				profile._items++;
 				if (other_item->getObjId() == item)
 					continue;
 				if (other_item->hasExtFlags(Item::EXT_SPRITE))
 					continue;
 
+				int32 other[3], oext[3];
+				other_item->getLocation(other[0], other[1], other[2]);
+				if (other[0] < sweepMinX - 1 || other[1] < sweepMinY - 1 ||
+				        other[2] > sweepMaxZ + 1) {
+					profile._culled++;
+					continue;
+				}
+
 				uint32 othershapeflags = other_item->getShapeInfo()->_flags;
 				bool blocking = (othershapeflags & shapeflags &
 				                 blockflagmask) != 0;
@@ -1056,8 +1165,6 @@ bool CurrentMap::sweepTest(const int32 start[3], const int32 end[3],
 				if (blocking_only && !blocking)
 					continue;
 
-				int32 other[3], oext[3];
-				other_item->getLocation(other[0], other[1], other[2]);
 				other_item->getFootpadWorld(oext[0], oext[1], oext[2]);
 
 				// If the objects overlapped at the start, ignore collision.
@@ -1228,6 +1335,23 @@ void CurrentMap::setWholeMapFast() {
 	_fastYMax = -1;
 }
 
+void CurrentMap::setQueryProfiling(bool enabled) {
+	_queryProfiling = enabled;
+	if (enabled) {
+		memset(_queryStats, 0, sizeof(_queryStats));
+		_queryFrames = 0;
+		_queryFrameTime = 0;
+	}
+}
+
+const char *CurrentMap::getQueryName(QueryType type) {
+	static const char *const names[QUERY_COUNT] = {
+		"areaSearch", "surfaceSearch", "getPositionInfo",
+		"scanForValidPosition", "sweepTest"
+	};
+	return names[type];
+}
+
 void CurrentMap::save(Common::WriteStream *ws) {
 	for (unsigned int i = 0; i < MAP_NUM_CHUNKS; ++i) {
 		for (unsigned int j = 0; j < MAP_NUM_CHUNKS / 32; ++j) {
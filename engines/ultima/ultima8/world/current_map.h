@@ -168,7 +168,7 @@ public:
 	TeleportEgg *findDestination(uint16 id);
 
 	// Not allowed to modify the list. Remember to use const_iterator
-	const Std::list<Item *> *getItemList(int32 gx, int32 gy) const;
+	const Std::vector<Item *> *getItemList(int32 gx, int32 gy) const;
 
 	bool isChunkFast(int32 cx, int32 cy) const {
 		// CONSTANTS!
@@ -183,10 +183,50 @@ public:
 	void save(Common::WriteStream *ws);
 	bool load(Common::ReadStream *rs, uint32 version);
 
+	//! The spatial queries measured by the query profiler
+	enum QueryType {
+		QUERY_AREA_SEARCH = 0,
+		QUERY_SURFACE_SEARCH,
+		QUERY_POSITION_INFO,
+		QUERY_SCAN_VALID_POSITION,
+		QUERY_SWEEP_TEST,
+		QUERY_COUNT
+	};
+
+	struct QueryStats {
+		uint32 _calls;
+		uint32 _items;  //!< items examined
+		uint32 _culled; //!< items rejected from their location alone
+	};
+
+	//! Start or stop collecting QueryStats. Starting resets the stats.
+	void setQueryProfiling(bool enabled);
+	bool isQueryProfiling() const {
+		return _queryProfiling;
+	}
+	const QueryStats &getQueryStats(QueryType type) const {
+		return _queryStats[type];
+	}
+	static const char *getQueryName(QueryType type);
+
+	//! Record the milliseconds spent updating the world for one frame
+	void addQueryFrame(uint32 time) {
+		_queryFrames++;
+		_queryFrameTime += time;
+	}
+	uint32 getQueryFrames() const {
+		return _queryFrames;
+	}
+	uint32 getQueryFrameTime() const {
+		return _queryFrameTime;
+	}
+
 	INTRINSIC(I_canExistAt);
 	INTRINSIC(I_canExistAtPoint);
 
 private:
+	friend class QueryProfile;
+
 	void loadItems(const Std::list<Item *> &itemlist, bool callCacheIn);
 	void createEggHatcher();
 
@@ -197,7 +237,9 @@ private:
 
 	// item lists. Lots of them :-)
 	// items[x][y]
-	Std::list<Item *> _items[MAP_NUM_CHUNKS][MAP_NUM_CHUNKS];
+	// These are arrays rather than linked lists, as the spatial queries
+	// walk them far more often than items are added or removed.
+	Std::vector<Item *> _items[MAP_NUM_CHUNKS][MAP_NUM_CHUNKS];
 
 	ProcId _eggHatcher;
 
@@ -211,6 +253,11 @@ private:
 	//! this in a more fancy data structure, but this works fine.
 	ObjId _targets[MAP_NUM_TARGET_ITEMS];
 
+	bool _queryProfiling;
+	mutable QueryStats _queryStats[QUERY_COUNT];
+	uint32 _queryFrames;
+	uint32 _queryFrameTime;
+
 	void setChunkFast(int32 cx, int32 cy);
 	void unsetChunkFast(int32 cx, int32 cy);
 };
@@ -19,6 +19,8 @@
  *
  */
 
+#include "common/algorithm.h"
+#include "common/system.h"
 #include "ultima/ultima.h"
 #include "ultima/ultima8/misc/common_types.h"
 #include "ultima/ultima8/world/item_sorter.h"
@@ -45,25 +47,35 @@ namespace Ultima8 {
 static const uint32 TRANSPARENT_COLOR = TEX32_PACK_RGBA(0x7F, 0x00, 0x00, 0x7F);
 static const uint32 HIGHLIGHT_COLOR = TEX32_PACK_RGBA(0xFF, 0xFF, 0x00, 0x1F);
 
+// Order of the display list: by listLessThan, and in the order they were
+// added for items which compare equal.
+static bool ListOrderLess(const SortItem *si1, const SortItem *si2) {
+	if (si1->listLessThan(*si2))
+		return true;
+	if (si2->listLessThan(*si1))
+		return false;
+	return si1->_addOrder < si2->_addOrder;
+}
+
 ItemSorter::ItemSorter(int capacity) :
 	_shapes(nullptr), _clipWindow(0, 0, 0, 0), _items(nullptr), _itemsTail(nullptr),
-	_itemsUnused(nullptr), _painted(nullptr), _camSx(0), _camSy(0),
-	_sortLimit(0), _sortLimitChanged(false) {
+	_itemsUnused(nullptr), _painted(nullptr), _listSorted(true),
+	_gridCellWidth(1), _gridCellHeight(1), _stamp(0), _startTime(0),
+	_camSx(0), _camSy(0), _sortLimit(0), _sortLimitChanged(false) {
 	int i = capacity;
 	while (i--) {
 		SortItem *next = _itemsUnused;
 		_itemsUnused = new SortItem();
 		_itemsUnused->_next = next;
 	}
+	_added.reserve(capacity);
+
+	memset(&_stats, 0, sizeof(_stats));
+	memset(&_lastStats, 0, sizeof(_lastStats));
 }
 
 ItemSorter::~ItemSorter() {
-	if (_itemsTail) {
-		_itemsTail->_next = _itemsUnused;
-		_itemsUnused = _items;
-	}
-	_items = nullptr;
-	_itemsTail = nullptr;
+	ClearDisplayList();
 
 	while (_itemsUnused) {
 		SortItem *next = _itemsUnused->_next;
@@ -79,15 +91,16 @@ void ItemSorter::BeginDisplayList(const Rect &clipWindow, int32 camx, int32 camy
 	// Set the clip window, and reset the item list
 	_clipWindow = clipWindow;
 
-	if (_itemsTail) {
-		_itemsTail->_next = _itemsUnused;
-		_itemsUnused = _items;
-	}
-
-	_items = nullptr;
-	_itemsTail = nullptr;
+	ClearDisplayList();
 	_painted = nullptr;
 
+	_gridCellWidth = MAX<int32>(1, (_clipWindow.right - _clipWindow.left + GRID_SIZE - 1) / GRID_SIZE);
+	_gridCellHeight = MAX<int32>(1, (_clipWindow.bottom - _clipWindow.top + GRID_SIZE - 1) / GRID_SIZE);
+
+	_lastStats = _stats;
+	memset(&_stats, 0, sizeof(_stats));
+	_startTime = g_system->getMillis();
+
 	// Screenspace bounding box bottom x coord (RNB x coord)
 	int32 camSx = (camx - camy) / 4;
 	// Screenspace bounding box bottom extent  (RNB y coord)
@@ -187,17 +200,33 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 	// are never deleted
 	si->_depends.clear();
 
-	// Iterate the list and compare _shapes
-
-	// Ok,
-	SortItem *addpoint = nullptr;
-	for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next) {
-		// Get the insert point... which is before the first item that has higher z than us
-		if (!addpoint && si->listLessThan(*si2))
-			addpoint = si2;
+	// Gather the items that may overlap us on screen. Occluded items are
+	// never painted, so there is no need to compare them.
+	int cx1, cy1, cx2, cy2;
+	GetGridCells(si->_sr, cx1, cy1, cx2, cy2);
+
+	_stamp++;
+	_candidates.resize(0);
+	for (int cy = cy1; cy <= cy2; cy++) {
+		for (int cx = cx1; cx <= cx2; cx++) {
+			const Common::Array<SortItem *> &cell = _grid[cy][cx];
+			for (uint i = 0; i < cell.size(); i++) {
+				SortItem *si2 = cell[i];
+				if (si2->_stamp != _stamp && !si2->_occluded) {
+					si2->_stamp = _stamp;
+					_candidates.push_back(si2);
+				}
+			}
+		}
+	}
 
-		if (si2->_occluded)
-			continue;
+	// Iterate them in display list order and compare _shapes. Items not
+	// in the shared cells can't overlap us, so comparing them would not
+	// change anything.
+	Common::sort(_candidates.begin(), _candidates.end(), ListOrderLess);
+	for (uint i = 0; i < _candidates.size(); i++) {
+		SortItem *si2 = _candidates[i];
+		_stats._comparisons++;
 
 #ifdef SORTITEM_OCCLUSION_EXPERIMENTAL
 		// Find adjoining rects for better occlusion
@@ -246,26 +275,17 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 	// Add it to the list
 	_itemsUnused = _itemsUnused->_next;
 
-	// have a position
-	//addpoint = 0;
-	if (addpoint) {
-		si->_next = addpoint;
-		si->_prev = addpoint->_prev;
-		addpoint->_prev = si;
-		if (si->_prev)
-			si->_prev->_next = si;
-		else
-			_items = si;
-	}
-	// Add it to the end of the list
-	else {
-		if (_itemsTail)
-			_itemsTail->_next = si;
-		if (!_items)
-			_items = si;
-		si->_next = nullptr;
-		si->_prev = _itemsTail;
-		_itemsTail = si;
+	si->_addOrder = _added.size();
+	_added.push_back(si);
+	_listSorted = false;
+
+	// Nothing compares against occluded items, so keep them off the grid
+	if (si->_occluded)
+		return;
+
+	for (int cy = cy1; cy <= cy2; cy++) {
+		for (int cx = cx1; cx <= cx2; cx++)
+			_grid[cy][cx].push_back(si);
 	}
 }
 
@@ -276,7 +296,69 @@ void ItemSorter::AddItem(const Item *add) {
 			add->getFlags(), add->getExtFlags(), add->getObjId());
 }
 
+void ItemSorter::ClearDisplayList() {
+	for (uint i = 0; i < _added.size(); i++) {
+		_added[i]->_next = _itemsUnused;
+		_itemsUnused = _added[i];
+	}
+
+	// Resize rather than clear, to keep the storage for the next list
+	_added.resize(0);
+	for (int cy = 0; cy < GRID_SIZE; cy++) {
+		for (int cx = 0; cx < GRID_SIZE; cx++)
+			_grid[cy][cx].resize(0);
+	}
+
+	_items = nullptr;
+	_itemsTail = nullptr;
+	_listSorted = true;
+}
+
+void ItemSorter::SortDisplayList() {
+	if (_listSorted)
+		return;
+
+	Common::sort(_added.begin(), _added.end(), ListOrderLess);
+
+	SortItem *prev = nullptr;
+	for (uint i = 0; i < _added.size(); i++) {
+		SortItem *si = _added[i];
+		si->_prev = prev;
+		si->_next = nullptr;
+		if (prev)
+			prev->_next = si;
+		prev = si;
+	}
+
+	_items = _added.empty() ? nullptr : _added.front();
+	_itemsTail = prev;
+	_listSorted = true;
+
+	_stats._items = _added.size();
+	_stats._time = g_system->getMillis() - _startTime;
+}
+
+void ItemSorter::GetGridCells(const Rect &r, int &x1, int &y1, int &x2, int &y2) const {
+	// Rect::intersects treats the left and top of an empty rect as inside
+	// it, so the covered span is from there to the last column or row.
+	// Clamping keeps spans which intersect outside the clip window in
+	// common cells.
+	const int32 maxX = MAX(_clipWindow.left, _clipWindow.right - 1);
+	const int32 maxY = MAX(_clipWindow.top, _clipWindow.bottom - 1);
+	const int32 left = CLIP(MIN(r.left, r.right - 1), _clipWindow.left, maxX);
+	const int32 right = CLIP(MAX(r.left, r.right - 1), _clipWindow.left, maxX);
+	const int32 top = CLIP(MIN(r.top, r.bottom - 1), _clipWindow.top, maxY);
+	const int32 bottom = CLIP(MAX(r.top, r.bottom - 1), _clipWindow.top, maxY);
+
+	x1 = MIN<int32>((left - _clipWindow.left) / _gridCellWidth, GRID_SIZE - 1);
+	x2 = MIN<int32>((right - _clipWindow.left) / _gridCellWidth, GRID_SIZE - 1);
+	y1 = MIN<int32>((top - _clipWindow.top) / _gridCellHeight, GRID_SIZE - 1);
+	y2 = MIN<int32>((bottom - _clipWindow.top) / _gridCellHeight, GRID_SIZE - 1);
+}
+
 void ItemSorter::PaintDisplayList(RenderSurface *surf, bool item_highlight, bool showFootpads) {
+	SortDisplayList();
+
 	if (_sortLimit) {
 		// Clear the surface when debugging the sorter
 		uint32 color = TEX32_PACK_RGB(0, 0, 0);
@@ -509,6 +591,8 @@ uint16 ItemSorter::Trace(int32 x, int32 y, HitFace *face, bool item_highlight) {
 	SortItem *it;
 	SortItem *selected;
 
+	SortDisplayList();
+
 	if (!_painted) { // If no painted item found, we need to sort the items
 		it = _items;
 		_painted = nullptr;
@@ -22,6 +22,7 @@
 #ifndef ULTIMA8_WORLD_ITEMSORTER_H
 #define ULTIMA8_WORLD_ITEMSORTER_H
 
+#include "common/array.h"
 #include "ultima/ultima8/misc/rect.h"
 
 namespace Ultima {
@@ -33,6 +34,18 @@ class RenderSurface;
 struct SortItem;
 
 class ItemSorter {
+public:
+	struct Stats {
+		uint32 _items;       // Items in the display list
+		uint32 _comparisons; // Item pairs checked for overlap
+		uint32 _time;        // Milliseconds spent building the display list
+	};
+
+private:
+	// Screenspace grid over the clip window. Items are only compared with
+	// items sharing a cell, as others can't overlap them on screen.
+	static const int GRID_SIZE = 16;
+
 	MainShapeArchive    *_shapes;
 	Rect        _clipWindow;
 
@@ -41,6 +54,20 @@ class ItemSorter {
 	SortItem    *_itemsUnused;
 	SortItem    *_painted;
 
+	// Items added since BeginDisplayList, in the order they were added.
+	// _items is only linked up from these when needed.
+	Common::Array<SortItem *> _added;
+	bool        _listSorted;
+
+	Common::Array<SortItem *> _grid[GRID_SIZE][GRID_SIZE];
+	int32       _gridCellWidth, _gridCellHeight;
+	Common::Array<SortItem *> _candidates;
+	uint32      _stamp;
+
+	Stats       _stats;
+	Stats       _lastStats;
+	uint32      _startTime;
+
 	int32       _camSx, _camSy;
 	int32       _sortLimit;
 	bool        _sortLimitChanged;
@@ -68,8 +95,22 @@ public:
 
 	void IncSortLimit(int count);
 
+	// Statistics of the last completed display list
+	const Stats &getStats() const {
+		return _lastStats;
+	}
+
 private:
 	bool PaintSortItem(RenderSurface *surf, SortItem *si, bool showFootpad);
+
+	// Return the added items to the unused list
+	void ClearDisplayList();
+
+	// Link the added items into _items in paint order
+	void SortDisplayList();
+
+	// Grid cells covered by the screenspace rect r
+	void GetGridCells(const Rect &r, int &x1, int &y1, int &x2, int &y2) const;
 };
 
 } // End of namespace Ultima8
@@ -45,10 +45,36 @@
 #include "common/file.h"
 #include "common/savefile.h"
 #include "common/fs.h"
+#include "common/threadpool.h"
 #include "common/compression/unzip.h"
 
 namespace Wintermute {
 
+namespace {
+
+struct PackageFile {
+	Common::FSNode _file;
+	Common::String _fileName;
+	bool _searchSignature;
+};
+
+struct ReadPackageDirectories {
+	ReadPackageDirectories(const Common::Array<PackageFile> &files, Common::Array<PackageDirectory> &dirs, const PackageIndex &index) :
+		_files(files), _dirs(dirs), _index(index) {}
+
+	void operator()(uint first, uint last) const {
+		for (uint i = first; i < last; i++) {
+			_dirs[i].readFromFile(_files[i]._file, _files[i]._fileName, _files[i]._searchSignature, &_index);
+		}
+	}
+
+	const Common::Array<PackageFile> &_files;
+	Common::Array<PackageDirectory> &_dirs;
+	const PackageIndex &_index;
+};
+
+} // End of anonymous namespace
+
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
@@ -58,6 +84,7 @@ BaseFileManager::BaseFileManager(Common::Language lang, bool detectionMode) {
 	_detectionMode = detectionMode;
 	_language = lang;
 	_resources = nullptr;
+	_numPackages = 0;
 	initResources();
 	initPaths();
 	registerPackages();
@@ -193,12 +220,15 @@ bool BaseFileManager::registerPackages(const Common::FSList &fslist) {
 //////////////////////////////////////////////////////////////////////////
 bool BaseFileManager::registerPackages() {
 	debugC(kWintermuteDebugFileAccess | kWintermuteDebugLog, "Scanning packages");
+	uint32 startTime = g_system->getMillis();
+	_numPackages = 0;
 
 	// We need game flags to perform some game-specific hacks.
 	uint32 flags = BaseEngine::instance().getFlags();
 
 	// Register without using SearchMan, as otherwise the FSNode-based lookup in openPackage will fail
 	// and that has to be like that to support the detection-scheme.
+	Common::Array<PackageFile> packageFiles;
 	Common::FSList files;
 	for (Common::FSList::const_iterator it = _packagePaths.begin(); it != _packagePaths.end(); ++it) {
 		debugC(kWintermuteDebugFileAccess, "Should register folder: %s %s", it->getPath().c_str(), it->getName().c_str());
@@ -317,20 +347,69 @@ bool BaseFileManager::registerPackages() {
 				}
 			}
 			debugC(kWintermuteDebugFileAccess, "Registering %s %s", fileIt->getPath().c_str(), fileIt->getName().c_str());
-			registerPackage((*fileIt), fileName, searchSignature);
+			PackageFile packageFile;
+			packageFile._file = *fileIt;
+			packageFile._fileName = fileName;
+			packageFile._searchSignature = searchSignature;
+			packageFiles.push_back(packageFile);
+		}
+	}
+
+	// The directories of unchanged packages are taken from the index saved
+	// by the previous start, the others are read in parallel
+	PackageIndex index;
+	Common::String indexName;
+	if (!_detectionMode && !BaseEngine::instance().getGameTargetName().empty()) {
+		indexName = BaseEngine::instance().getGameTargetName() + "-packages.idx";
+		index.load(indexName);
+	}
+
+	Common::Array<PackageDirectory> dirs;
+	dirs.resize(packageFiles.size());
+	g_system->getThreadPool()->parallelFor(0, packageFiles.size(), ReadPackageDirectories(packageFiles, dirs, index), 1);
+
+	PackageIndex newIndex;
+	uint32 numIndexed = 0;
+	for (uint i = 0; i < packageFiles.size(); i++) {
+		const PackageDirectory *dir = &dirs[i];
+		if (dir->_inIndex) {
+			dir = index.find(dir->_checksum);
+			numIndexed++;
+		}
+		registerPackage(packageFiles[i]._file, packageFiles[i]._fileName, *dir);
+		if (dir->_valid) {
+			newIndex.add(*dir);
+		}
+	}
+
+	// Also rewrite the index when packages were removed
+	if (!indexName.empty() && (numIndexed != newIndex.size() || newIndex.size() != index.size())) {
+		if (!newIndex.save(indexName)) {
+			debugC(kWintermuteDebugFileAccess | kWintermuteDebugLog, "  Failed to save the package index '%s'", indexName.c_str());
 		}
 	}
 
 //	debugC(kWintermuteDebugFileAccess | kWintermuteDebugLog, "  Registered %d files in %d package(s)", _files.size(), _packages.size());
+	debugC(kWintermuteDebugFileAccess | kWintermuteDebugLog, "  Registered %d package(s) in %d ms, %d from the package index",
+	       _numPackages, g_system->getMillis() - startTime, numIndexed);
 
 	return STATUS_OK;
 }
 
 bool BaseFileManager::registerPackage(Common::FSNode file, const Common::String &filename, bool searchSignature) {
-	PackageSet *pack = new PackageSet(file, filename, searchSignature);
+	return registerPackage(new PackageSet(file, filename, searchSignature), filename);
+}
+
+bool BaseFileManager::registerPackage(Common::FSNode file, const Common::String &filename, const PackageDirectory &dir) {
+	return registerPackage(new PackageSet(file, dir), filename);
+}
+
+bool BaseFileManager::registerPackage(PackageSet *pack, const Common::String &filename) {
 	_packages.add(filename, pack, pack->getPriority() , true);
 	_versions[filename] = pack->getVersion();
 
+	_numPackages++;
+
 	return STATUS_OK;
 }
 
@@ -36,6 +36,9 @@
 #include "common/language.h"
 
 namespace Wintermute {
+class PackageSet;
+struct PackageDirectory;
+
 class BaseFileManager {
 public:
 	bool cleanup();
@@ -69,12 +72,16 @@ private:
 	Common::SeekableReadStream *openPkgFile(const Common::String &filename);
 	Common::FSList _packagePaths;
 	bool registerPackage(Common::FSNode package, const Common::String &filename = "", bool searchSignature = false);
+	bool registerPackage(Common::FSNode package, const Common::String &filename, const PackageDirectory &dir);
+	bool registerPackage(PackageSet *pack, const Common::String &filename);
 	bool _detectionMode;
 	Common::SearchSet _packages;
 	Common::Array<Common::SeekableReadStream *> _openFiles;
 	Common::Language _language;
 	Common::Archive *_resources;
 	Common::HashMap<Common::String, uint32> _versions;
+	// Number of packages registered by the last registerPackages() call
+	uint32 _numPackages;
 
 	// This class is intentionally not a subclass of Base, as it needs to be used by
 	// the detector too, without launching the entire engine:
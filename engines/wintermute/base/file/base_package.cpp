@@ -30,8 +30,13 @@
 #include "engines/wintermute/base/file/base_file_entry.h"
 #include "engines/wintermute/base/file/dcpackage.h"
 #include "engines/wintermute/wintermute.h"
+#include "common/bufferedstream.h"
+#include "common/crc.h"
 #include "common/file.h"
+#include "common/memstream.h"
+#include "common/savefile.h"
 #include "common/stream.h"
+#include "common/system.h"
 #include "common/debug.h"
 
 namespace Wintermute {
@@ -90,15 +95,6 @@ void TPackageHeader::readFromStream(Common::ReadStream *stream) {
 	_gameVersion = stream->readUint32LE();
 
 	_priority = stream->readByte();
-
-	// HACK: reversion1 and reversion2 for Linux & Mac use some hacked Wintermute
-	// They provide "xlanguage_*.dcp" packages with 0x00 priority and change priority for a single package in runtime
-	// We already filter unwanted "xlanguage_*.dcp" packages at BaseFileManager::registerPackages()
-	// So, let's just raise the priority for all "xlanguage_*.dcp" here to the value of Windows version packages
-	if (_priority == 0 && BaseEngine::instance().getGameId().hasPrefix("reversion")) {
-		_priority = 0x02;
-	}
-
 	_cd = stream->readByte();
 	_masterIndex = stream->readByte();
 	stream->readByte(); // To align the next byte...
@@ -109,10 +105,26 @@ void TPackageHeader::readFromStream(Common::ReadStream *stream) {
 	_numDirs = stream->readUint32LE();
 }
 
-PackageSet::PackageSet(Common::FSNode file, const Common::String &filename, bool searchSignature) {
-	uint32 absoluteOffset = 0;
+enum {
+	// Size of TPackageHeader in the file, followed by the v2 directory offset
+	kPackageHeaderSize = 128,
+	kPackageDirBufferSize = 64 * 1024,
+	kPackageIndexVersion = 1
+};
+
+#define PACKAGE_INDEX_MAGIC MKTAG('W', 'P', 'I', 'X')
+
+PackageDirectory::PackageDirectory() {
+	_checksum = 0;
+	_valid = false;
+	_inIndex = false;
 	_priority = 0;
-	bool boundToExe = false;
+	_version = 0;
+	_boundToExe = false;
+}
+
+void PackageDirectory::readFromFile(const Common::FSNode &file, const Common::String &filename, bool searchSignature, const PackageIndex *index) {
+	uint32 absoluteOffset = 0;
 	Common::SeekableReadStream *stream = file.createReadStream();
 	if (!stream) {
 		return;
@@ -125,12 +137,18 @@ PackageSet::PackageSet(Common::FSNode file, const Common::String &filename, bool
 		} else {
 			stream->seek(offset, SEEK_SET);
 			absoluteOffset = offset;
-			boundToExe = true;
+			_boundToExe = true;
 		}
 	}
 
+	// The header, the directory offset, the file size and the package offset
+	byte header[kPackageHeaderSize + 12];
+	memset(header, 0, sizeof(header));
+	stream->read(header, kPackageHeaderSize);
+
 	TPackageHeader hdr;
-	hdr.readFromStream(stream);
+	Common::MemoryReadStream headerStream(header, kPackageHeaderSize);
+	hdr.readFromStream(&headerStream);
 	if (hdr._magic1 != PACKAGE_MAGIC_1 || hdr._magic2 != PACKAGE_MAGIC_2 || hdr._packageVersion > PACKAGE_VERSION) {
 		debugC(kWintermuteDebugFileAccess | kWintermuteDebugLog, "  Invalid header in package file '%s'. Ignoring.", filename.c_str());
 		delete stream;
@@ -147,43 +165,49 @@ PackageSet::PackageSet(Common::FSNode file, const Common::String &filename, bool
 	if (hdr._packageVersion == PACKAGE_VERSION) {
 		uint32 dirOffset;
 		dirOffset = stream->readUint32LE();
+		WRITE_LE_UINT32(header + kPackageHeaderSize, dirOffset);
 		dirOffset += absoluteOffset;
 		stream->seek(dirOffset, SEEK_SET);
 	}
 	assert(hdr._numDirs == 1);
-	for (uint32 i = 0; i < hdr._numDirs; i++) {
-		BasePackage *pkg = new BasePackage();
-		if (!pkg) {
-			return;
-		}
-		pkg->_fsnode = file;
 
-		pkg->_boundToExe = boundToExe;
+	WRITE_LE_UINT32(header + kPackageHeaderSize + 4, (uint32)stream->size());
+	WRITE_LE_UINT32(header + kPackageHeaderSize + 8, absoluteOffset);
+	Common::CRC32 crc;
+	_checksum = crc.crcFast(header, sizeof(header));
+	_valid = true;
+
+	if (index && index->contains(_checksum)) {
+		_inIndex = true;
+		delete stream;
+		return;
+	}
+
+	// The directory is made of many tiny fields, so read it in large blocks
+	stream = Common::wrapBufferedSeekableReadStream(stream, kPackageDirBufferSize, DisposeAfterUse::YES);
+
+	_dirs.resize(hdr._numDirs);
+	for (uint32 i = 0; i < hdr._numDirs; i++) {
+		Dir &dir = _dirs[i];
 
 		// read package info
 		byte nameLength = stream->readByte();
-		char *pkgName = new char[nameLength];
-		stream->read(pkgName, nameLength);
-		pkg->_name = pkgName;
-		pkg->_cd = stream->readByte();
-		pkg->_priority = hdr._priority;
-		delete[] pkgName;
-		pkgName = nullptr;
+		dir._name = stream->readString(0, nameLength);
+		dir._cd = stream->readByte();
 
 		if (!hdr._masterIndex) {
-			pkg->_cd = 0;    // override CD to fixed disk
+			dir._cd = 0;    // override CD to fixed disk
 		}
-		_packages.push_back(pkg);
 
 		// read file entries
 		uint32 numFiles = stream->readUint32LE();
+		dir._entries.reserve(numFiles);
 
-		for (uint32 j = 0; j < numFiles; j++) {
-			char *name;
-			uint32 offset, length, compLength, flags;/*, timeDate1, timeDate2;*/
+		for (uint32 j = 0; j < numFiles && !stream->eos(); j++) {
+			Entry entry;
 
 			nameLength = stream->readByte();
-			name = new char[nameLength];
+			char *name = new char[nameLength];
 			stream->read(name, nameLength);
 
 			// v2 - xor name
@@ -194,49 +218,207 @@ PackageSet::PackageSet(Common::FSNode file, const Common::String &filename, bool
 			}
 			debugC(kWintermuteDebugFileAccess, "Package contains %s", name);
 
-			Common::String upcName = name;
-			upcName.toUppercase();
+			entry._name = name;
+			entry._name.toUppercase();
 			delete[] name;
 			name = nullptr;
 
-			offset = stream->readUint32LE();
-			offset += absoluteOffset;
-			length = stream->readUint32LE();
-			compLength = stream->readUint32LE();
-			flags = stream->readUint32LE();
+			entry._offset = stream->readUint32LE();
+			entry._offset += absoluteOffset;
+			entry._length = stream->readUint32LE();
+			entry._compressedLength = stream->readUint32LE();
+			entry._flags = stream->readUint32LE();
 
 			if (hdr._packageVersion == PACKAGE_VERSION) {
 				/* timeDate1 = */ stream->readUint32LE();
 				/* timeDate2 = */ stream->readUint32LE();
 			}
-			_filesIter = _files.find(upcName);
+			dir._entries.push_back(entry);
+		}
+	}
+
+	delete stream;
+}
+
+bool PackageIndex::load(const Common::String &filename) {
+	_dirs.clear();
+
+	Common::InSaveFile *file = g_system->getSavefileManager()->openForLoading(filename);
+	if (!file) {
+		return false;
+	}
+
+	// Read the index in one go and parse it from memory
+	Common::SeekableReadStream *stream = file->readStream(file->size());
+	delete file;
+
+	bool ok = stream->readUint32BE() == PACKAGE_INDEX_MAGIC && stream->readUint32LE() == kPackageIndexVersion;
+	uint32 numPackages = ok ? stream->readUint32LE() : 0;
+
+	for (uint32 i = 0; ok && i < numPackages; i++) {
+		PackageDirectory dir;
+		dir._valid = true;
+		dir._checksum = stream->readUint32LE();
+		dir._priority = stream->readByte();
+		dir._version = stream->readUint32LE();
+		dir._boundToExe = stream->readByte() != 0;
+
+		// Guard against huge counts in broken files
+		uint32 numDirs = stream->readUint32LE();
+		ok = (int64)numDirs <= stream->size() - stream->pos();
+		if (ok) {
+			dir._dirs.resize(numDirs);
+		}
+
+		for (uint32 j = 0; ok && j < dir._dirs.size(); j++) {
+			PackageDirectory::Dir &d = dir._dirs[j];
+			d._name = stream->readString();
+			d._cd = stream->readByte();
+
+			uint32 numFiles = stream->readUint32LE();
+			ok = (int64)numFiles <= stream->size() - stream->pos();
+			if (ok) {
+				d._entries.resize(numFiles);
+			}
+
+			for (uint32 k = 0; ok && k < d._entries.size(); k++) {
+				PackageDirectory::Entry &entry = d._entries[k];
+				entry._name = stream->readString();
+				entry._offset = stream->readUint32LE();
+				entry._length = stream->readUint32LE();
+				entry._compressedLength = stream->readUint32LE();
+				entry._flags = stream->readUint32LE();
+			}
+		}
+
+		ok = ok && !stream->err() && !stream->eos();
+		if (ok) {
+			_dirs[dir._checksum] = dir;
+		}
+	}
+	delete stream;
+
+	if (!ok) {
+		debugC(kWintermuteDebugFileAccess | kWintermuteDebugLog, "  Ignoring broken package index '%s'", filename.c_str());
+		_dirs.clear();
+	}
+	return ok;
+}
+
+bool PackageIndex::save(const Common::String &filename) const {
+	Common::OutSaveFile *file = g_system->getSavefileManager()->openForSaving(filename, false);
+	if (!file) {
+		return false;
+	}
+
+	file->writeUint32BE(PACKAGE_INDEX_MAGIC);
+	file->writeUint32LE(kPackageIndexVersion);
+	file->writeUint32LE(_dirs.size());
+
+	for (Common::HashMap<uint32, PackageDirectory>::const_iterator it = _dirs.begin(); it != _dirs.end(); ++it) {
+		const PackageDirectory &dir = it->_value;
+		file->writeUint32LE(dir._checksum);
+		file->writeByte(dir._priority);
+		file->writeUint32LE(dir._version);
+		file->writeByte(dir._boundToExe);
+		file->writeUint32LE(dir._dirs.size());
+
+		for (uint32 j = 0; j < dir._dirs.size(); j++) {
+			const PackageDirectory::Dir &d = dir._dirs[j];
+			file->writeString(d._name);
+			file->writeByte(0);
+			file->writeByte(d._cd);
+			file->writeUint32LE(d._entries.size());
+
+			for (uint32 k = 0; k < d._entries.size(); k++) {
+				const PackageDirectory::Entry &entry = d._entries[k];
+				file->writeString(entry._name);
+				file->writeByte(0);
+				file->writeUint32LE(entry._offset);
+				file->writeUint32LE(entry._length);
+				file->writeUint32LE(entry._compressedLength);
+				file->writeUint32LE(entry._flags);
+			}
+		}
+	}
+
+	file->finalize();
+	bool ok = !file->err();
+	delete file;
+	return ok;
+}
+
+const PackageDirectory *PackageIndex::find(uint32 checksum) const {
+	Common::HashMap<uint32, PackageDirectory>::const_iterator it = _dirs.find(checksum);
+	return it != _dirs.end() ? &it->_value : nullptr;
+}
+
+PackageSet::PackageSet(Common::FSNode file, const Common::String &filename, bool searchSignature) {
+	PackageDirectory dir;
+	dir.readFromFile(file, filename, searchSignature, nullptr);
+	addDirectory(file, dir);
+}
+
+PackageSet::PackageSet(Common::FSNode file, const PackageDirectory &dir) {
+	addDirectory(file, dir);
+}
+
+void PackageSet::addDirectory(Common::FSNode file, const PackageDirectory &dir) {
+	_priority = 0;
+	_version = 0;
+	if (!dir._valid) {
+		return;
+	}
+
+	_priority = dir._priority;
+	_version = dir._version;
+
+	// HACK: reversion1 and reversion2 for Linux & Mac use some hacked Wintermute
+	// They provide "xlanguage_*.dcp" packages with 0x00 priority and change priority for a single package in runtime
+	// We already filter unwanted "xlanguage_*.dcp" packages at BaseFileManager::registerPackages()
+	// So, let's just raise the priority for all "xlanguage_*.dcp" here to the value of Windows version packages
+	if (_priority == 0 && BaseEngine::instance().getGameId().hasPrefix("reversion")) {
+		_priority = 0x02;
+	}
+
+	for (uint32 i = 0; i < dir._dirs.size(); i++) {
+		const PackageDirectory::Dir &d = dir._dirs[i];
+		BasePackage *pkg = new BasePackage();
+		pkg->_fsnode = file;
+		pkg->_boundToExe = dir._boundToExe;
+		pkg->_name = d._name;
+		pkg->_cd = d._cd;
+		pkg->_priority = _priority;
+		_packages.push_back(pkg);
+
+		for (uint32 j = 0; j < d._entries.size(); j++) {
+			const PackageDirectory::Entry &entry = d._entries[j];
+			_filesIter = _files.find(entry._name);
 			if (_filesIter == _files.end()) {
 				BaseFileEntry *fileEntry = new BaseFileEntry();
 				fileEntry->_package = pkg;
-				fileEntry->_offset = offset;
-				fileEntry->_length = length;
-				fileEntry->_compressedLength = compLength;
-				fileEntry->_flags = flags;
-				fileEntry->_filename = upcName;
+				fileEntry->_offset = entry._offset;
+				fileEntry->_length = entry._length;
+				fileEntry->_compressedLength = entry._compressedLength;
+				fileEntry->_flags = entry._flags;
+				fileEntry->_filename = entry._name;
 
-				_files[upcName] = Common::ArchiveMemberPtr(fileEntry);
+				_files[entry._name] = Common::ArchiveMemberPtr(fileEntry);
 			} else {
 				// current package has higher priority than the registered
 				// TODO: This cast might be a bit ugly.
 				BaseFileEntry *filePtr = (BaseFileEntry *) &*(_filesIter->_value);
 				if (pkg->_priority > filePtr->_package->_priority) {
 					filePtr->_package = pkg;
-					filePtr->_offset = offset;
-					filePtr->_length = length;
-					filePtr->_compressedLength = compLength;
-					filePtr->_flags = flags;
+					filePtr->_offset = entry._offset;
+					filePtr->_length = entry._length;
+					filePtr->_compressedLength = entry._compressedLength;
+					filePtr->_flags = entry._flags;
 				}
 			}
 		}
 	}
 	debugC(kWintermuteDebugFileAccess, "  Registered %d files in %d package(s)", _files.size(), _packages.size());
-
-	delete stream;
 }
 
 PackageSet::~PackageSet() {
@@ -33,6 +33,66 @@
 #include "common/fs.h"
 
 namespace Wintermute {
+class PackageIndex;
+
+/**
+ * The directory of a package file, as read from the file itself or
+ * from the package index.
+ */
+struct PackageDirectory {
+	struct Entry {
+		Common::String _name;
+		uint32 _offset;
+		uint32 _length;
+		uint32 _compressedLength;
+		uint32 _flags;
+	};
+
+	struct Dir {
+		Common::String _name;
+		byte _cd;
+		Common::Array<Entry> _entries;
+	};
+
+	PackageDirectory();
+
+	/**
+	 * Read the header and the directory of a package. The directory is
+	 * not read if the index holds the one of a package with the same
+	 * checksum, in which case only _checksum is set and _inIndex is true.
+	 * Several packages may be read on different threads at once.
+	 */
+	void readFromFile(const Common::FSNode &file, const Common::String &filename, bool searchSignature, const PackageIndex *index);
+
+	// Checksum of the package header and the file size
+	uint32 _checksum;
+	bool _valid;
+	bool _inIndex;
+	byte _priority;
+	uint32 _version;
+	bool _boundToExe;
+	Common::Array<Dir> _dirs;
+};
+
+/**
+ * The directories of the packages of a game, keyed by package checksum.
+ * It is kept in a save file, so that the package directories do not
+ * have to be parsed again on every start.
+ */
+class PackageIndex {
+public:
+	bool load(const Common::String &filename);
+	bool save(const Common::String &filename) const;
+
+	bool contains(uint32 checksum) const { return _dirs.contains(checksum); }
+	const PackageDirectory *find(uint32 checksum) const;
+	void add(const PackageDirectory &dir) { _dirs[dir._checksum] = dir; }
+	uint32 size() const { return _dirs.size(); }
+
+private:
+	Common::HashMap<uint32, PackageDirectory> _dirs;
+};
+
 class BasePackage {
 public:
 	Common::SeekableReadStream *getFilePointer();
@@ -49,6 +109,7 @@ public:
 	~PackageSet() override;
 
 	PackageSet(Common::FSNode package, const Common::String &filename = "", bool searchSignature = false);
+	PackageSet(Common::FSNode package, const PackageDirectory &dir);
 	/**
 	 * Check if a member with the given name is present in the Archive.
 	 * Patterns are not allowed, as this is meant to be a quick File::exists()
@@ -80,6 +141,8 @@ public:
 	uint32 getVersion() const { return _version; }
 
 private:
+	void addDirectory(Common::FSNode package, const PackageDirectory &dir);
+
 	byte _priority;
 	uint32 _version;
 	Common::Array<BasePackage *> _packages;
@@ -51,7 +51,10 @@ BaseRenderer *makeOSystemRenderer(BaseGame *inGame) {
 BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 	_renderSurface = new Graphics::Surface();
 	_blankSurface = new Graphics::Surface();
-	_lastFrameIter = _renderQueue.end();
+	_lastFrameIndex = 0;
+	_dirtyTilesW = _dirtyTilesH = 0;
+	memset(&_stats, 0, sizeof(_stats));
+	memset(&_lastStats, 0, sizeof(_lastStats));
 	_needsFlip = true;
 	_skipThisFrame = false;
 
@@ -68,12 +71,7 @@ BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 
 //////////////////////////////////////////////////////////////////////////
 BaseRenderOSystem::~BaseRenderOSystem() {
-	RenderQueueIterator it = _renderQueue.begin();
-	while (it != _renderQueue.end()) {
-		RenderTicket *ticket = *it;
-		it = _renderQueue.erase(it);
-		delete ticket;
-	}
+	deleteAllTickets();
 
 	delete _dirtyRect;
 
@@ -136,6 +134,13 @@ bool BaseRenderOSystem::initRenderer(int width, int height, bool windowed) {
 	_blankSurface->fillRect(Common::Rect(0, 0, _blankSurface->h, _blankSurface->w), _blankSurface->format.ARGBToColor(255, 0, 0, 0));
 	_active = true;
 
+	_dirtyTilesW = (_renderSurface->w + kDirtyTileSize - 1) / kDirtyTileSize;
+	_dirtyTilesH = (_renderSurface->h + kDirtyTileSize - 1) / kDirtyTileSize;
+	_dirtyTiles.resize(_dirtyTilesW * _dirtyTilesH);
+	for (uint i = 0; i < _dirtyTiles.size(); i++) {
+		_dirtyTiles[i] = false;
+	}
+
 	_clearColor = _renderSurface->format.ARGBToColor(255, 0, 0, 0);
 
 	return STATUS_OK;
@@ -158,17 +163,15 @@ bool BaseRenderOSystem::forcedFlip() {
 bool BaseRenderOSystem::flip() {
 	if (_skipThisFrame) {
 		_skipThisFrame = false;
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		clearDirtyRect();
 		g_system->updateScreen();
 		_needsFlip = false;
 
 		// Reset ticketing state
-		_lastFrameIter = _renderQueue.end();
-		RenderQueueIterator it;
-		for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
-			(*it)->_wantsDraw = false;
+		for (uint i = 0; i < _renderQueue.size(); i++) {
+			_renderQueue[i]->_wantsDraw = false;
 		}
+		startNewFrame();
 
 		addDirtyRect(_renderRect);
 		return true;
@@ -177,17 +180,15 @@ bool BaseRenderOSystem::flip() {
 		drawTickets();
 	} else {
 		// Clear the scale-buffered tickets that wasn't reused.
-		RenderQueueIterator it = _renderQueue.begin();
-		while (it != _renderQueue.end()) {
-			if ((*it)->_wantsDraw == false) {
-				RenderTicket *ticket = *it;
-				it = _renderQueue.erase(it);
-				delete ticket;
-			} else {
-				(*it)->_wantsDraw = false;
-				++it;
+		for (uint i = _lastFrameIndex; i < _lastFrameQueue.size(); i++) {
+			if (_lastFrameQueue[i]) {
+				deleteTicket(_lastFrameQueue[i]);
 			}
 		}
+		_lastFrameQueue.clear();
+		for (uint i = 0; i < _renderQueue.size(); i++) {
+			_renderQueue[i]->_wantsDraw = false;
+		}
 	}
 
 	int oldScreenChangeID = _lastScreenChangeID;
@@ -199,11 +200,10 @@ bool BaseRenderOSystem::flip() {
 			g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, 0, 0, _renderSurface->w, _renderSurface->h);
 		}
 		//  g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		clearDirtyRect();
 		_needsFlip = false;
 	}
-	_lastFrameIter = _renderQueue.end();
+	startNewFrame();
 
 	g_system->updateScreen();
 
@@ -288,7 +288,7 @@ Graphics::PixelFormat BaseRenderOSystem::getPixelFormat() const {
 void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::Surface *surf,
                                     Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform) {
 	if (_disableDirtyRects) {
-		RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
+		RenderTicket *ticket = createTicket(owner, surf, srcRect, dstRect, transform);
 		ticket->_wantsDraw = true;
 		_renderQueue.push_back(ticket);
 		drawFromSurface(ticket);
@@ -302,32 +302,101 @@ void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::S
 
 	if (owner) { // Fade-tickets are owner-less
 		RenderTicket compare(owner, nullptr, srcRect, dstRect, transform);
-		RenderQueueIterator it = _lastFrameIter;
-		++it;
-		// Avoid calling end() and operator* every time, when potentially going through
-		// LOTS of tickets.
-		RenderQueueIterator endIterator = _renderQueue.end();
-		RenderTicket *compareTicket = nullptr;
-		for (; it != endIterator; ++it) {
-			compareTicket = *it;
-			if (*(compareTicket) == compare && compareTicket->_isValid) {
-				if (_disableDirtyRects) {
-					drawFromSurface(compareTicket);
-				} else {
-					drawFromQueuedTicket(it);
-				}
-				return;
-			}
+		uint32 slot = findLastFrameTicket(compare);
+		if (slot != kNoTicket) {
+			drawFromQueuedTicket(slot);
+			return;
 		}
 	}
-	RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
-	if (!_disableDirtyRects) {
-		drawFromTicket(ticket);
-	} else {
-		ticket->_wantsDraw = true;
-		_renderQueue.push_back(ticket);
-		drawFromSurface(ticket);
+	RenderTicket *ticket = createTicket(owner, surf, srcRect, dstRect, transform);
+	_stats.created++;
+	drawFromTicket(ticket);
+}
+
+uint32 BaseRenderOSystem::hashTicket(const RenderTicket &ticket) {
+	const Common::Rect &src = *ticket.getSrcRect();
+	const Common::Rect &dst = ticket._dstRect;
+	uint32 hash = (uint32)(size_t)ticket._owner;
+	hash = hash * 31 + (uint16)src.left + ((uint32)(uint16)src.top << 16);
+	hash = hash * 31 + (uint16)src.right + ((uint32)(uint16)src.bottom << 16);
+	hash = hash * 31 + (uint16)dst.left + ((uint32)(uint16)dst.top << 16);
+	hash = hash * 31 + (uint16)dst.right + ((uint32)(uint16)dst.bottom << 16);
+	return hash;
+}
+
+uint32 BaseRenderOSystem::findLastFrameTicket(const RenderTicket &compare) {
+	Common::HashMap<uint32, uint32>::const_iterator it = _lastFrameHash.find(hashTicket(compare));
+	if (it == _lastFrameHash.end()) {
+		return kNoTicket;
+	}
+
+	// The chain is in queue order, so the first match is the same one
+	// a walk over the remaining tickets of the last frame would find.
+	for (uint32 slot = it->_value; slot != kNoTicket; slot = _lastFrameChain[slot]) {
+		RenderTicket *ticket = _lastFrameQueue[slot];
+		if (!ticket) {
+			continue;
+		}
+		_stats.compares++;
+		if (*ticket == compare && ticket->_isValid) {
+			return slot;
+		}
+	}
+	return kNoTicket;
+}
+
+RenderTicket *BaseRenderOSystem::createTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform) {
+	return new (_ticketPool) RenderTicket(owner, surf, srcRect, dstRect, transform);
+}
+
+void BaseRenderOSystem::deleteTicket(RenderTicket *ticket) {
+	_ticketPool.deleteChunk(ticket);
+}
+
+void BaseRenderOSystem::deleteAllTickets() {
+	for (uint i = 0; i < _renderQueue.size(); i++) {
+		deleteTicket(_renderQueue[i]);
+	}
+	for (uint i = _lastFrameIndex; i < _lastFrameQueue.size(); i++) {
+		if (_lastFrameQueue[i]) {
+			deleteTicket(_lastFrameQueue[i]);
+		}
+	}
+	_renderQueue.clear();
+	_lastFrameQueue.clear();
+	_lastFrameHash.clear();
+	_lastFrameChain.clear();
+	_lastFrameIndex = 0;
+}
+
+void BaseRenderOSystem::startNewFrame() {
+	// Tickets of the last frame which were not drawn again stay behind the new ones
+	for (uint i = _lastFrameIndex; i < _lastFrameQueue.size(); i++) {
+		if (_lastFrameQueue[i]) {
+			_renderQueue.push_back(_lastFrameQueue[i]);
+		}
 	}
+	_lastFrameQueue.clear();
+	_lastFrameQueue.swap(_renderQueue);
+	_lastFrameIndex = 0;
+
+	_lastFrameHash.clear();
+	_lastFrameChain.resize(_lastFrameQueue.size());
+	for (uint32 slot = _lastFrameQueue.size(); slot-- > 0;) {
+		uint32 hash = hashTicket(*_lastFrameQueue[slot]);
+		Common::HashMap<uint32, uint32>::iterator it = _lastFrameHash.find(hash);
+		if (it != _lastFrameHash.end()) {
+			_lastFrameChain[slot] = it->_value;
+			it->_value = slot;
+		} else {
+			_lastFrameChain[slot] = kNoTicket;
+			_lastFrameHash[hash] = slot;
+		}
+	}
+
+	_stats.tickets = _lastFrameQueue.size();
+	_lastStats = _stats;
+	memset(&_stats, 0, sizeof(_stats));
 }
 
 void BaseRenderOSystem::invalidateTicket(RenderTicket *renderTicket) {
@@ -337,47 +406,44 @@ void BaseRenderOSystem::invalidateTicket(RenderTicket *renderTicket) {
 }
 
 void BaseRenderOSystem::invalidateTicketsFromSurface(BaseSurfaceOSystem *surf) {
-	RenderQueueIterator it;
-	for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
-		if ((*it)->_owner == surf) {
-			invalidateTicket(*it);
+	for (uint i = 0; i < _renderQueue.size(); i++) {
+		if (_renderQueue[i]->_owner == surf) {
+			invalidateTicket(_renderQueue[i]);
+		}
+	}
+	for (uint i = _lastFrameIndex; i < _lastFrameQueue.size(); i++) {
+		if (_lastFrameQueue[i] && _lastFrameQueue[i]->_owner == surf) {
+			invalidateTicket(_lastFrameQueue[i]);
 		}
 	}
 }
 
 void BaseRenderOSystem::drawFromTicket(RenderTicket *renderTicket) {
 	renderTicket->_wantsDraw = true;
-
-	++_lastFrameIter;
-	// In-order
-	if (_renderQueue.empty() || _lastFrameIter == _renderQueue.end()) {
-		_lastFrameIter--;
-		_renderQueue.push_back(renderTicket);
-		++_lastFrameIter;
-		addDirtyRect(renderTicket->_dstRect);
-	} else {
-		// Before something
-		RenderQueueIterator pos = _lastFrameIter;
-		_renderQueue.insert(pos, renderTicket);
-		--_lastFrameIter;
-		addDirtyRect(renderTicket->_dstRect);
-	}
+	_renderQueue.push_back(renderTicket);
+	addDirtyRect(renderTicket->_dstRect);
 }
 
-void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket) {
-	RenderTicket *renderTicket = *ticket;
+void BaseRenderOSystem::drawFromQueuedTicket(uint32 slot) {
+	RenderTicket *renderTicket = _lastFrameQueue[slot];
 	assert(!renderTicket->_wantsDraw);
-	renderTicket->_wantsDraw = true;
+	_lastFrameQueue[slot] = nullptr;
+
+	// The ticket is in the same order, if no other ticket of the last frame
+	// would have been drawn before it
+	bool inOrder = (slot == _lastFrameIndex);
+	while (_lastFrameIndex < _lastFrameQueue.size() && !_lastFrameQueue[_lastFrameIndex]) {
+		_lastFrameIndex++;
+	}
 
-	++_lastFrameIter;
-	// Not in the same order?
-	if (*_lastFrameIter != renderTicket) {
-		--_lastFrameIter;
-		// Remove the ticket from the list
-		assert(*_lastFrameIter != renderTicket);
-		_renderQueue.erase(ticket);
+	if (inOrder) {
+		renderTicket->_wantsDraw = true;
+		_renderQueue.push_back(renderTicket);
+		_stats.reused++;
+	} else {
 		// Is not in order, so readd it as if it was a new ticket
 		drawFromTicket(renderTicket);
+		_stats.moved++;
 	}
 }
 
@@ -388,85 +454,158 @@ void BaseRenderOSystem::addDirtyRect(const Common::Rect &rect) {
 		_dirtyRect->extend(rect);
 	}
 	_dirtyRect->clip(_renderRect);
+
+	Common::Rect tileRect(rect);
+	tileRect.clip(_renderRect);
+	tileRect.clip(Common::Rect(_dirtyTilesW * kDirtyTileSize, _dirtyTilesH * kDirtyTileSize));
+	if (tileRect.isEmpty()) {
+		return;
+	}
+
+	int right = (tileRect.right - 1) / kDirtyTileSize;
+	int bottom = (tileRect.bottom - 1) / kDirtyTileSize;
+	for (int y = tileRect.top / kDirtyTileSize; y <= bottom; y++) {
+		for (int x = tileRect.left / kDirtyTileSize; x <= right; x++) {
+			_dirtyTiles[y * _dirtyTilesW + x] = true;
+		}
+	}
+}
+
+void BaseRenderOSystem::clearDirtyRect() {
+	delete _dirtyRect;
+	_dirtyRect = nullptr;
+	for (uint i = 0; i < _dirtyTiles.size(); i++) {
+		_dirtyTiles[i] = false;
+	}
+}
+
+void BaseRenderOSystem::buildDirtyRects() {
+	_dirtyRects.clear();
+
+	// Merge runs of dirty tiles in a row, and runs spanning the same
+	// columns in consecutive rows
+	for (int y = 0; y < _dirtyTilesH; y++) {
+		int x = 0;
+		while (x < _dirtyTilesW) {
+			if (!_dirtyTiles[y * _dirtyTilesW + x]) {
+				x++;
+				continue;
+			}
+			int start = x;
+			while (x < _dirtyTilesW && _dirtyTiles[y * _dirtyTilesW + x]) {
+				x++;
+			}
+
+			Common::Rect run(start * kDirtyTileSize, y * kDirtyTileSize, x * kDirtyTileSize, (y + 1) * kDirtyTileSize);
+			bool merged = false;
+			for (uint i = 0; i < _dirtyRects.size(); i++) {
+				Common::Rect &r = _dirtyRects[i];
+				if (r.bottom == run.top && r.left == run.left && r.right == run.right) {
+					r.bottom = run.bottom;
+					merged = true;
+					break;
+				}
+			}
+			if (!merged) {
+				_dirtyRects.push_back(run);
+			}
+		}
+	}
+
+	for (uint i = 0; i < _dirtyRects.size(); i++) {
+		_dirtyRects[i].clip(*_dirtyRect);
+	}
+
+	// Too many small rectangles cost more than redrawing the bounding box
+	if (_dirtyRects.empty() || _dirtyRects.size() > (uint)kMaxDirtyRects) {
+		_dirtyRects.clear();
+		_dirtyRects.push_back(*_dirtyRect);
+	}
 }
 
 void BaseRenderOSystem::drawTickets() {
-	RenderQueueIterator it = _renderQueue.begin();
 	// Clean out the old tickets
 	// Note: We draw invalid tickets too, otherwise we wouldn't be honoring
 	// the draw request they obviously made BEFORE becoming invalid, either way
 	// we have a copy of their data, so their invalidness won't affect us.
-	while (it != _renderQueue.end()) {
-		if ((*it)->_wantsDraw == false) {
-			RenderTicket *ticket = *it;
-			addDirtyRect((*it)->_dstRect);
-			it = _renderQueue.erase(it);
-			delete ticket;
-		} else {
-			++it;
+	for (uint i = _lastFrameIndex; i < _lastFrameQueue.size(); i++) {
+		RenderTicket *ticket = _lastFrameQueue[i];
+		if (ticket) {
+			addDirtyRect(ticket->_dstRect);
+			deleteTicket(ticket);
+			_stats.deleted++;
 		}
 	}
+	_lastFrameQueue.clear();
+	_lastFrameIndex = 0;
+
 	if (!_dirtyRect || _dirtyRect->width() == 0 || _dirtyRect->height() == 0) {
-		it = _renderQueue.begin();
-		while (it != _renderQueue.end()) {
-			RenderTicket *ticket = *it;
-			ticket->_wantsDraw = false;
-			++it;
+		for (uint i = 0; i < _renderQueue.size(); i++) {
+			_renderQueue[i]->_wantsDraw = false;
 		}
 		return;
 	}
 
-	it = _renderQueue.begin();
-	_lastFrameIter = _renderQueue.end();
+	uint32 startTime = g_system->getMillis();
+	buildDirtyRects();
+
 	// A special case: If the screen has one giant OPAQUE rect to be drawn, then we skip filling
 	// the background color. Typical use-case: Fullscreen FMVs.
 	// Caveat: The FPS-counter will invalidate this.
-	if (it != _lastFrameIter && _renderQueue.front() == _renderQueue.back() && (*it)->_transform._alphaDisable == true) {
+	bool skipFill = false;
+	if (_renderQueue.size() == 1 && _renderQueue[0]->_transform._alphaDisable == true) {
 		// If our single opaque rect fills the dirty rect, we can skip filling.
-		if (*_dirtyRect != (*it)->_dstRect) {
-			// Apply the clear-color to the dirty rect.
-			_renderSurface->fillRect(*_dirtyRect, _clearColor);
+		skipFill = (*_dirtyRect == _renderQueue[0]->_dstRect);
+	}
+	if (!skipFill) {
+		// Apply the clear-color to the dirty rects.
+		for (uint i = 0; i < _dirtyRects.size(); i++) {
+			_renderSurface->fillRect(_dirtyRects[i], _clearColor);
 		}
-		// Otherwise Do NOT fill.
-	} else {
-		// Apply the clear-color to the dirty rect.
-		_renderSurface->fillRect(*_dirtyRect, _clearColor);
-	}
-	for (; it != _renderQueue.end(); ++it) {
-		RenderTicket *ticket = *it;
-		if (ticket->_dstRect.intersects(*_dirtyRect)) {
-			// dstClip is the area we want redrawn.
-			Common::Rect dstClip(ticket->_dstRect);
-			// reduce it to the dirty rect
-			dstClip.clip(*_dirtyRect);
-			// we need to keep track of the position to redraw the dirty rect
-			Common::Rect pos(dstClip);
-			int16 offsetX = ticket->_dstRect.left;
-			int16 offsetY = ticket->_dstRect.top;
-			// convert from screen-coords to surface-coords.
-			dstClip.translate(-offsetX, -offsetY);
-
-			drawFromSurface(ticket, &pos, &dstClip);
-			_needsFlip = true;
+	}
+
+	for (uint i = 0; i < _renderQueue.size(); i++) {
+		RenderTicket *ticket = _renderQueue[i];
+		for (uint j = 0; j < _dirtyRects.size(); j++) {
+			if (ticket->_dstRect.intersects(_dirtyRects[j])) {
+				// dstClip is the area we want redrawn.
+				Common::Rect dstClip(ticket->_dstRect);
+				// reduce it to the dirty rect
+				dstClip.clip(_dirtyRects[j]);
+				// we need to keep track of the position to redraw the dirty rect
+				Common::Rect pos(dstClip);
+				int16 offsetX = ticket->_dstRect.left;
+				int16 offsetY = ticket->_dstRect.top;
+				// convert from screen-coords to surface-coords.
+				dstClip.translate(-offsetX, -offsetY);
+
+				drawFromSurface(ticket, &pos, &dstClip);
+				_needsFlip = true;
+			}
 		}
 		// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldnt become clear-color)
 		ticket->_wantsDraw = false;
 	}
-	g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(_dirtyRect->left, _dirtyRect->top), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
+	for (uint i = 0; i < _dirtyRects.size(); i++) {
+		const Common::Rect &r = _dirtyRects[i];
+		g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(r.left, r.top), _renderSurface->pitch, r.left, r.top, r.width(), r.height());
+		_stats.dirtyPixels += r.width() * r.height();
+	}
+	_stats.dirtyRects = _dirtyRects.size();
+	_stats.drawTime = g_system->getMillis() - startTime;
 
-	it = _renderQueue.begin();
 	// Clean out the old tickets
-	while (it != _renderQueue.end()) {
-		if ((*it)->_isValid == false) {
-			RenderTicket *ticket = *it;
-			addDirtyRect((*it)->_dstRect);
-			it = _renderQueue.erase(it);
-			delete ticket;
+	uint kept = 0;
+	for (uint i = 0; i < _renderQueue.size(); i++) {
+		RenderTicket *ticket = _renderQueue[i];
+		if (ticket->_isValid == false) {
+			addDirtyRect(ticket->_dstRect);
+			deleteTicket(ticket);
 		} else {
-			++it;
+			_renderQueue[kept++] = ticket;
 		}
 	}
-
+	_renderQueue.resize(kept);
 }
 
 // Replacement for SDL2's SDL_RenderCopy
@@ -582,16 +721,10 @@ void BaseRenderOSystem::endSaveLoad() {
 	BaseRenderer::endSaveLoad();
 
 	// Clear the scale-buffered tickets as we just loaded.
-	RenderQueueIterator it = _renderQueue.begin();
-	while (it != _renderQueue.end()) {
-		RenderTicket *ticket = *it;
-		it = _renderQueue.erase(it);
-		delete ticket;
-	}
+	deleteAllTickets();
 	// HACK: After a save the buffer will be drawn before the scripts get to update it,
 	// so just skip this single frame.
 	_skipThisFrame = true;
-	_lastFrameIter = _renderQueue.end();
 
 	_renderSurface->fillRect(Common::Rect(0, 0, _renderSurface->w, _renderSurface->h), _renderSurface->format.ARGBToColor(255, 0, 0, 0));
 	g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, 0, 0, _renderSurface->w, _renderSurface->h);
@@ -29,16 +29,18 @@
 #define WINTERMUTE_BASE_RENDERER_SDL_H
 
 #include "engines/wintermute/base/gfx/base_renderer.h"
+#include "engines/wintermute/base/gfx/osystem/render_ticket.h"
 
+#include "common/array.h"
+#include "common/hashmap.h"
+#include "common/memorypool.h"
 #include "common/rect.h"
-#include "common/list.h"
 
 #include "graphics/surface.h"
 #include "graphics/transform_struct.h"
 
 namespace Wintermute {
 class BaseSurfaceOSystem;
-class RenderTicket;
 /**
  * A 2D-renderer implementation for WME.
  * This renderer makes use of a "ticket"-system, where all draw-calls
@@ -54,6 +56,12 @@ class RenderTicket;
  * being equal, this information is then used to check whether the draw order changed,
  * which will then create a need for redrawing, as we draw with an alpha-channel here.
  *
+ * The tickets of the previous frame are indexed by a hash of their draw
+ * arguments, so finding the ticket a draw-call can reuse does not depend on
+ * the number of tickets. The dirty areas are tracked on a grid of tiles, so
+ * changes in distant parts of the screen don't make everything in between
+ * get redrawn.
+ *
  * There is also a draw path that draws without tickets, for debugging purposes,
  * as well as to accommodate situations with large enough amounts of draw calls,
  * that there will be too much overhead involved with comparing the generated tickets.
@@ -63,7 +71,24 @@ public:
 	BaseRenderOSystem(BaseGame *inGame);
 	~BaseRenderOSystem() override;
 
-	typedef Common::List<RenderTicket *>::iterator RenderQueueIterator;
+	typedef Common::Array<RenderTicket *> RenderQueue;
+
+	/**
+	 * Statistics about the tickets of the last frame.
+	 */
+	struct TicketStats {
+		uint32 tickets;      ///< Tickets drawn.
+		uint32 reused;       ///< Tickets reused in the same order as the frame before.
+		uint32 moved;        ///< Tickets reused out of order, which makes them dirty.
+		uint32 created;      ///< New tickets.
+		uint32 deleted;      ///< Tickets of the frame before which were not drawn again.
+		uint32 compares;     ///< Ticket comparisons made while looking for reusable tickets.
+		uint32 dirtyRects;   ///< Rectangles redrawn.
+		uint32 dirtyPixels;  ///< Pixels redrawn.
+		uint32 drawTime;     ///< Milliseconds spent redrawing the dirty rectangles.
+	};
+
+	const TicketStats &getTicketStats() const { return _lastStats; }
 
 	Common::String getName() const override;
 
@@ -90,11 +115,11 @@ public:
 	 */
 	void drawFromTicket(RenderTicket *renderTicket);
 	/**
-	 * Re-insert an existing ticket into the queue, adding a dirty rect
-	 * out-of-order from last draw from the ticket.
-	 * @param ticket iterator pointing to the ticket to be added.
+	 * Re-insert a ticket of the last frame into the queue, adding a dirty rect
+	 * if it is drawn out-of-order from last draw from the ticket.
+	 * @param slot index of the ticket in the queue of the last frame.
 	 */
-	void drawFromQueuedTicket(const RenderQueueIterator &ticket);
+	void drawFromQueuedTicket(uint32 slot);
 
 	bool setViewport(int left, int top, int right, int bottom) override;
 	bool setViewport(Rect32 *rect) override { return BaseRenderer::setViewport(rect); }
@@ -122,19 +147,63 @@ private:
 	 * @param rect the region to be marked as dirty
 	 */
 	void addDirtyRect(const Common::Rect &rect);
+	void clearDirtyRect();
+	/**
+	 * Merge the dirty tiles into rectangles, stored in _dirtyRects
+	 */
+	void buildDirtyRects();
 	/**
 	 * Traverse the tickets that are dirty, and draw them
 	 */
 	void drawTickets();
+	/**
+	 * Make the tickets of this frame the ones the next frame is compared against
+	 */
+	void startNewFrame();
+	/**
+	 * Find a valid ticket of the last frame, which was not drawn again yet,
+	 * that equals the given one.
+	 * @return its slot in _lastFrameQueue, or kNoTicket
+	 */
+	uint32 findLastFrameTicket(const RenderTicket &compare);
+	static uint32 hashTicket(const RenderTicket &ticket);
+	RenderTicket *createTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform);
+	void deleteTicket(RenderTicket *ticket);
+	void deleteAllTickets();
 	// Non-dirty-rects:
 	void drawFromSurface(RenderTicket *ticket);
 	// Dirty-rects:
 	void drawFromSurface(RenderTicket *ticket, Common::Rect *dstRect, Common::Rect *clipRect);
+
+	enum {
+		kNoTicket = 0xFFFFFFFF,
+		kDirtyTileSize = 32,
+		kMaxDirtyRects = 64
+	};
+
 	Common::Rect *_dirtyRect;
-	Common::List<RenderTicket *> _renderQueue;
+	// dirty tiles of the render surface, and the rectangles merged from them
+	Common::Array<bool> _dirtyTiles;
+	int _dirtyTilesW;
+	int _dirtyTilesH;
+	Common::Array<Common::Rect> _dirtyRects;
+
+	Common::ObjectPool<RenderTicket, 64> _ticketPool;
+	// the tickets drawn this frame, in draw order
+	RenderQueue _renderQueue;
+	// the tickets of the last frame in their old order, drawn tickets
+	// leave an empty slot behind
+	RenderQueue _lastFrameQueue;
+	// first slot of _lastFrameQueue which was not drawn again yet
+	uint32 _lastFrameIndex;
+	// hash of a ticket to its first slot, and each slot to the next one with the same hash
+	Common::HashMap<uint32, uint32> _lastFrameHash;
+	Common::Array<uint32> _lastFrameChain;
+
+	TicketStats _stats;
+	TicketStats _lastStats;
 
 	bool _needsFlip;
-	RenderQueueIterator _lastFrameIter;
 	Common::Rect _renderRect;
 	Graphics::Surface *_renderSurface;
 	Graphics::Surface *_blankSurface;
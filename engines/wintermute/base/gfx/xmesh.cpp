@@ -80,7 +80,7 @@ bool XMesh::findBones(FrameNode *rootFrame) {
 	if (!_skinnedMesh) {
 		return true;
 	}
-	auto skinWeightsList = _skinMesh->_mesh->_skinWeightsList;
+	const BaseArray<SkinWeights> &skinWeightsList = _skinMesh->_mesh->_skinWeightsList;
 
 	_boneMatrices.resize(skinWeightsList.size());
 
@@ -90,13 +90,77 @@ bool XMesh::findBones(FrameNode *rootFrame) {
 		if (frame) {
 			_boneMatrices[i] = frame->getCombinedMatrix();
 		} else {
+			_boneMatrices[i] = nullptr;
 			warning("XMeshOpenGL::findBones could not find bone %s", skinWeightsList[i]._boneName.c_str());
 		}
 	}
 
+	buildInfluences();
+
 	return true;
 }
 
+//////////////////////////////////////////////////////////////////////////
+void XMesh::buildInfluences() {
+	const BaseArray<SkinWeights> &skinWeightsList = _skinMesh->_mesh->_skinWeightsList;
+	uint32 vertexCount = _skinMesh->_mesh->_vertexCount;
+
+	// the skin weights never change after loading
+	if (_influenceOffsets.size() == vertexCount + 1) {
+		return;
+	}
+
+	_influenceOffsets.resize(vertexCount + 1);
+	for (uint32 i = 0; i <= vertexCount; ++i) {
+		_influenceOffsets[i] = 0;
+	}
+
+	uint32 influenceCount = 0;
+	for (uint boneIndex = 0; boneIndex < skinWeightsList.size(); ++boneIndex) {
+		const BaseArray<uint32> &vertexIndices = skinWeightsList[boneIndex]._vertexIndices;
+		for (uint i = 0; i < vertexIndices.size(); ++i) {
+			if (vertexIndices[i] < vertexCount) {
+				_influenceOffsets[vertexIndices[i] + 1]++;
+				influenceCount++;
+			}
+		}
+	}
+
+	for (uint32 i = 0; i < vertexCount; ++i) {
+		_influenceOffsets[i + 1] += _influenceOffsets[i];
+	}
+
+	// bones are visited in order, so the weighted sums are accumulated
+	// in the same order as the bone-major loop did
+	_influenceBones.resize(influenceCount);
+	_influenceWeights.resize(influenceCount);
+	BaseArray<uint32> fill;
+	fill.resize(vertexCount);
+	for (uint32 i = 0; i < vertexCount; ++i) {
+		fill[i] = _influenceOffsets[i];
+	}
+
+	for (uint boneIndex = 0; boneIndex < skinWeightsList.size(); ++boneIndex) {
+		const BaseArray<uint32> &vertexIndices = skinWeightsList[boneIndex]._vertexIndices;
+		const BaseArray<float> &vertexWeights = skinWeightsList[boneIndex]._vertexWeights;
+		for (uint i = 0; i < vertexIndices.size(); ++i) {
+			uint32 vertexIndex = vertexIndices[i];
+			if (vertexIndex < vertexCount) {
+				uint32 slot = fill[vertexIndex]++;
+				_influenceBones[slot] = boneIndex;
+				_influenceWeights[slot] = vertexWeights[i];
+			}
+		}
+	}
+}
+
+// transforms the point v by the row-major matrix m, same as Matrix4::transform(v, true)
+static inline void transformPoint(const float *m, const float *v, float *out) {
+	out[0] = m[0] * v[0] + m[1] * v[1] + m[2] * v[2] + m[3];
+	out[1] = m[4] * v[0] + m[5] * v[1] + m[6] * v[2] + m[7];
+	out[2] = m[8] * v[0] + m[9] * v[1] + m[10] * v[2] + m[11];
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool XMesh::update(FrameNode *parentFrame) {
 	float *vertexData = _skinMesh->_mesh->_vertexData;
@@ -107,80 +171,74 @@ bool XMesh::update(FrameNode *parentFrame) {
 	float *vertexPositionData = _skinMesh->_mesh->_vertexPositionData;
 	float *vertexNormalData = _skinMesh->_mesh->_vertexNormalData;
 	uint32 vertexCount = _skinMesh->_mesh->_vertexCount;
-	auto skinWeightsList = _skinMesh->_mesh->_skinWeightsList;
+	const BaseArray<SkinWeights> &skinWeightsList = _skinMesh->_mesh->_skinWeightsList;
 
 	// update skinned mesh
 	if (_skinnedMesh) {
-		BaseArray<Math::Matrix4> finalBoneMatrices;
-		finalBoneMatrices.resize(_boneMatrices.size());
+		uint boneCount = MIN<uint>(skinWeightsList.size(), _boneMatrices.size());
+		_finalBoneMatrices.resize(boneCount);
+		_normalMatrices.resize(boneCount);
+
+		for (uint i = 0; i < boneCount; ++i) {
+			if (_boneMatrices[i]) {
+				_finalBoneMatrices[i] = *_boneMatrices[i] * skinWeightsList[i]._offsetMatrix;
+			} else {
+				_finalBoneMatrices[i] = skinWeightsList[i]._offsetMatrix;
+			}
 
-		for (uint i = 0; i < skinWeightsList.size(); ++i) {
-			finalBoneMatrices[i] = *_boneMatrices[i] * skinWeightsList[i]._offsetMatrix;
+			// vertex normals are transformed with the inverse transpose
+			_normalMatrices[i] = _finalBoneMatrices[i];
+			_normalMatrices[i].transpose();
+			_normalMatrices[i].inverse();
 		}
 
+		buildInfluences();
+
 		// the new vertex coordinates are the weighted sum of the product
 		// of the combined bone transformation matrices and the static pose coordinates
-		// to be able too add the weighted summands together, we reset everything to zero first
-		for (uint32 i = 0; i < vertexCount; ++i) {
-			for (int j = 0; j < 3; ++j) {
-				vertexData[i * XSkinMeshLoader::kVertexComponentCount + XSkinMeshLoader::kPositionOffset + j] = 0.0f;
-			}
-		}
+		// every vertex is finished in one go, so the output is written only once
+		const uint32 *offsets = _influenceOffsets.data();
+		const uint32 *bones = _influenceBones.data();
+		const float *weights = _influenceWeights.data();
 
-		for (uint boneIndex = 0; boneIndex < skinWeightsList.size(); ++boneIndex) {
-			// to every vertex which is affected by the bone, we add the product
-			// of the bone transformation with the coordinates of the static pose,
-			// weighted by the weight for the particular vertex
-			// repeating this procedure for all bones gives the new pose
-			for (uint i = 0; i < skinWeightsList[boneIndex]._vertexIndices.size(); ++i) {
-				uint32 vertexIndex = skinWeightsList[boneIndex]._vertexIndices[i];
-				Math::Vector3d pos;
-				pos.setData(vertexPositionData + vertexIndex * 3);
-				finalBoneMatrices[boneIndex].transform(&pos, true);
-				pos *= skinWeightsList[boneIndex]._vertexWeights[i];
-
-				for (uint j = 0; j < 3; ++j) {
-					vertexData[vertexIndex * XSkinMeshLoader::kVertexComponentCount + XSkinMeshLoader::kPositionOffset + j] += pos.getData()[j];
+		for (uint32 i = 0; i < vertexCount; ++i) {
+			const float *position = vertexPositionData + i * 3;
+			const float *normal = vertexNormalData + i * 3;
+			float pos[3] = { 0.0f, 0.0f, 0.0f };
+			float nrm[3] = { 0.0f, 0.0f, 0.0f };
+
+			for (uint32 k = offsets[i]; k < offsets[i + 1]; ++k) {
+				if (bones[k] >= boneCount) {
+					continue;
 				}
-			}
-		}
 
-		// now we have to update the vertex normals as well, so prepare the bone transformations
-		for (uint i = 0; i < skinWeightsList.size(); ++i) {
-			finalBoneMatrices[i].transpose();
-			finalBoneMatrices[i].inverse();
-		}
+				float transformed[3];
+				float weight = weights[k];
 
-		// reset so we can form the weighted sums
-		for (uint32 i = 0; i < vertexCount; ++i) {
-			for (int j = 0; j < 3; ++j) {
-				vertexData[i * XSkinMeshLoader::kVertexComponentCount + XSkinMeshLoader::kNormalOffset + j] = 0.0f;
-			}
-		}
+				transformPoint(_finalBoneMatrices[bones[k]].getData(), position, transformed);
+				pos[0] += transformed[0] * weight;
+				pos[1] += transformed[1] * weight;
+				pos[2] += transformed[2] * weight;
 
-		for (uint boneIndex = 0; boneIndex < skinWeightsList.size(); ++boneIndex) {
-			for (uint i = 0; i < skinWeightsList[boneIndex]._vertexIndices.size(); ++i) {
-				uint32 vertexIndex = skinWeightsList[boneIndex]._vertexIndices[i];
-				Math::Vector3d pos;
-				pos.setData(vertexNormalData + vertexIndex * 3);
-				finalBoneMatrices[boneIndex].transform(&pos, true);
-				pos *= skinWeightsList[boneIndex]._vertexWeights[i];
+				transformPoint(_normalMatrices[bones[k]].getData(), normal, transformed);
+				nrm[0] += transformed[0] * weight;
+				nrm[1] += transformed[1] * weight;
+				nrm[2] += transformed[2] * weight;
+			}
 
-				for (uint j = 0; j < 3; ++j) {
-					vertexData[vertexIndex * XSkinMeshLoader::kVertexComponentCount + XSkinMeshLoader::kNormalOffset + j] += pos.getData()[j];
-				}
+			float *vertex = vertexData + i * XSkinMeshLoader::kVertexComponentCount;
+			for (int j = 0; j < 3; ++j) {
+				vertex[XSkinMeshLoader::kPositionOffset + j] = pos[j];
+				vertex[XSkinMeshLoader::kNormalOffset + j] = nrm[j];
 			}
 		}
 
 	//updateNormals();
 	} else { // update static
-		for (uint32 i = 0; i < vertexCount; ++i) {
-			Math::Vector3d pos(vertexPositionData + 3 * i);
-			parentFrame->getCombinedMatrix()->transform(&pos, true);
+		const float *m = parentFrame->getCombinedMatrix()->getData();
 
-			for (uint j = 0; j < 3; ++j) {
-				vertexData[i * XSkinMeshLoader::kVertexComponentCount + XSkinMeshLoader::kPositionOffset + j] = pos.getData()[j];
-			}
+		for (uint32 i = 0; i < vertexCount; ++i) {
+			transformPoint(m, vertexPositionData + 3 * i, vertexData + i * XSkinMeshLoader::kVertexComponentCount + XSkinMeshLoader::kPositionOffset);
 		}
 	}
 
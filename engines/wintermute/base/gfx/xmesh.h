@@ -72,6 +72,7 @@ public:
 protected:
 
 	void updateBoundingBox();
+	void buildInfluences();
 
 	uint32 _numAttrs;
 
@@ -84,6 +85,16 @@ protected:
 
 	BaseArray<Math::Matrix4 *> _boneMatrices;
 
+	// vertex-major copy of the skin weights, the influences of vertex i
+	// are stored at [_influenceOffsets[i], _influenceOffsets[i + 1])
+	BaseArray<uint32> _influenceOffsets;
+	BaseArray<uint32> _influenceBones;
+	BaseArray<float> _influenceWeights;
+
+	// per frame bone transformations, kept to avoid reallocating them
+	BaseArray<Math::Matrix4> _finalBoneMatrices;
+	BaseArray<Math::Matrix4> _normalMatrices;
+
 	Common::Array<uint32> _adjacency;
 
 	BaseArray<Material *> _materials;
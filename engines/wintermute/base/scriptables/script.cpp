@@ -188,6 +188,10 @@ bool ScScript::initTables() {
 		_symbols[index] = getString();
 	}
 
+	VarCache emptyCache = { nullptr, nullptr, 0 };
+	_varCache.clear();
+	_varCache.resize(_numSymbols, emptyCache);
+
 	// load functions table
 	_iP = _header.funcTable;
 
@@ -396,6 +400,7 @@ void ScScript::cleanup() {
 	}
 	_symbols = nullptr;
 	_numSymbols = 0;
+	_varCache.clear();
 
 	if (_globals && !_thread) {
 		delete _globals;
@@ -555,6 +560,7 @@ bool ScScript::executeInstruction() {
 	ScValue *op1;
 	ScValue *op2;
 
+	uint32 instIP = _iP;
 	uint32 inst = getDWORD();
 
 #ifdef ENABLE_FOXTAIL
@@ -742,7 +748,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_VAR: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getSymbolVar(getDWORD());
 		// Disabled in original code
 		/*if (false && var->_type==VAL_OBJECT || var->_type == VAL_NATIVE) {
 			_operand->setReference(var);
@@ -754,15 +760,14 @@ bool ScScript::executeInstruction() {
 	}
 
 	case II_PUSH_VAR_REF: {
-		ScValue *var = getVar(_symbols[getDWORD()]);
+		ScValue *var = getSymbolVar(getDWORD());
 		_operand->setReference(var);
 		_stack->push(_operand);
 		break;
 	}
 
 	case II_POP_VAR: {
-		char *varName = _symbols[getDWORD()];
-		ScValue *var = getVar(varName);
+		ScValue *var = getSymbolVar(getDWORD());
 		if (var) {
 			ScValue *val = _stack->pop();
 			if (!val) {
@@ -813,7 +818,7 @@ bool ScScript::executeInstruction() {
 		break;
 
 	case II_PUSH_THIS:
-		_operand->setReference(getVar(_symbols[getDWORD()]));
+		_operand->setReference(getSymbolVar(getDWORD()));
 		_thisStack->push(_operand);
 		break;
 
@@ -823,7 +828,7 @@ bool ScScript::executeInstruction() {
 
 	case II_PUSH_BY_EXP: {
 		str = _stack->pop()->getString();
-		ScValue *val = _stack->pop()->getProp(str);
+		ScValue *val = _stack->pop()->getProp(str, _propCache[instIP % kPropCacheSize]);
 		if (val) {
 			_stack->push(val);
 		} else {
@@ -1215,6 +1220,30 @@ ScValue *ScScript::getVar(char *name) {
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+ScValue *ScScript::getSymbolVar(uint32 symbol) {
+	if (symbol >= _varCache.size()) {
+		return getVar(_symbols[symbol]);
+	}
+
+	ScValue *scope = _scopeStack->_sP >= 0 ? _scopeStack->getTop() : nullptr;
+	bool plain = (!scope || scope->hasPlainProps()) && _globals->hasPlainProps() && _engine->_globals->hasPlainProps();
+
+	VarCache &cache = _varCache[symbol];
+	if (plain && cache._version == ScValue::getPropsVersion() && cache._scope == scope) {
+		return cache._value;
+	}
+
+	ScValue *ret = getVar(_symbols[symbol]);
+	if (plain) {
+		cache._scope = scope;
+		cache._value = ret;
+		cache._version = ScValue::getPropsVersion();
+	}
+	return ret;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 bool ScScript::waitFor(BaseObject *object) {
 	if (_unbreakable) {
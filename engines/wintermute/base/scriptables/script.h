@@ -31,6 +31,7 @@
 
 #include "engines/wintermute/base/base.h"
 #include "engines/wintermute/base/scriptables/dcscript.h"   // Added by ClassView
+#include "engines/wintermute/base/scriptables/script_value.h"
 #include "engines/wintermute/coll_templ.h"
 #include "engines/wintermute/persistent.h"
 
@@ -39,7 +40,6 @@ class BaseScriptHolder;
 class BaseObject;
 class ScEngine;
 class ScStack;
-class ScValue;
 
 class ScScript : public BaseClass {
 public:
@@ -79,6 +79,7 @@ public:
 	TScriptState _state;
 	TScriptState _origState;
 	ScValue *getVar(char *name);
+	ScValue *getSymbolVar(uint32 symbol);
 	uint32 getFuncPos(const Common::String &name);
 	uint32 getEventPos(const Common::String &name) const;
 	uint32 getMethodPos(const Common::String &name) const;
@@ -157,6 +158,21 @@ private:
 	TEventPos *_events;
 	uint32 _numExternals;
 	TExternalFunction *_externals;
+
+	// The symbol table indices are the atoms the compiled code refers to
+	// variables by, so the variable lookups are cached per symbol
+	struct VarCache {
+		ScValue *_scope;
+		ScValue *_value;
+		uint32 _version;
+	};
+	Common::Array<VarCache> _varCache;
+
+	// property lookups by expression, cached per instruction
+	enum {
+		kPropCacheSize = 64
+	};
+	ScPropCache _propCache[kPropCacheSize];
 	uint32 _numFunctions;
 	uint32 _numMethods;
 	uint32 _numEvents;
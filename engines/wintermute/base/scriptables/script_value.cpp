@@ -41,6 +41,8 @@ namespace Wintermute {
 
 IMPLEMENT_PERSISTENT(ScValue, false)
 
+uint32 ScValue::_propsVersion = 1;
+
 //////////////////////////////////////////////////////////////////////////
 ScValue::ScValue(BaseGame *inGame) : BaseClass(inGame) {
 	_type = VAL_NULL;
@@ -190,6 +192,24 @@ ScValue *ScValue::getProp(const char *name) {
 	return ret;
 }
 
+//////////////////////////////////////////////////////////////////////////
+ScValue *ScValue::getProp(const char *name, ScPropCache &cache) {
+	if (cache._object == this && cache._version == _propsVersion && _type == VAL_OBJECT && cache._name == name) {
+		return cache._value;
+	}
+
+	ScValue *ret = getProp(name);
+
+	// natives, strings and references compute their properties
+	if (ret && _type == VAL_OBJECT) {
+		cache._object = this;
+		cache._value = ret;
+		cache._version = _propsVersion;
+		cache._name = name;
+	}
+	return ret;
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool ScValue::deleteProp(const char *name) {
 	if (_type == VAL_VARIABLE_REF) {
@@ -200,6 +220,7 @@ bool ScValue::deleteProp(const char *name) {
 	if (_valIter != _valObject.end()) {
 		delete _valIter->_value;
 		_valIter->_value = nullptr;
+		propsChanged();
 	}
 
 	return STATUS_OK;
@@ -225,8 +246,10 @@ bool ScValue::setProp(const char *name, ScValue *val, bool copyWhole, bool setAs
 		if (_valIter != _valObject.end()) {
 			newVal = _valIter->_value;
 		}
+		bool added = false;
 		if (!newVal) {
 			newVal = new ScValue(_gameRef);
+			added = true;
 		} else {
 			newVal->cleanup();
 		}
@@ -234,6 +257,9 @@ bool ScValue::setProp(const char *name, ScValue *val, bool copyWhole, bool setAs
 		newVal->copy(val, copyWhole);
 		newVal->_isConstVar = setAsConst;
 		_valObject[name] = newVal;
+		if (added) {
+			propsChanged();
+		}
 
 		if (_type != VAL_NATIVE) {
 			_type = VAL_OBJECT;
@@ -271,6 +297,10 @@ bool ScValue::propExists(const char *name) {
 
 //////////////////////////////////////////////////////////////////////////
 void ScValue::deleteProps() {
+	if (!_valObject.empty()) {
+		propsChanged();
+	}
+
 	_valIter = _valObject.begin();
 	while (_valIter != _valObject.end()) {
 		delete(ScValue *)_valIter->_value;
@@ -503,6 +533,7 @@ void ScValue::setNative(BaseScriptable *val, bool persistent) {
 
 		_type = VAL_NATIVE;
 		_persistent = persistent;
+		propsChanged();
 
 		_valNative = val;
 		if (_valNative && !_persistent) {
@@ -736,6 +767,7 @@ void ScValue::copy(ScValue *orig, bool copyWhole) {
 
 	// copy properties
 	if (orig->_type == VAL_OBJECT && orig->_valObject.size() > 0) {
+		propsChanged();
 		orig->_valIter = orig->_valObject.begin();
 		while (orig->_valIter != orig->_valObject.end()) {
 			_valObject[orig->_valIter->_key] = new ScValue(_gameRef);
@@ -817,6 +849,7 @@ bool ScValue::persist(BasePersistenceManager *persistMgr) {
 			_valObject[str] = val;
 			delete[] str;
 		}
+		propsChanged();
 	}
 
 	persistMgr->transferPtr(TMEMBER_PTR(_valRef));
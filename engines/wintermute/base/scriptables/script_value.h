@@ -38,6 +38,21 @@ namespace Wintermute {
 
 class ScScript;
 class BaseScriptable;
+class ScValue;
+
+/**
+ * Remembers where a property lookup found its value, so looking up the
+ * same name on the same object again can skip the hash map, as long as
+ * no property of any object was added or removed in between.
+ */
+struct ScPropCache {
+	ScValue *_object;
+	ScValue *_value;
+	uint32 _version;
+	Common::String _name;
+
+	ScPropCache() : _object(nullptr), _value(nullptr), _version(0) {}
+};
 
 class ScValue : public BaseClass {
 public:
@@ -82,6 +97,12 @@ public:
 	bool isObject();
 	bool setProp(const char *name, ScValue *val, bool copyWhole = false, bool setAsConst = false);
 	ScValue *getProp(const char *name);
+	ScValue *getProp(const char *name, ScPropCache &cache);
+	// true if the properties are only the ones stored in _valObject
+	bool hasPlainProps() const { return _type == VAL_NULL || _type == VAL_OBJECT; }
+
+	// changes whenever a property of any value is added, removed or replaced
+	static uint32 getPropsVersion() { return _propsVersion; }
 	BaseScriptable *_valNative;
 	ScValue *_valRef;
 private:
@@ -89,6 +110,9 @@ private:
 	int32 _valInt;
 	double _valFloat;
 	char *_valString;
+
+	static uint32 _propsVersion;
+	static void propsChanged() { _propsVersion++; }
 public:
 	TValType _type;
 	ScValue(BaseGame *inGame);
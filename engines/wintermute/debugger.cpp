@@ -22,6 +22,7 @@
 #include "engines/wintermute/debugger.h"
 #include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/base_file_manager.h"
+#include "engines/wintermute/base/gfx/osystem/base_render_osystem.h"
 #include "engines/wintermute/base/scriptables/script_value.h"
 #include "engines/wintermute/debugger/debugger_controller.h"
 #include "engines/wintermute/wintermute.h"
@@ -34,6 +35,7 @@ Console::Console(WintermuteEngine *vm) : GUI::Debugger(), _engineRef(vm) {
 	registerCmd("show_fps", WRAP_METHOD(Console, Cmd_ShowFps));
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
+	registerCmd("render_stats", WRAP_METHOD(Console, Cmd_RenderStats));
 	registerCmd("help", WRAP_METHOD(Console, Cmd_Help));
 	// Actual (script) debugger commands
 	registerCmd(STEP_CMD, WRAP_METHOD(Console, Cmd_Step));
@@ -306,6 +308,21 @@ bool Console::Cmd_ShowFps(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::Cmd_RenderStats(int argc, const char **argv) {
+	BaseRenderOSystem *renderer = dynamic_cast<BaseRenderOSystem *>(BaseEngine::getRenderer());
+	if (!renderer) {
+		debugPrintf("The game is not using the 2D renderer\n");
+		return true;
+	}
+
+	const BaseRenderOSystem::TicketStats &stats = renderer->getTicketStats();
+	debugPrintf("Tickets: %d (reused: %d, moved: %d, new: %d, deleted: %d)\n",
+	            stats.tickets, stats.reused, stats.moved, stats.created, stats.deleted);
+	debugPrintf("Ticket comparisons: %d\n", stats.compares);
+	debugPrintf("Dirty rects: %d, %d pixels, drawn in %d ms\n", stats.dirtyRects, stats.dirtyPixels, stats.drawTime);
+	return true;
+}
+
 bool Console::Cmd_DumpFile(int argc, const char **argv) {
 	if (argc != 3) {
 		debugPrintf("Usage: %s <file path> <output file name>\n", argv[0]);
@@ -105,12 +105,37 @@ int getStringWidthImpl(const Font &font, const StringType &str) {
 	return space;
 }
 
+template<class StringType>
+bool drawStringRunImpl(const Font &font, Surface *dst, const StringType &str, int x, int y, int w, uint32 color, TextAlign align, int deltax) {
+	return font.drawStringRun(dst, str, x, y, w, color, align, deltax, nullptr);
+}
+
+template<class StringType>
+bool drawStringRunImpl(const Font &font, ManagedSurface *dst, const StringType &str, int x, int y, int w, uint32 color, TextAlign align, int deltax) {
+	bool drawn;
+	if (dst->hasTransparentColor()) {
+		uint32 transColor = dst->getTransparentColor();
+		drawn = font.drawStringRun(dst->surfacePtr(), str, x, y, w, color, align, deltax, &transColor);
+	} else {
+		drawn = font.drawStringRun(dst->surfacePtr(), str, x, y, w, color, align, deltax, nullptr);
+	}
+
+	// Mark the same area drawChar would have marked for all the characters
+	if (drawn)
+		dst->addDirtyRect(font.getBoundingBox(str, x, y, w, align, deltax));
+	return drawn;
+}
+
 template<class SurfaceType, class StringType>
 void drawStringImpl(const Font &font, SurfaceType *dst, const StringType &str, int x, int y, int w, uint32 color, TextAlign align, int deltax) {
 	// The logic in getBoundingImpl is the same as we use here. In case we
 	// ever change something here we will need to change it there too.
 	assert(dst != 0);
 
+	// Fonts which cache whole text runs draw them in one go
+	if (drawStringRunImpl(font, dst, str, x, y, w, color, align, deltax))
+		return;
+
 	const int leftX = x, rightX = x + w + 1;
 	int width = font.getStringWidth(str);
 
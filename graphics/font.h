@@ -212,6 +212,23 @@ public:
 	virtual void drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const = 0;
 	virtual void drawChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 color) const;
 
+	/**
+	 * Draw a whole string in one go instead of character by character.
+	 *
+	 * This is used by drawString. Fonts which keep pre-composited text runs
+	 * can override it to skip the per character work. The implementation
+	 * must only draw when the result matches what drawChar would produce
+	 * for every character, and return false otherwise.
+	 *
+	 * @param transparentColor  The transparent color of @p dst, or nullptr.
+	 *
+	 * @return True if the string has been drawn, false to fall back to
+	 *         drawing it character by character.
+	 */
+	virtual bool drawStringRun(Surface *dst, const Common::String &str, int x, int y, int w, uint32 color, TextAlign align, int deltax, const uint32 *transparentColor) const { return false; }
+	/** @overload */
+	virtual bool drawStringRun(Surface *dst, const Common::U32String &str, int x, int y, int w, uint32 color, TextAlign align, int deltax, const uint32 *transparentColor) const { return false; }
+
 	/** @overload */
 
 	/**
@@ -87,6 +87,15 @@ inline int divRoundToNearest(int dividend, int divisor) {
 	return (dividend + (divisor / 2)) / divisor;
 }
 
+// Width and height of a glyph atlas page
+const int kAtlasPageSize = 256;
+
+// Default number of pre-composited text runs kept per font
+const uint kDefaultMaxTextRuns = 128;
+
+// Upper bound for the memory used by the text run coverage surfaces
+const uint32 kMaxTextRunBytes = 1024 * 1024;
+
 } // End of anonymous namespace
 
 class TTFLibrary : public Common::Singleton<TTFLibrary> {
@@ -161,6 +170,12 @@ public:
 	void drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color) const override;
 	void drawChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 color) const override;
 
+	bool drawStringRun(Surface *dst, const Common::String &str, int x, int y, int w, uint32 color, TextAlign align, int deltax, const uint32 *transparentColor) const override;
+	bool drawStringRun(Surface *dst, const Common::U32String &str, int x, int y, int w, uint32 color, TextAlign align, int deltax, const uint32 *transparentColor) const override;
+
+	void getCacheStats(TTFCacheStats &stats) const;
+	void setRunCacheSize(uint maxRuns);
+
 private:
 	bool _initialized;
 	FT_Face _face;
@@ -184,6 +199,84 @@ private:
 	bool _allowLateCaching;
 	void assureCached(uint32 chr) const;
 
+	/**
+	 * Glyph images are packed into a few large atlas pages using a simple
+	 * shelf allocator instead of owning one surface per glyph. Each glyph's
+	 * image is a sub area of its page.
+	 */
+	struct AtlasPage {
+		Surface surface;
+		int shelfY, shelfHeight;
+		int cursorX;
+	};
+
+	typedef Common::Array<AtlasPage *> AtlasPageList;
+	mutable AtlasPageList _atlasPages;
+	bool allocateGlyphImage(Surface &image, int w, int h) const;
+	void freeAtlas();
+
+	struct KerningPairHash {
+		uint operator()(uint64 pair) const { return (uint)(pair ^ (pair >> 32)); }
+	};
+
+	typedef Common::HashMap<uint64, int, KerningPairHash> KerningCache;
+	mutable KerningCache _kerning;
+
+	/**
+	 * A laid out string: the coverage of all its glyphs composited into a
+	 * single surface, along with what drawString needs to know to clip and
+	 * align it.
+	 */
+	struct TextRun {
+		Surface coverage;
+		int originX, originY;     ///< Offset of coverage relative to the pen position
+		int width;                ///< Logical width, as returned by getStringWidth
+		int minRight, maxRight;   ///< Range of the glyph bounding box right edges
+		TextRun *prev, *next;     ///< Neighbours in the LRU list, most recently used first
+		Common::String byteKey;   ///< Key in _byteRuns for runs of byte strings
+		Common::U32String key;    ///< Key in _runs for runs of UTF-32 strings
+		bool isByteRun;
+		bool overlapping;         ///< Glyphs overlap, so the run is drawn glyph by glyph
+	};
+
+	/**
+	 * Byte strings are drawn as code points 0-255. Their runs are kept under
+	 * the byte string itself, so looking them up needs no converted copy.
+	 * Runs of both kinds share one LRU list and one memory budget.
+	 */
+	typedef Common::HashMap<Common::U32String, TextRun *> TextRunCache;
+	typedef Common::HashMap<Common::String, TextRun *> ByteTextRunCache;
+	mutable TextRunCache _runs;
+	mutable ByteTextRunCache _byteRuns;
+	mutable TextRun *_runsHead, *_runsTail;
+	mutable uint32 _runBytes;
+	uint _maxRuns;
+	mutable uint32 _runHits, _runMisses, _runEvictions;
+
+	uint getRunCount() const { return _runs.size() + _byteRuns.size(); }
+	static uint32 getRunChar(const Common::String &str, uint i) { return (Common::String::unsigned_type)str[i]; }
+	static uint32 getRunChar(const Common::U32String &str, uint i) { return str[i]; }
+	TextRunCache &getRunCache(const Common::U32String &) const { return _runs; }
+	ByteTextRunCache &getRunCache(const Common::String &) const { return _byteRuns; }
+	static void setRunKey(TextRun *run, const Common::U32String &str) { run->key = str; run->isByteRun = false; }
+	static void setRunKey(TextRun *run, const Common::String &str) { run->byteKey = str; run->isByteRun = true; }
+
+	template<class StringType>
+	const TextRun *findTextRun(const StringType &str) const;
+	template<class StringType>
+	void layoutTextRun(const StringType &str, TextRun &layout, Common::Rect &bbox) const;
+	template<class StringType>
+	const TextRun *addTextRun(const StringType &str, const TextRun &layout, const Common::Rect &bbox) const;
+	void linkTextRun(TextRun *run) const;
+	void unlinkTextRun(TextRun *run) const;
+	void evictTextRun() const;
+	void clearTextRuns();
+	template<class StringType>
+	bool drawTextRun(Surface *dst, const StringType &str, int x, int y, int w, uint32 color,
+		TextAlign align, int deltax, const uint32 *transparentColor) const;
+	void drawCoverage(Surface *dst, const Surface &coverage, int x, int y, uint32 color,
+		const uint32 *transparentColor) const;
+
 	Common::SeekableReadStream *readTTFTable(FT_ULong tag) const;
 
 	int computePointSize(int size, TTFSizeMode sizeMode) const;
@@ -203,7 +296,8 @@ private:
 TTFFont::TTFFont()
 	: _initialized(false), _face(), _ttfFile(0), _size(0), _width(0), _height(0), _ascent(0),
 	  _descent(0), _glyphs(), _loadFlags(FT_LOAD_TARGET_NORMAL), _renderMode(FT_RENDER_MODE_NORMAL),
-	  _hasKerning(false), _allowLateCaching(false), _fakeBold(false), _fakeItalic(false) {
+	  _hasKerning(false), _allowLateCaching(false), _runsHead(nullptr), _runsTail(nullptr), _runBytes(0),
+	  _maxRuns(kDefaultMaxTextRuns), _runHits(0), _runMisses(0), _runEvictions(0), _fakeBold(false), _fakeItalic(false) {
 }
 
 TTFFont::~TTFFont() {
@@ -213,11 +307,11 @@ TTFFont::~TTFFont() {
 		delete[] _ttfFile;
 		_ttfFile = 0;
 
-		for (GlyphCache::iterator i = _glyphs.begin(), end = _glyphs.end(); i != end; ++i)
-			i->_value.image.free();
-
 		_initialized = false;
 	}
+
+	clearTextRuns();
+	freeAtlas();
 }
 
 bool TTFFont::load(Common::SeekableReadStream &stream, int size, TTFSizeMode sizeMode,
@@ -565,6 +659,11 @@ int TTFFont::getKerningOffset(uint32 left, uint32 right) const {
 	if (!_hasKerning)
 		return 0;
 
+	const uint64 pair = ((uint64)left << 32) | right;
+	KerningCache::const_iterator kerningEntry = _kerning.find(pair);
+	if (kerningEntry != _kerning.end())
+		return kerningEntry->_value;
+
 	assureCached(left);
 	assureCached(right);
 
@@ -590,7 +689,9 @@ int TTFFont::getKerningOffset(uint32 left, uint32 right) const {
 
 	FT_Vector kerningVector;
 	FT_Get_Kerning(_face, leftGlyph, rightGlyph, FT_KERNING_DEFAULT, &kerningVector);
-	return (kerningVector.x / 64);
+	const int offset = kerningVector.x / 64;
+	_kerning[pair] = offset;
+	return offset;
 }
 
 Common::Rect TTFFont::getBoundingBox(uint32 chr) const {
@@ -672,7 +773,7 @@ void TTFFont::drawChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 col
 	dst->addDirtyRect(charBox);
 }
 
-void TTFFont::drawChar(Surface * dst, uint32 chr, int x, int y, uint32 color,
+void TTFFont::drawChar(Surface *dst, uint32 chr, int x, int y, uint32 color,
 		const uint32 *transparentColor) const {
 	assureCached(chr);
 	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
@@ -680,19 +781,20 @@ void TTFFont::drawChar(Surface * dst, uint32 chr, int x, int y, uint32 color,
 		return;
 
 	const Glyph &glyph = glyphEntry->_value;
+	drawCoverage(dst, glyph.image, x + glyph.xOffset, y + glyph.yOffset, color, transparentColor);
+}
 
-	x += glyph.xOffset;
-	y += glyph.yOffset;
-
+void TTFFont::drawCoverage(Surface *dst, const Surface &coverage, int x, int y, uint32 color,
+		const uint32 *transparentColor) const {
 	if (x > dst->w)
 		return;
 	if (y > dst->h)
 		return;
 
-	int w = glyph.image.w;
-	int h = glyph.image.h;
+	int w = coverage.w;
+	int h = coverage.h;
 
-	const uint8 *srcPos = (const uint8 *)glyph.image.getPixels();
+	const uint8 *srcPos = (const uint8 *)coverage.getPixels();
 
 	// Make sure we are not drawing outside the screen bounds
 	if (x < 0) {
@@ -708,7 +810,7 @@ void TTFFont::drawChar(Surface * dst, uint32 chr, int x, int y, uint32 color,
 		return;
 
 	if (y < 0) {
-		srcPos -= y * glyph.image.pitch;
+		srcPos -= y * coverage.pitch;
 		h += y;
 		y = 0;
 	}
@@ -737,14 +839,14 @@ void TTFFont::drawChar(Surface * dst, uint32 chr, int x, int y, uint32 color,
 			}
 
 			dstPos += dst->pitch;
-			srcPos += glyph.image.pitch;
+			srcPos += coverage.pitch;
 		}
 	} else if (dst->format.bytesPerPixel == 1) {
-		renderGlyph<uint8>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format, transparentColor);
+		renderGlyph<uint8>(dstPos, dst->pitch, srcPos, coverage.pitch, w, h, color, dst->format, transparentColor);
 	} else if (dst->format.bytesPerPixel == 2) {
-		renderGlyph<uint16>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format, transparentColor);
+		renderGlyph<uint16>(dstPos, dst->pitch, srcPos, coverage.pitch, w, h, color, dst->format, transparentColor);
 	} else if (dst->format.bytesPerPixel == 4) {
-		renderGlyph<uint32>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format, transparentColor);
+		renderGlyph<uint32>(dstPos, dst->pitch, srcPos, coverage.pitch, w, h, color, dst->format, transparentColor);
 	}
 }
 
@@ -813,7 +915,13 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	}
 
 
-	glyph.image.create(bitmap->width, bitmap->rows, PixelFormat::createFormatCLUT8());
+	if (bitmap->pixel_mode != FT_PIXEL_MODE_MONO && bitmap->pixel_mode != FT_PIXEL_MODE_GRAY) {
+		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap->pixel_mode);
+		return false;
+	}
+
+	if (!allocateGlyphImage(glyph.image, bitmap->width, bitmap->rows))
+		return false;
 
 	const uint8 *src = bitmap->buffer;
 	int srcPitch = bitmap->pitch;
@@ -824,8 +932,7 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 
 	uint8 *dst = (uint8 *)glyph.image.getPixels();
 
-	switch (bitmap->pixel_mode) {
-	case FT_PIXEL_MODE_MONO:
+	if (bitmap->pixel_mode == FT_PIXEL_MODE_MONO) {
 		for (int y = 0; y < (int)bitmap->rows; ++y) {
 			const uint8 *curSrc = src;
 			uint8 mask = 0;
@@ -835,28 +942,20 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 					mask = *curSrc++;
 
 				if (mask & 0x80)
-					*dst = 255;
+					dst[x] = 255;
 
 				mask <<= 1;
-				++dst;
 			}
 
+			dst += glyph.image.pitch;
 			src += srcPitch;
 		}
-		break;
-
-	case FT_PIXEL_MODE_GRAY:
+	} else {
 		for (int y = 0; y < (int)bitmap->rows; ++y) {
 			memcpy(dst, src, bitmap->width);
 			dst += glyph.image.pitch;
 			src += srcPitch;
 		}
-		break;
-
-	default:
-		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap->pixel_mode);
-		glyph.image.free();
-		return false;
 	}
 
 #if FAKE_BOLD == 1
@@ -879,6 +978,301 @@ void TTFFont::assureCached(uint32 chr) const {
 	}
 }
 
+bool TTFFont::allocateGlyphImage(Surface &image, int w, int h) const {
+	// Blank glyphs like the space character need no storage
+	if (!w || !h)
+		return true;
+
+	if (w > kAtlasPageSize || h > kAtlasPageSize) {
+		// Oversized glyphs get a page of their own. Keep it in front, so
+		// the last page stays the one we are filling.
+		AtlasPage *page = new AtlasPage();
+		page->surface.create(w, h, PixelFormat::createFormatCLUT8());
+		page->shelfY = 0;
+		page->shelfHeight = h;
+		page->cursorX = w;
+		_atlasPages.insert_at(0, page);
+
+		image = page->surface.getSubArea(Common::Rect(w, h));
+		return true;
+	}
+
+	AtlasPage *page = _atlasPages.empty() ? nullptr : _atlasPages.back();
+	if (page && page->cursorX + w > kAtlasPageSize) {
+		// Start a new shelf below the current one
+		page->shelfY += page->shelfHeight;
+		page->shelfHeight = 0;
+		page->cursorX = 0;
+	}
+
+	if (!page || page->shelfY + h > kAtlasPageSize) {
+		page = new AtlasPage();
+		page->surface.create(kAtlasPageSize, kAtlasPageSize, PixelFormat::createFormatCLUT8());
+		page->shelfY = 0;
+		page->shelfHeight = 0;
+		page->cursorX = 0;
+		_atlasPages.push_back(page);
+	}
+
+	image = page->surface.getSubArea(Common::Rect(page->cursorX, page->shelfY, page->cursorX + w, page->shelfY + h));
+	page->cursorX += w;
+	page->shelfHeight = MAX(page->shelfHeight, h);
+	return true;
+}
+
+void TTFFont::freeAtlas() {
+	for (AtlasPageList::iterator i = _atlasPages.begin(); i != _atlasPages.end(); ++i) {
+		(*i)->surface.free();
+		delete *i;
+	}
+
+	_atlasPages.clear();
+	_glyphs.clear();
+}
+
+template<class StringType>
+const TTFFont::TextRun *TTFFont::findTextRun(const StringType &str) const {
+	typename Common::HashMap<StringType, TextRun *>::iterator runEntry = getRunCache(str).find(str);
+	if (runEntry == getRunCache(str).end())
+		return nullptr;
+
+	TextRun *run = runEntry->_value;
+	unlinkTextRun(run);
+	linkTextRun(run);
+	return run;
+}
+
+template<class StringType>
+void TTFFont::layoutTextRun(const StringType &str, TextRun &layout, Common::Rect &bbox) const {
+	// Lay out the run the same way drawString does
+	int minRight = 0, maxRight = 0;
+	int x = 0;
+	uint32 last = 0;
+	bbox = Common::Rect();
+	for (uint i = 0; i < str.size(); ++i) {
+		const uint32 cur = getRunChar(str, i);
+		x += getKerningOffset(last, cur);
+		last = cur;
+
+		Common::Rect charBox = getBoundingBox(cur);
+		const int right = x + charBox.right;
+		if (i == 0 || right < minRight)
+			minRight = right;
+		if (i == 0 || right > maxRight)
+			maxRight = right;
+
+		if (!charBox.isEmpty()) {
+			charBox.translate(x, 0);
+			if (bbox.isEmpty())
+				bbox = charBox;
+			else
+				bbox.extend(charBox);
+		}
+
+		x += getCharWidth(cur);
+	}
+
+	layout.originX = bbox.left;
+	layout.originY = bbox.top;
+	layout.width = x;
+	layout.minRight = minRight;
+	layout.maxRight = maxRight;
+}
+
+template<class StringType>
+const TTFFont::TextRun *TTFFont::addTextRun(const StringType &str, const TextRun &layout, const Common::Rect &bbox) const {
+	const uint32 runBytes = bbox.width() * bbox.height();
+	if (runBytes > kMaxTextRunBytes / 8) {
+		// Not worth evicting a good part of the cache for a single run
+		return nullptr;
+	}
+
+	while (_runsTail && (getRunCount() >= _maxRuns || _runBytes + runBytes > kMaxTextRunBytes))
+		evictTextRun();
+
+	TextRun *run = new TextRun();
+	run->originX = layout.originX;
+	run->originY = layout.originY;
+	run->width = layout.width;
+	run->minRight = layout.minRight;
+	run->maxRight = layout.maxRight;
+	run->overlapping = false;
+	setRunKey(run, str);
+
+	if (runBytes) {
+		run->coverage.create(bbox.width(), bbox.height(), PixelFormat::createFormatCLUT8());
+
+		int x = 0;
+		uint32 last = 0;
+		for (uint i = 0; i < str.size() && !run->overlapping; ++i) {
+			const uint32 cur = getRunChar(str, i);
+			x += getKerningOffset(last, cur);
+			last = cur;
+
+			GlyphCache::const_iterator glyphEntry = _glyphs.find(cur);
+			if (glyphEntry != _glyphs.end()) {
+				const Glyph &glyph = glyphEntry->_value;
+				const uint8 *src = (const uint8 *)glyph.image.getPixels();
+				uint8 *dst = (uint8 *)run->coverage.getBasePtr(x + glyph.xOffset - bbox.left, glyph.yOffset - bbox.top);
+
+				// Blending glyphs one after the other can't be reproduced
+				// with their combined coverage where they overlap
+				for (int cy = 0; cy < glyph.image.h && !run->overlapping; ++cy) {
+					for (int cx = 0; cx < glyph.image.w; ++cx) {
+						if (dst[cx] && src[cx])
+							run->overlapping = true;
+						dst[cx] |= src[cx];
+					}
+
+					src += glyph.image.pitch;
+					dst += run->coverage.pitch;
+				}
+			}
+
+			x += getCharWidth(cur);
+		}
+
+		// Still keep the run, so the next draw knows without compositing
+		if (run->overlapping)
+			run->coverage.free();
+	}
+
+	getRunCache(str)[str] = run;
+	linkTextRun(run);
+	_runBytes += run->coverage.w * run->coverage.h;
+	return run;
+}
+
+void TTFFont::linkTextRun(TextRun *run) const {
+	run->prev = nullptr;
+	run->next = _runsHead;
+	if (_runsHead)
+		_runsHead->prev = run;
+	else
+		_runsTail = run;
+	_runsHead = run;
+}
+
+void TTFFont::unlinkTextRun(TextRun *run) const {
+	if (run->prev)
+		run->prev->next = run->next;
+	else
+		_runsHead = run->next;
+	if (run->next)
+		run->next->prev = run->prev;
+	else
+		_runsTail = run->prev;
+}
+
+void TTFFont::evictTextRun() const {
+	TextRun *oldest = _runsTail;
+	unlinkTextRun(oldest);
+	if (oldest->isByteRun)
+		_byteRuns.erase(oldest->byteKey);
+	else
+		_runs.erase(oldest->key);
+
+	_runBytes -= oldest->coverage.w * oldest->coverage.h;
+	oldest->coverage.free();
+	delete oldest;
+	++_runEvictions;
+}
+
+void TTFFont::clearTextRuns() {
+	for (TextRun *run = _runsHead; run; ) {
+		TextRun *next = run->next;
+		run->coverage.free();
+		delete run;
+		run = next;
+	}
+
+	_runs.clear();
+	_byteRuns.clear();
+	_runsHead = _runsTail = nullptr;
+	_runBytes = 0;
+}
+
+bool TTFFont::drawStringRun(Surface *dst, const Common::String &str, int x, int y, int w, uint32 color,
+		TextAlign align, int deltax, const uint32 *transparentColor) const {
+	if (!_maxRuns || str.empty())
+		return false;
+
+	return drawTextRun(dst, str, x, y, w, color, align, deltax, transparentColor);
+}
+
+bool TTFFont::drawStringRun(Surface *dst, const Common::U32String &str, int x, int y, int w, uint32 color,
+		TextAlign align, int deltax, const uint32 *transparentColor) const {
+	if (!_maxRuns || str.empty())
+		return false;
+
+	return drawTextRun(dst, str, x, y, w, color, align, deltax, transparentColor);
+}
+
+template<class StringType>
+bool TTFFont::drawTextRun(Surface *dst, const StringType &str, int x, int y, int w, uint32 color,
+		TextAlign align, int deltax, const uint32 *transparentColor) const {
+	// Paletted targets use a coverage threshold instead of blending, which
+	// a pre-composited run can not reproduce for overlapping glyphs
+	if (w <= 0 || dst->format.bytesPerPixel == 1)
+		return false;
+
+	const TextRun *run = findTextRun(str);
+	TextRun layout;
+	Common::Rect bbox;
+	if (run) {
+		++_runHits;
+	} else {
+		++_runMisses;
+		layoutTextRun(str, layout, bbox);
+	}
+	const TextRun &metrics = run ? *run : layout;
+
+	const int leftX = x, rightX = x + w + 1;
+
+	if (align == kTextAlignCenter)
+		x = x + (w - metrics.width)/2;
+	else if (align == kTextAlignRight)
+		x = x + w - metrics.width;
+	x += deltax;
+
+	// drawString skips or stops at characters outside of the text area. Only
+	// draw the run when this does not affect any of its characters, and
+	// don't cache runs which would not be drawn anyway.
+	if (x + metrics.minRight < leftX || x + metrics.maxRight > rightX)
+		return false;
+
+	if (!run) {
+		run = addTextRun(str, layout, bbox);
+		if (!run)
+			return false;
+	}
+	if (run->overlapping)
+		return false;
+
+	drawCoverage(dst, run->coverage, x + run->originX, y + run->originY, color, transparentColor);
+	return true;
+}
+
+void TTFFont::getCacheStats(TTFCacheStats &stats) const {
+	stats.glyphs = _glyphs.size();
+	stats.atlasPages = _atlasPages.size();
+	stats.atlasBytes = 0;
+	for (AtlasPageList::const_iterator i = _atlasPages.begin(); i != _atlasPages.end(); ++i)
+		stats.atlasBytes += (*i)->surface.w * (*i)->surface.h;
+	stats.kerningPairs = _kerning.size();
+	stats.runs = getRunCount();
+	stats.runBytes = _runBytes;
+	stats.runHits = _runHits;
+	stats.runMisses = _runMisses;
+	stats.runEvictions = _runEvictions;
+}
+
+void TTFFont::setRunCacheSize(uint maxRuns) {
+	_maxRuns = maxRuns;
+	while (_runsTail && getRunCount() > _maxRuns)
+		evictTextRun();
+}
+
 Font *loadTTFFont(Common::SeekableReadStream &stream, int size, TTFSizeMode sizeMode, uint dpi, TTFRenderMode renderMode, const uint32 *mapping, bool stemDarkening) {
 	TTFFont *font = new TTFFont();
 
@@ -1100,6 +1494,21 @@ Font *findTTFace(const Common::Array<Common::String> &files, const Common::U32St
 	return font;
 }
 
+bool getTTFCacheStats(const Font *font, TTFCacheStats &stats) {
+	const TTFFont *ttfFont = dynamic_cast<const TTFFont *>(font);
+	if (!ttfFont)
+		return false;
+
+	ttfFont->getCacheStats(stats);
+	return true;
+}
+
+void setTTFRunCacheSize(Font *font, uint maxRuns) {
+	TTFFont *ttfFont = dynamic_cast<TTFFont *>(font);
+	if (ttfFont)
+		ttfFont->setRunCacheSize(maxRuns);
+}
+
 } // End of namespace Graphics
 
 namespace Common {
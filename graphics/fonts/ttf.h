@@ -138,6 +138,41 @@ Font *loadTTFFontFromArchive(const Common::String &filename, int size, TTFSizeMo
  */
 Font *findTTFace(const Common::Array<Common::String> &files, const Common::U32String &faceName, bool bold, bool italic, int size, uint dpi = 0, TTFRenderMode renderMode = kTTFRenderModeLight, const uint32 *mapping = 0);
 
+/**
+ * Statistics about the glyph atlas and text run cache of a TTF font.
+ */
+struct TTFCacheStats {
+	uint32 glyphs;          ///< Number of rasterized glyphs.
+	uint32 atlasPages;      ///< Number of glyph atlas pages.
+	uint32 atlasBytes;      ///< Memory used by the glyph atlas pages.
+	uint32 kerningPairs;    ///< Number of cached kerning pairs.
+	uint32 runs;            ///< Number of cached text runs.
+	uint32 runBytes;        ///< Memory used by the cached text runs.
+	uint32 runHits;         ///< Text run lookups served from the cache.
+	uint32 runMisses;       ///< Text run lookups which had to lay out the run.
+	uint32 runEvictions;    ///< Text runs dropped to stay within the budget.
+};
+
+/**
+ * Query the cache statistics of a font loaded through one of the TTF loaders.
+ *
+ * @param font   The font to query.
+ * @param stats  Receives the statistics.
+ * @return false in case @p font is not a TTF font.
+ */
+bool getTTFCacheStats(const Font *font, TTFCacheStats &stats);
+
+/**
+ * Set the maximum number of text runs a TTF font keeps pre-composited.
+ *
+ * Passing 0 disables the text run cache, so strings are always drawn
+ * glyph by glyph.
+ *
+ * @param font     The font to configure.
+ * @param maxRuns  The maximum number of cached text runs.
+ */
+void setTTFRunCacheSize(Font *font, uint maxRuns);
+
 void shutdownTTF();
 
 } // End of namespace Graphics
@@ -36,6 +36,12 @@
 
 #include "engines/engine.h"
 
+#ifdef USE_FREETYPE2
+#include "graphics/fonts/ttf.h"
+#include "gui/gui-manager.h"
+#include "gui/ThemeEngine.h"
+#endif
+
 #include "gui/debugger.h"
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 	#include "gui/console.h"
@@ -81,6 +87,9 @@ Debugger::Debugger() {
 	registerCmd("debugflag_list",		WRAP_METHOD(Debugger, cmdDebugFlagsList));
 	registerCmd("debugflag_enable",	WRAP_METHOD(Debugger, cmdDebugFlagEnable));
 	registerCmd("debugflag_disable",	WRAP_METHOD(Debugger, cmdDebugFlagDisable));
+#ifdef USE_FREETYPE2
+	registerCmd("ttf_cache",		WRAP_METHOD(Debugger, cmdTTFCache));
+#endif
 }
 
 Debugger::~Debugger() {
@@ -855,6 +864,34 @@ bool Debugger::cmdDebugFlagDisable(int argc, const char **argv) {
 	return true;
 }
 
+#ifdef USE_FREETYPE2
+bool Debugger::cmdTTFCache(int argc, const char **argv) {
+	static const char *const styleNames[ThemeEngine::kFontStyleMax] = {
+		"bold", "normal", "italic", "fixed", "fixed bold", "fixed italic",
+		"tooltip", "console", "lang extra"
+	};
+
+	ThemeEngine *theme = g_gui.theme();
+	if (!theme) {
+		debugPrintf("No GUI theme is loaded\n");
+		return true;
+	}
+
+	debugPrintf("%-12s %6s %5s %8s %7s %5s %8s %8s %8s %8s\n", "font", "glyphs", "pages", "atlas", "kerning",
+				"runs", "runbytes", "hits", "misses", "evicted");
+	for (int i = 0; i < ThemeEngine::kFontStyleMax; i++) {
+		Graphics::TTFCacheStats stats;
+		if (!Graphics::getTTFCacheStats(theme->getFont((ThemeEngine::FontStyle)i), stats))
+			continue;
+
+		debugPrintf("%-12s %6u %5u %8u %7u %5u %8u %8u %8u %8u\n", styleNames[i], stats.glyphs, stats.atlasPages,
+					stats.atlasBytes, stats.kerningPairs, stats.runs, stats.runBytes, stats.runHits,
+					stats.runMisses, stats.runEvictions);
+	}
+	return true;
+}
+#endif
+
 // Console handler
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 bool Debugger::debuggerInputCallback(GUI::ConsoleDialog *console, const char *input, void *refCon) {
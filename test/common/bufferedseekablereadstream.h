@@ -91,4 +91,73 @@ class BufferedSeekableReadStreamTestSuite : public CxxTest::TestSuite {
 
 		delete &ssrs;
 	}
+
+	void test_adaptive_random_access() {
+		byte contents[5000];
+		for (int i = 0; i < 5000; i++)
+			contents[i] = (byte)(i * 7);
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+
+		Common::SeekableReadStream *ssrs
+			= Common::wrapAdaptiveBufferedSeekableReadStream(&ms, 16, 256, DisposeAfterUse::NO);
+
+		const int offsets[] = { 0, 10, 4990, 100, 90, 1000, 1020, 1010, 300, 4000 };
+		const uint32 sizes[] = { 5, 400, 20, 1, 50, 3000, 7, 2, 300, 1000 };
+		byte buf[3000];
+		for (int i = 0; i < ARRAYSIZE(offsets); i++) {
+			TS_ASSERT(ssrs->seek(offsets[i]));
+			TS_ASSERT_EQUALS(ssrs->pos(), offsets[i]);
+
+			uint32 expected = MIN<uint32>(sizes[i], sizeof(contents) - offsets[i]);
+			TS_ASSERT_EQUALS(ssrs->read(buf, sizes[i]), expected);
+			TS_ASSERT_EQUALS(memcmp(buf, contents + offsets[i], expected), 0);
+			TS_ASSERT_EQUALS(ssrs->eos(), expected < sizes[i]);
+		}
+
+		TS_ASSERT(ssrs->seek(-1, SEEK_END));
+		TS_ASSERT_EQUALS(ssrs->readByte(), contents[4999]);
+		TS_ASSERT(!ssrs->eos());
+		ssrs->readByte();
+		TS_ASSERT(ssrs->eos());
+
+		delete ssrs;
+	}
+
+	void test_adaptive_stats() {
+		byte contents[4096];
+		for (int i = 0; i < 4096; i++)
+			contents[i] = (byte)i;
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+
+		Common::SeekableReadStream *ssrs
+			= Common::wrapAdaptiveBufferedSeekableReadStream(&ms, 64, 1024, DisposeAfterUse::NO);
+
+		Common::BufferedStreamStats stats;
+		TS_ASSERT(!Common::getBufferedStreamStats(&ms, stats));
+		TS_ASSERT(Common::getBufferedStreamStats(ssrs, stats));
+		TS_ASSERT_EQUALS(stats.refills, 0u);
+
+		// Sequential reads grow the buffer: 64 + 128 + 256 + 512 + 1024 bytes
+		for (int i = 0; i < 1984; i++)
+			TS_ASSERT_EQUALS(ssrs->readByte(), contents[i]);
+		Common::getBufferedStreamStats(ssrs, stats);
+		TS_ASSERT_EQUALS(stats.refills, 5u);
+		TS_ASSERT_EQUALS(stats.bytesRead, 1984u);
+
+		// Seeking back into a previous block does not read again
+		ssrs->seek(200);
+		TS_ASSERT_EQUALS(ssrs->readByte(), contents[200]);
+		Common::getBufferedStreamStats(ssrs, stats);
+		TS_ASSERT_EQUALS(stats.refills, 5u);
+		TS_ASSERT_EQUALS(stats.blockHits, 1u);
+
+		// Seeking elsewhere starts over with the small buffer
+		ssrs->seek(3000);
+		TS_ASSERT_EQUALS(ssrs->readByte(), contents[3000]);
+		Common::getBufferedStreamStats(ssrs, stats);
+		TS_ASSERT_EQUALS(stats.refills, 6u);
+		TS_ASSERT_EQUALS(stats.bytesRead, 2048u);
+
+		delete ssrs;
+	}
 };
@@ -0,0 +1,243 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/flathashmap.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/system.h"
+#include "common/debug.h"
+
+#include "../null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+class FlatHashMapTestSuite : public CxxTest::TestSuite
+{
+	typedef Common::FlatHashMap<Common::String, Common::String, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> StringFlatMap;
+
+	public:
+	void test_empty_clear() {
+		Common::FlatHashMap<int, int> container;
+		TS_ASSERT(container.empty());
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(!container.empty());
+		container.clear();
+		TS_ASSERT(container.empty());
+
+		StringFlatMap container2;
+		TS_ASSERT(container2.empty());
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(!container2.empty());
+		container2.clear(true);
+		TS_ASSERT(container2.empty());
+		TS_ASSERT(!container2.contains("foo"));
+	}
+
+	void test_contains() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		TS_ASSERT(container.contains(0));
+		TS_ASSERT(container.contains(1));
+		TS_ASSERT(!container.contains(17));
+		TS_ASSERT(!container.contains(-1));
+
+		StringFlatMap container2;
+		container2["foo"] = "bar";
+		container2["quux"] = "blub";
+		TS_ASSERT(container2.contains("foo"));
+		TS_ASSERT(container2.contains("QUUX"));
+		TS_ASSERT(container2.contains(Common::String("Foo")));
+		TS_ASSERT(!container2.contains("bar"));
+		TS_ASSERT(!container2.contains("asdf"));
+	}
+
+	void test_const_char_lookup() {
+		StringFlatMap container;
+		container["Music_Volume"] = "192";
+
+		const char *key = "music_volume";
+		TS_ASSERT(container.contains(key));
+		TS_ASSERT_EQUALS(container.getValOrDefault(key), "192");
+		TS_ASSERT_EQUALS(container.getValOrDefault("sfx_volume", "255"), "255");
+
+		Common::String out;
+		TS_ASSERT(container.tryGetVal(key, out));
+		TS_ASSERT_EQUALS(out, "192");
+		TS_ASSERT(!container.tryGetVal("speech_volume", out));
+
+		StringFlatMap::const_iterator it = container.find(key);
+		TS_ASSERT(it != container.end());
+		TS_ASSERT_EQUALS(it->_key, "Music_Volume");
+	}
+
+	void test_add_remove() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+		container[3] = 12;
+		container[4] = 96;
+		TS_ASSERT(container.contains(1));
+		container.erase(1);
+		TS_ASSERT(!container.contains(1));
+		container[1] = 42;
+		TS_ASSERT(container.contains(1));
+		TS_ASSERT_EQUALS(container[1], 42);
+		container.erase(0);
+		container.erase(1);
+		container.erase(2);
+		container.erase(3);
+		TS_ASSERT(!container.empty());
+		container.erase(4);
+		TS_ASSERT(container.empty());
+	}
+
+	void test_erase_while_iterating() {
+		Common::FlatHashMap<int, int> container;
+		for (int i = 0; i < 100; i++)
+			container[i] = i * 2;
+
+		for (Common::FlatHashMap<int, int>::iterator it = container.begin(); it != container.end(); ++it) {
+			if (it->_key % 2)
+				container.erase(it);
+		}
+
+		TS_ASSERT_EQUALS(container.size(), 50u);
+		for (int i = 0; i < 100; i++) {
+			TS_ASSERT_EQUALS(container.contains(i), (i % 2) == 0);
+			if ((i % 2) == 0)
+				TS_ASSERT_EQUALS(container[i], i * 2);
+		}
+	}
+
+	void test_grow_and_churn() {
+		Common::FlatHashMap<int, Common::String> container;
+		for (int i = 0; i < 5000; i++)
+			container[i] = Common::String::format("%d", i);
+		TS_ASSERT_EQUALS(container.size(), 5000u);
+
+		// Repeated insertions and deletions leave deleted slots behind,
+		// which must not make the map grow without bounds or lose entries.
+		for (int round = 0; round < 20; round++) {
+			for (int i = 0; i < 5000; i++)
+				container.erase(i);
+			TS_ASSERT(container.empty());
+			for (int i = 0; i < 5000; i++)
+				container.setVal(i + round, Common::String::format("%d", i + round));
+			container.clear();
+		}
+
+		for (int i = 0; i < 1000; i++)
+			container[i] = Common::String::format("%d", i);
+		for (int i = 0; i < 1000; i++)
+			TS_ASSERT_EQUALS(container.getVal(i), Common::String::format("%d", i));
+	}
+
+	void test_set_val_from_own_node() {
+		StringFlatMap container;
+		container["first"] = "a value longer than the inline storage of a string";
+
+		// Inserting new keys makes the map grow, which must not invalidate
+		// the value while it is being copied.
+		for (int i = 0; i < 100; i++)
+			container.setVal(Common::String::format("key%d", i), container.getVal("first"));
+
+		for (int i = 0; i < 100; i++)
+			TS_ASSERT_EQUALS(container.getVal(Common::String::format("key%d", i)), container.getVal("first"));
+	}
+
+	void test_copy() {
+		Common::FlatHashMap<int, int> map1;
+		for (int i = 0; i < 100; i++)
+			map1[i] = i;
+		map1.erase(50);
+
+		Common::FlatHashMap<int, int> map2(map1);
+		TS_ASSERT_EQUALS(map2.size(), 99u);
+		TS_ASSERT(!map2.contains(50));
+		TS_ASSERT_EQUALS(map2[99], 99);
+
+		Common::FlatHashMap<int, int> map3;
+		map3[1000] = 1;
+		map3 = map1;
+		TS_ASSERT(!map3.contains(1000));
+		TS_ASSERT_EQUALS(map3.size(), 99u);
+
+		map1[1] = 42;
+		TS_ASSERT_EQUALS(map2[1], 1);
+		TS_ASSERT_EQUALS(map3[1], 1);
+	}
+
+	void test_iterator() {
+		Common::FlatHashMap<int, int> container;
+		container[0] = 17;
+		container[1] = 33;
+		container[2] = 45;
+
+		int keySum = 0, valueSum = 0;
+		for (Common::FlatHashMap<int, int>::const_iterator it = container.begin(); it != container.end(); ++it) {
+			keySum += it->_key;
+			valueSum += it->_value;
+		}
+		TS_ASSERT_EQUALS(keySum, 3);
+		TS_ASSERT_EQUALS(valueSum, 95);
+
+		Common::FlatHashMap<int, int> empty;
+		TS_ASSERT(empty.begin() == empty.end());
+	}
+
+	void test_lookup_speed() {
+#if BENCHMARK_TIME
+		Common::install_null_g_system();
+
+#ifdef SLOW_TESTS
+		const int iters = 200;
+#else
+		const int iters = 1;
+#endif
+		const int numKeys = 2000;
+
+		Common::Array<Common::String> keys;
+		for (int i = 0; i < numKeys; i++)
+			keys.push_back(Common::String::format("Some_Config_Key_%d", i));
+
+		Common::StringMap hashMap;
+		StringFlatMap flatMap;
+		for (int i = 0; i < numKeys; i++) {
+			hashMap[keys[i]] = keys[i];
+			flatMap[keys[i]] = keys[i];
+		}
+
+		uint hits = 0;
+		uint32 start = g_system->getMillis();
+		for (int n = 0; n < iters; n++)
+			for (int i = 0; i < numKeys; i++)
+				hits += hashMap.contains(keys[(i * 7) % numKeys]);
+		uint32 hashMapTime = g_system->getMillis() - start;
+
+		start = g_system->getMillis();
+		for (int n = 0; n < iters; n++)
+			for (int i = 0; i < numKeys; i++)
+				hits += flatMap.contains(keys[(i * 7) % numKeys]);
+		uint32 flatMapTime = g_system->getMillis() - start;
+
+		start = g_system->getMillis();
+		for (int n = 0; n < iters; n++)
+			for (int i = 0; i < numKeys; i++)
+				hits += flatMap.contains(keys[(i * 7) % numKeys].c_str());
+		uint32 flatMapCharTime = g_system->getMillis() - start;
+
+		TS_ASSERT_EQUALS(hits, 3u * iters * numKeys);
+
+		debug("HashMap lookups, %d iters (in milliseconds): %d", iters, hashMapTime);
+		debug("FlatHashMap lookups, %d iters (in milliseconds): %d", iters, flatMapTime);
+		debug("FlatHashMap const char * lookups, %d iters (in milliseconds): %d", iters, flatMapCharTime);
+#endif
+	}
+};
@@ -0,0 +1,191 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/fs.h"
+#include "common/memstream.h"
+#include "common/system.h"
+#include "common/debug.h"
+
+#include "../null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(POSIX) && defined(HAS_MMAP)
+#include "backends/fs/posix/posix-iostream.h"
+#define MMAP_IS_AVAILABLE 1
+#else
+#define MMAP_IS_AVAILABLE 0
+#endif
+
+// Copied next to the test runner by the test makefile
+#define MMAP_TEST_FILE "test/engine-data/encoding.dat"
+
+class MmapStreamTestSuite : public CxxTest::TestSuite
+{
+#if MMAP_IS_AVAILABLE
+	static uint32 checksum(const byte *data, uint32 size) {
+		uint32 sum = 0;
+		for (uint32 i = 0; i < size; i++)
+			sum = sum * 31 + data[i];
+		return sum;
+	}
+
+	static uint32 readAll(Common::SeekableReadStream &stream) {
+		byte buf[4096];
+		uint32 sum = 0;
+		stream.seek(0);
+		while (!stream.eos()) {
+			uint32 n = stream.read(buf, sizeof(buf));
+			for (uint32 i = 0; i < n; i++)
+				sum = sum * 31 + buf[i];
+		}
+		return sum;
+	}
+
+	// Resident set size in pages, or 0 if unknown
+	static uint32 residentPages() {
+		Common::FSNode node("/proc/self/statm");
+		Common::SeekableReadStream *stream = node.createReadStream();
+		if (!stream)
+			return 0;
+
+		uint32 total = 0, resident = 0;
+		Common::String line = stream->readLine();
+		delete stream;
+		if (sscanf(line.c_str(), "%u %u", &total, &resident) != 2)
+			return 0;
+		return resident;
+	}
+#endif
+
+	public:
+	void test_matches_stdio() {
+#if MMAP_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::FSNode node(MMAP_TEST_FILE);
+		TS_ASSERT(node.exists());
+		if (!node.exists())
+			return;
+
+		Common::MemoryReadStream *stream = dynamic_cast<Common::MemoryReadStream *>(node.createMappedReadStream());
+		Common::SeekableReadStream *stdioStream = node.createReadStream();
+		TS_ASSERT(stream);
+		TS_ASSERT(stdioStream);
+		if (!stream || !stdioStream) {
+			delete stream;
+			delete stdioStream;
+			return;
+		}
+		TS_ASSERT_EQUALS(stream->size(), stdioStream->size());
+
+		const uint32 size = stream->size();
+		const uint32 expected = readAll(*stdioStream);
+		TS_ASSERT_EQUALS(readAll(*stream), expected);
+		TS_ASSERT_EQUALS(checksum(stream->getData(), size), expected);
+
+		TS_ASSERT(stream->seek(-4, SEEK_END));
+		TS_ASSERT(stdioStream->seek(-4, SEEK_END));
+		TS_ASSERT_EQUALS(stream->readUint32LE(), stdioStream->readUint32LE());
+		TS_ASSERT(!stream->eos());
+		stream->readByte();
+		TS_ASSERT(stream->eos());
+
+		delete stdioStream;
+		delete stream;
+#endif
+	}
+
+	void test_not_mapped_by_default() {
+#if MMAP_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::FSNode node(MMAP_TEST_FILE);
+		TS_ASSERT(node.exists());
+		if (!node.exists())
+			return;
+
+		// Regular read streams always go through stdio
+		Common::SeekableReadStream *stream = node.createReadStream();
+		TS_ASSERT(stream);
+		TS_ASSERT(!dynamic_cast<Common::MemoryReadStream *>(stream));
+		delete stream;
+
+		// Reading /proc files through a mapping does not work
+		TS_ASSERT(!PosixMmapStream::makeFromPath("/proc/self/statm"));
+#endif
+	}
+
+	void test_mapped_archive_member() {
+#if MMAP_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::FSNode node(MMAP_TEST_FILE);
+		TS_ASSERT(node.exists());
+		if (!node.exists())
+			return;
+
+		Common::SearchSet searchSet;
+		searchSet.addDirectory("test", node.getParent());
+
+		Common::SeekableReadStream *stream = searchSet.createMappedReadStreamForMember(node.getName());
+		TS_ASSERT(dynamic_cast<Common::MemoryReadStream *>(stream));
+		delete stream;
+
+		// Plain lookups are unaffected by mapped ones
+		stream = searchSet.createReadStreamForMember(node.getName());
+		TS_ASSERT(stream);
+		TS_ASSERT(!dynamic_cast<Common::MemoryReadStream *>(stream));
+		delete stream;
+
+		TS_ASSERT(!searchSet.createMappedReadStreamForMember("missing.dat"));
+#endif
+	}
+
+	void test_read_speed() {
+#if MMAP_IS_AVAILABLE
+		Common::install_null_g_system();
+
+#ifdef SLOW_TESTS
+		const int iters = 500;
+#else
+		const int iters = 10;
+#endif
+
+		Common::FSNode node(MMAP_TEST_FILE);
+		TS_ASSERT(node.exists());
+		if (!node.exists())
+			return;
+
+		uint32 sum = 0;
+		int32 rssBefore = residentPages();
+		uint32 start = g_system->getMillis();
+		for (int n = 0; n < iters; n++) {
+			PosixIoStream *stream = PosixIoStream::makeFromPath(node.getPath(), false);
+			byte *buf = (byte *)malloc(stream->size());
+			stream->read(buf, stream->size());
+			sum += checksum(buf, stream->size());
+			free(buf);
+			delete stream;
+		}
+		uint32 stdioTime = g_system->getMillis() - start;
+		int32 stdioPages = (int32)residentPages() - rssBefore;
+
+		rssBefore = residentPages();
+		start = g_system->getMillis();
+		for (int n = 0; n < iters; n++) {
+			Common::MemoryReadStream *stream = dynamic_cast<Common::MemoryReadStream *>(node.createMappedReadStream());
+			TS_ASSERT(stream);
+			if (!stream)
+				break;
+			sum -= checksum(stream->getData(), stream->size());
+			delete stream;
+		}
+		uint32 mmapTime = g_system->getMillis() - start;
+		int32 mmapPages = (int32)residentPages() - rssBefore;
+
+		TS_ASSERT_EQUALS(sum, 0u);
+
+		debug("StdioStream read into buffer, %d iters (in milliseconds): %d, resident pages grown: %d", iters, stdioTime, stdioPages);
+		debug("Mapped stream getData(), %d iters (in milliseconds): %d, resident pages grown: %d", iters, mmapTime, mmapPages);
+#endif
+	}
+};
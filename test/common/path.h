@@ -95,4 +95,28 @@ class PathTestSuite : public CxxTest::TestSuite
 		TS_ASSERT_EQUALS(Common::Path("../foo/../bar", '/').normalize().toString(), "../bar");
 		TS_ASSERT_EQUALS(Common::Path("../../foo/bar/", '/').normalize().toString(), "../../foo/bar");
 	}
+
+	void test_ignore_case_and_mac() {
+		Common::Path::IgnoreCaseAndMac_EqualsTo equals;
+		Common::Path::IgnoreCaseAndMac_Hash hash;
+
+		Common::Path a("Parent/Dir/File.txt");
+		Common::Path b("parent/dir/FILE.TXT");
+		Common::Path c("parent/dir/other.txt");
+		TS_ASSERT(equals(a, b));
+		TS_ASSERT(!equals(a, c));
+		TS_ASSERT_EQUALS(hash(a), hash(b));
+
+		// Paths which only differ in their separators are the same
+		Common::Path mac("Sound Manager 3.1 : SoundLib/Sound");
+		Common::Path sep("Sound Manager 3.1 / SoundLib", ':');
+		sep = sep.appendComponent("Sound");
+		TS_ASSERT(equals(mac, sep));
+		TS_ASSERT_EQUALS(hash(mac), hash(sep));
+
+		// Punycode encoded components are compared decoded
+		Common::Path puny("xn--Sound Manager 3.1  SoundLib-lba84k/Sound");
+		TS_ASSERT(equals(mac, puny));
+		TS_ASSERT_EQUALS(hash(mac), hash(puny));
+	}
 };
@@ -0,0 +1,200 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/threadpool.h"
+#include "common/system.h"
+#include "common/debug.h"
+
+#include "../null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+class ThreadPoolTestSuite : public CxxTest::TestSuite
+{
+	// Squares every index of its range into a shared array
+	struct SquareRange {
+		Common::Array<uint32> *values;
+
+		void operator()(uint first, uint last) const {
+			for (uint i = first; i < last; i++)
+				(*values)[i] = i * i;
+		}
+	};
+
+	// Counts the calls it got into the index of the range
+	struct CountRange {
+		Common::Array<uint32> *counts;
+
+		void operator()(uint first, uint last) const {
+			for (uint i = first; i < last; i++)
+				(*counts)[i]++;
+		}
+	};
+
+	// Splits its range in half on the pool until it is small
+	class SumTask : public Common::Task {
+	public:
+		SumTask(Common::ThreadPool *pool, uint first, uint last) :
+			_pool(pool), _first(first), _last(last), _sum(0) {}
+
+		void run() override {
+			if (_last - _first <= 64) {
+				for (uint i = _first; i < _last; i++)
+					_sum += i;
+				return;
+			}
+			uint middle = (_first + _last) / 2;
+			SumTask left(_pool, _first, middle), right(_pool, middle, _last);
+			Common::TaskGroup group;
+			_pool->submit(&left, group);
+			right.run();
+			_pool->wait(group);
+			_sum = left._sum + right._sum;
+		}
+
+		Common::ThreadPool *_pool;
+		uint _first, _last;
+		uint64 _sum;
+	};
+
+	class SlowSum : public Common::Future<uint64> {
+	public:
+		SlowSum(uint count) : _count(count) {}
+
+	protected:
+		uint64 compute() override {
+			uint64 sum = 0;
+			for (uint i = 0; i < _count; i++)
+				sum += i;
+			return sum;
+		}
+
+		uint _count;
+	};
+
+	// Some floating point work per element, to give the workers something to do
+	struct HeavyRange {
+		Common::Array<float> *values;
+
+		void operator()(uint first, uint last) const {
+			for (uint i = first; i < last; i++) {
+				float x = (float)i;
+				for (int j = 0; j < 64; j++)
+					x = x * 0.999f + 1.0f;
+				(*values)[i] = x;
+			}
+		}
+	};
+
+	static void checkParallelFor(Common::ThreadPool *pool) {
+		Common::Array<uint32> values;
+		values.resize(10000, 0);
+		SquareRange square;
+		square.values = &values;
+		pool->parallelFor(0, values.size(), square);
+		for (uint i = 0; i < values.size(); i++)
+			TS_ASSERT_EQUALS(values[i], i * i);
+
+		// Every index is visited exactly once, whatever the grain size
+		const uint grainSizes[] = { 0, 1, 7, 100, 20000 };
+		for (uint g = 0; g < ARRAYSIZE(grainSizes); g++) {
+			Common::Array<uint32> counts;
+			counts.resize(1000, 0);
+			CountRange count;
+			count.counts = &counts;
+			pool->parallelFor(10, 990, count, grainSizes[g]);
+			for (uint i = 0; i < counts.size(); i++)
+				TS_ASSERT_EQUALS(counts[i], (i >= 10 && i < 990) ? 1u : 0u);
+		}
+
+		// Empty ranges do not call the function
+		Common::Array<uint32> counts;
+		counts.resize(1, 0);
+		CountRange count;
+		count.counts = &counts;
+		pool->parallelFor(5, 5, count);
+		pool->parallelFor(5, 2, count);
+		TS_ASSERT_EQUALS(counts[0], 0u);
+	}
+
+	static void checkNestedTasks(Common::ThreadPool *pool) {
+		SumTask task(pool, 0, 100000);
+		Common::TaskGroup group;
+		pool->submit(&task, group);
+		pool->wait(group);
+		TS_ASSERT_EQUALS(task._sum, 100000ull * 99999ull / 2);
+	}
+
+	static void checkFutures(Common::ThreadPool *pool) {
+		SlowSum started(10000), lazy(1000);
+		started.start(pool);
+		TS_ASSERT_EQUALS(lazy.get(), 1000ull * 999ull / 2);
+		TS_ASSERT_EQUALS(started.get(), 10000ull * 9999ull / 2);
+		// The result stays available
+		TS_ASSERT_EQUALS(started.get(), 10000ull * 9999ull / 2);
+	}
+
+	public:
+	void test_synchronous_pool() {
+		Common::ThreadPool pool;
+		TS_ASSERT_EQUALS(pool.getNumWorkers(), 0u);
+		checkParallelFor(&pool);
+		checkNestedTasks(&pool);
+		checkFutures(&pool);
+	}
+
+	void test_system_pool() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::ThreadPool *pool = g_system->getThreadPool();
+		TS_ASSERT(pool);
+		TS_ASSERT_EQUALS(g_system->getThreadPool(), pool);
+		checkParallelFor(pool);
+		checkNestedTasks(pool);
+		checkFutures(pool);
+#endif
+	}
+
+	void test_scaling() {
+#if BENCHMARK_TIME
+		Common::install_null_g_system();
+
+#ifdef SLOW_TESTS
+		const int iters = 200;
+#else
+		const int iters = 2;
+#endif
+		const uint numValues = 100000;
+
+		Common::ThreadPool serialPool;
+		Common::ThreadPool *pool = g_system->getThreadPool();
+
+		Common::Array<float> serialValues, parallelValues;
+		serialValues.resize(numValues);
+		parallelValues.resize(numValues);
+		HeavyRange serial, parallel;
+		serial.values = &serialValues;
+		parallel.values = &parallelValues;
+
+		uint32 start = g_system->getMillis();
+		for (int n = 0; n < iters; n++)
+			serialPool.parallelFor(0, numValues, serial);
+		uint32 serialTime = g_system->getMillis() - start;
+
+		start = g_system->getMillis();
+		for (int n = 0; n < iters; n++)
+			pool->parallelFor(0, numValues, parallel);
+		uint32 parallelTime = g_system->getMillis() - start;
+
+		for (uint i = 0; i < numValues; i++)
+			TS_ASSERT_EQUALS(serialValues[i], parallelValues[i]);
+
+		debug("ThreadPool::parallelFor without workers, %d iters (in milliseconds): %d", iters, serialTime);
+		debug("ThreadPool::parallelFor with %d workers, %d iters (in milliseconds): %d", pool->getNumWorkers(), iters, parallelTime);
+#endif
+	}
+};
@@ -0,0 +1,191 @@
+#include <cxxtest/TestSuite.h>
+
+#include "engines/hpl1/engine/libraries/newton/Newton.h"
+
+#include "common/system.h"
+#include "common/threadpool.h"
+#include "common/debug.h"
+
+#include "test/null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+/**
+ * Test suite for the threads of the Newton physics library,
+ * engines/hpl1/engine/libraries/newton/core/dgThreads.h
+ */
+
+class NewtonThreadsTestSuite : public CxxTest::TestSuite {
+	static const int kNumStacks = 16;
+	static const int kStackHeight = 8;
+
+	// Shared by all callbacks, like the game state the HPL callbacks change
+	struct CallbackState {
+		int running;
+		bool overlapped;
+		int forceCalls;
+		int beginContactCalls;
+		int contactPoints;
+	};
+
+	// The callbacks hold the critical section like cNewtonCallbackLock does
+	static CallbackState &enterCallback(NewtonWorld *world) {
+		NewtonWorldCriticalSectionLock(world);
+		CallbackState &state = *(CallbackState *)NewtonWorldGetUserData(world);
+		if (state.running++)
+			state.overlapped = true;
+		return state;
+	}
+
+	static void leaveCallback(NewtonWorld *world, CallbackState &state) {
+		state.running--;
+		NewtonWorldCriticalSectionUnlock(world);
+	}
+
+	// Same gravity as cPhysicsBodyNewton::OnUpdateCallback() applies
+	static void applyGravity(NewtonBody *body, dFloat, int32) {
+		NewtonWorld *world = NewtonBodyGetWorld(body);
+		CallbackState &state = enterCallback(world);
+		state.forceCalls++;
+
+		dFloat mass, ixx, iyy, izz;
+		NewtonBodyGetMassMatrix(body, &mass, &ixx, &iyy, &izz);
+		dFloat force[3] = { 0.0f, -9.81f * mass, 0.0f };
+		NewtonBodyAddForce(body, force);
+
+		leaveCallback(world, state);
+	}
+
+	static int beginContact(const NewtonMaterial *, const NewtonBody *body0, const NewtonBody *, int32) {
+		NewtonWorld *world = NewtonBodyGetWorld(body0);
+		CallbackState &state = enterCallback(world);
+		state.beginContactCalls++;
+		leaveCallback(world, state);
+		return 1;
+	}
+
+	// Collects the contacts, like cPhysicsMaterialNewton::ProcessContactCallback() does
+	static void processContacts(const NewtonJoint *joint, dFloat, int32) {
+		NewtonWorld *world = NewtonBodyGetWorld(NewtonJointGetBody0(joint));
+		CallbackState &state = enterCallback(world);
+		for (void *contact = NewtonContactJointGetFirstContact(joint); contact; contact = NewtonContactJointGetNextContact(joint, contact))
+			state.contactPoints++;
+		leaveCallback(world, state);
+	}
+
+	static void setPosition(dFloat *matrix, dFloat x, dFloat y, dFloat z) {
+		for (int i = 0; i < 16; i++)
+			matrix[i] = (i % 5) ? 0.0f : 1.0f;
+		matrix[12] = x;
+		matrix[13] = y;
+		matrix[14] = z;
+	}
+
+	// A floor with separate stacks of boxes, so there are many islands to solve
+	static NewtonWorld *createScene(int threads, CallbackState &state, Common::Array<NewtonBody *> &boxes) {
+		NewtonWorld *world = NewtonCreate();
+		NewtonSetThreadsCount(world, threads);
+
+		memset(&state, 0, sizeof(state));
+		NewtonWorldSetUserData(world, &state);
+		const int material = NewtonMaterialGetDefaultGroupID(world);
+		NewtonMaterialSetCollisionCallback(world, material, material, nullptr, beginContact, processContacts);
+
+		dFloat matrix[16];
+		NewtonCollision *floorShape = NewtonCreateBox(world, 200.0f, 1.0f, 200.0f, 0, nullptr);
+		setPosition(matrix, 0.0f, -0.5f, 0.0f);
+		NewtonCreateBody(world, floorShape, matrix);
+		NewtonReleaseCollision(world, floorShape);
+
+		NewtonCollision *boxShape = NewtonCreateBox(world, 1.0f, 1.0f, 1.0f, 0, nullptr);
+		for (int s = 0; s < kNumStacks; s++) {
+			for (int h = 0; h < kStackHeight; h++) {
+				setPosition(matrix, (s % 4) * 4.0f - 6.0f, h * 1.01f + 0.5f, (s / 4) * 4.0f - 6.0f);
+				NewtonBody *box = NewtonCreateBody(world, boxShape, matrix);
+				NewtonBodySetMassMatrix(box, 1.0f, 1.0f / 6.0f, 1.0f / 6.0f, 1.0f / 6.0f);
+				NewtonBodySetForceAndTorqueCallback(box, applyGravity);
+				boxes.push_back(box);
+			}
+		}
+		NewtonReleaseCollision(world, boxShape);
+		return world;
+	}
+
+	static void simulate(NewtonWorld *world, int steps) {
+		for (int i = 0; i < steps; i++)
+			NewtonUpdate(world, 1.0f / 60.0f);
+	}
+
+	public:
+	void setUp() {
+		NewtonInitGlobals();
+	}
+
+	void tearDown() {
+		NewtonDestroyGlobals();
+	}
+
+	void test_threaded_stacks_rest() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		const int threads = g_system->getThreadPool()->getNumWorkers() + 1;
+		CallbackState state;
+		Common::Array<NewtonBody *> boxes;
+		NewtonWorld *world = createScene(threads, state, boxes);
+		TS_ASSERT_EQUALS(NewtonGetThreadsCount(world), MIN(threads, 8));
+
+		simulate(world, 120);
+
+		// The callbacks ran, one at a time
+		TS_ASSERT_LESS_THAN(0, state.forceCalls);
+		TS_ASSERT_LESS_THAN(0, state.beginContactCalls);
+		TS_ASSERT_LESS_THAN(0, state.contactPoints);
+		TS_ASSERT(!state.overlapped);
+
+		// No box fell through the floor or another box
+		dFloat matrix[16];
+		for (uint i = 0; i < boxes.size(); i++) {
+			NewtonBodyGetMatrix(boxes[i], matrix);
+			TS_ASSERT_LESS_THAN(0.4f, matrix[13]);
+		}
+
+		NewtonDestroy(world);
+#endif
+	}
+
+	void test_step_time() {
+#if BENCHMARK_TIME
+		Common::install_null_g_system();
+
+#ifdef SLOW_TESTS
+		const int steps = 600;
+#else
+		const int steps = 30;
+#endif
+
+		CallbackState state;
+		Common::Array<NewtonBody *> boxes;
+		NewtonWorld *world = createScene(1, state, boxes);
+		uint32 start = g_system->getMillis();
+		simulate(world, steps);
+		uint32 singleTime = g_system->getMillis() - start;
+		NewtonDestroy(world);
+
+		boxes.clear();
+		world = createScene(g_system->getThreadPool()->getNumWorkers() + 1, state, boxes);
+		start = g_system->getMillis();
+		simulate(world, steps);
+		uint32 threadedTime = g_system->getMillis() - start;
+		int threads = NewtonGetThreadsCount(world);
+		NewtonDestroy(world);
+
+		debug("NewtonUpdate with 1 thread, %d steps (in milliseconds): %d", steps, singleTime);
+		debug("NewtonUpdate with %d threads, %d steps (in milliseconds): %d", threads, steps, threadedTime);
+#endif
+	}
+};
@@ -0,0 +1,109 @@
+#include <cxxtest/TestSuite.h>
+
+#include "engines/wintermute/base/scriptables/script_value.h"
+
+#include "common/system.h"
+#include "common/debug.h"
+
+#include "test/null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+#define BENCHMARK_TIME 1
+#else
+#define BENCHMARK_TIME 0
+#endif
+
+/**
+ * Test suite for the cached property lookups of ScValue,
+ * engines/wintermute/base/scriptables/script_value.h
+ */
+
+class ScValueTestSuite : public CxxTest::TestSuite {
+	public:
+	void test_cached_lookup() {
+		Wintermute::ScValue object(nullptr);
+		Wintermute::ScValue value(nullptr, (int32)42);
+		object.setProp("Answer", &value);
+
+		Wintermute::ScPropCache cache;
+		Wintermute::ScValue *prop = object.getProp("Answer", cache);
+		TS_ASSERT(prop);
+		TS_ASSERT_EQUALS(prop->getInt(), 42);
+		TS_ASSERT_EQUALS(cache._value, prop);
+
+		// Hits return the stored value
+		TS_ASSERT_EQUALS(object.getProp("Answer", cache), prop);
+		TS_ASSERT(!object.getProp("Question", cache));
+		TS_ASSERT_EQUALS(object.getProp("Answer", cache), prop);
+
+		// Assigning an existing property keeps the cached value object
+		Wintermute::ScValue other(nullptr, (int32)17);
+		object.setProp("Answer", &other);
+		TS_ASSERT_EQUALS(object.getProp("Answer", cache)->getInt(), 17);
+	}
+
+	void test_invalidation() {
+		Wintermute::ScValue object(nullptr);
+		Wintermute::ScValue value(nullptr, (int32)1);
+		object.setProp("First", &value);
+
+		Wintermute::ScPropCache cache;
+		TS_ASSERT(object.getProp("First", cache));
+
+		uint32 version = Wintermute::ScValue::getPropsVersion();
+		object.deleteProp("First");
+		TS_ASSERT_DIFFERS(Wintermute::ScValue::getPropsVersion(), version);
+		TS_ASSERT(!object.getProp("First", cache));
+
+		object.setProp("First", &value);
+		Wintermute::ScValue *prop = object.getProp("First", cache);
+		TS_ASSERT(prop);
+		TS_ASSERT_EQUALS(prop->getInt(), 1);
+
+		// The same cache used on another object must not return its value
+		Wintermute::ScValue second(nullptr);
+		TS_ASSERT(!second.getProp("First", cache));
+
+		object.deleteProps();
+		TS_ASSERT(!object.getProp("First", cache));
+	}
+
+	void test_lookup_speed() {
+#if BENCHMARK_TIME
+		Common::install_null_g_system();
+
+#ifdef SLOW_TESTS
+		const int iters = 1000000;
+#else
+		const int iters = 10000;
+#endif
+		const int numProps = 32;
+
+		Wintermute::ScValue object(nullptr);
+		Common::Array<Common::String> names;
+		for (int i = 0; i < numProps; i++) {
+			names.push_back(Common::String::format("SomeObjectProperty%d", i));
+			Wintermute::ScValue value(nullptr, (int32)i);
+			object.setProp(names[i].c_str(), &value);
+		}
+
+		int64 sum = 0;
+		uint32 start = g_system->getMillis();
+		for (int n = 0; n < iters; n++)
+			sum += object.getProp(names[n % numProps].c_str())->getInt();
+		uint32 uncachedTime = g_system->getMillis() - start;
+
+		// one cache per property, as every instruction has its own
+		Wintermute::ScPropCache caches[numProps];
+		start = g_system->getMillis();
+		for (int n = 0; n < iters; n++)
+			sum -= object.getProp(names[n % numProps].c_str(), caches[n % numProps])->getInt();
+		uint32 cachedTime = g_system->getMillis() - start;
+
+		TS_ASSERT_EQUALS(sum, 0);
+
+		debug("ScValue::getProp, %d lookups (in milliseconds): %d", iters, uncachedTime);
+		debug("ScValue::getProp with ScPropCache, %d lookups (in milliseconds): %d", iters, cachedTime);
+#endif
+	}
+};
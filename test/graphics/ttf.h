@@ -0,0 +1,209 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/fs.h"
+#include "common/stream.h"
+#include "graphics/font.h"
+#include "graphics/surface.h"
+
+#include "../null_osystem.h"
+
+#ifdef USE_FREETYPE2
+#include "graphics/fonts/ttf.h"
+#define TTF_IS_AVAILABLE NULL_OSYSTEM_IS_AVAILABLE
+#else
+#define TTF_IS_AVAILABLE 0
+#endif
+
+// Copied next to the test runner by the test makefile
+#define TTF_TEST_FILE "test/fonts/FreeSans.ttf"
+
+class TTFTestSuite : public CxxTest::TestSuite
+{
+#if TTF_IS_AVAILABLE
+	Graphics::Font *loadFont(int size) {
+		Common::install_null_g_system();
+
+		Common::FSNode node(TTF_TEST_FILE);
+		Common::SeekableReadStream *stream = node.createReadStream();
+		TS_ASSERT(stream);
+		if (!stream)
+			return nullptr;
+
+		Graphics::Font *font = Graphics::loadTTFFont(*stream, size);
+		delete stream;
+		TS_ASSERT(font);
+		return font;
+	}
+
+	static void createSurface(Graphics::Surface &surface) {
+		surface.create(320, 64, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+		surface.fillRect(Common::Rect(surface.w, surface.h), 0);
+	}
+
+	static bool equalSurfaces(const Graphics::Surface &a, const Graphics::Surface &b) {
+		for (int y = 0; y < a.h; y++) {
+			if (memcmp(a.getBasePtr(0, y), b.getBasePtr(0, y), a.w * a.format.bytesPerPixel))
+				return false;
+		}
+		return true;
+	}
+
+	static bool isEmpty(const Graphics::Surface &surface) {
+		for (int y = 0; y < surface.h; y++) {
+			for (int x = 0; x < surface.w; x++) {
+				if (surface.getPixel(x, y))
+					return false;
+			}
+		}
+		return true;
+	}
+
+	static Graphics::TTFCacheStats getStats(const Graphics::Font *font) {
+		Graphics::TTFCacheStats stats;
+		TS_ASSERT(Graphics::getTTFCacheStats(font, stats));
+		return stats;
+	}
+#endif
+
+	public:
+	void test_atlas_keeps_glyphs() {
+#if TTF_IS_AVAILABLE
+		Graphics::Font *font = loadFont(40);
+		if (!font)
+			return;
+		Graphics::setTTFRunCacheSize(font, 0);
+
+		Graphics::Surface before, after;
+		createSurface(before);
+		createSurface(after);
+		font->drawString(&before, Common::U32String("Ag&"), 0, 0, before.w, 0xFFFFFFFF);
+		TS_ASSERT(!isEmpty(before));
+
+		// Rasterize enough glyphs to fill more than one atlas page
+		Common::U32String many;
+		for (uint32 c = 0x21; c < 0x250; c++)
+			many += c;
+		for (uint i = 0; i < many.size(); i++)
+			font->getCharWidth(many[i]);
+
+		Graphics::TTFCacheStats stats = getStats(font);
+		TS_ASSERT_LESS_THAN(1u, stats.atlasPages);
+		TS_ASSERT_EQUALS(stats.atlasBytes, stats.atlasPages * 256 * 256);
+		TS_ASSERT_LESS_THAN(100u, stats.glyphs);
+
+		// Glyphs packed later did not overwrite the earlier ones
+		font->drawString(&after, Common::U32String("Ag&"), 0, 0, after.w, 0xFFFFFFFF);
+		TS_ASSERT(equalSurfaces(before, after));
+
+		before.free();
+		after.free();
+		delete font;
+#endif
+	}
+
+	void test_run_matches_glyphs() {
+#if TTF_IS_AVAILABLE
+		Graphics::Font *font = loadFont(16);
+		if (!font)
+			return;
+
+		const Common::String text("AVAST, Ye WaTer!");
+		Graphics::Surface glyphs, run, cached;
+		createSurface(glyphs);
+		createSurface(run);
+		createSurface(cached);
+
+		Graphics::setTTFRunCacheSize(font, 0);
+		font->drawString(&glyphs, text, 4, 8, glyphs.w - 8, 0xFF8040FF, Graphics::kTextAlignCenter);
+		TS_ASSERT_EQUALS(getStats(font).runMisses, 0u);
+
+		Graphics::setTTFRunCacheSize(font, 16);
+		font->drawString(&run, text, 4, 8, run.w - 8, 0xFF8040FF, Graphics::kTextAlignCenter);
+		font->drawString(&cached, text, 4, 8, cached.w - 8, 0xFF8040FF, Graphics::kTextAlignCenter);
+
+		Graphics::TTFCacheStats stats = getStats(font);
+		TS_ASSERT_EQUALS(stats.runMisses, 1u);
+		TS_ASSERT_EQUALS(stats.runHits, 1u);
+		TS_ASSERT_EQUALS(stats.runs, 1u);
+		TS_ASSERT_LESS_THAN(0u, stats.runBytes);
+		TS_ASSERT(equalSurfaces(glyphs, run));
+		TS_ASSERT(equalSurfaces(glyphs, cached));
+
+		glyphs.free();
+		run.free();
+		cached.free();
+		delete font;
+#endif
+	}
+
+	void test_overlapping_glyphs_are_drawn_one_by_one() {
+#if TTF_IS_AVAILABLE
+		Graphics::Font *font = loadFont(16);
+		if (!font)
+			return;
+
+		// Blending the glyphs of "ff" one after the other differs from
+		// blending their combined coverage where they overlap
+		const Common::U32String text("ffl");
+		Graphics::Surface glyphs, run;
+		createSurface(glyphs);
+		createSurface(run);
+
+		Graphics::setTTFRunCacheSize(font, 0);
+		font->drawString(&glyphs, text, 0, 0, glyphs.w, 0xFF8040FF);
+		font->drawString(&glyphs, text, 0, 0, glyphs.w, 0xFF8040FF);
+		Graphics::setTTFRunCacheSize(font, 16);
+		font->drawString(&run, text, 0, 0, run.w, 0xFF8040FF);
+		font->drawString(&run, text, 0, 0, run.w, 0xFF8040FF);
+
+		// The run is remembered, but holds no coverage
+		Graphics::TTFCacheStats stats = getStats(font);
+		TS_ASSERT_EQUALS(stats.runs, 1u);
+		TS_ASSERT_EQUALS(stats.runBytes, 0u);
+		TS_ASSERT_EQUALS(stats.runHits, 1u);
+		TS_ASSERT(equalSurfaces(glyphs, run));
+
+		glyphs.free();
+		run.free();
+		delete font;
+#endif
+	}
+
+	void test_run_cache_evicts_least_recently_used() {
+#if TTF_IS_AVAILABLE
+		Graphics::Font *font = loadFont(16);
+		if (!font)
+			return;
+		Graphics::setTTFRunCacheSize(font, 2);
+
+		Graphics::Surface surface;
+		createSurface(surface);
+
+		font->drawString(&surface, Common::String("first"), 0, 0, surface.w, 0xFFFFFFFF);
+		font->drawString(&surface, Common::U32String("second"), 0, 0, surface.w, 0xFFFFFFFF);
+		font->drawString(&surface, Common::String("first"), 0, 0, surface.w, 0xFFFFFFFF);
+		font->drawString(&surface, Common::String("third"), 0, 0, surface.w, 0xFFFFFFFF);
+
+		Graphics::TTFCacheStats stats = getStats(font);
+		TS_ASSERT_EQUALS(stats.runs, 2u);
+		TS_ASSERT_EQUALS(stats.runHits, 1u);
+		TS_ASSERT_EQUALS(stats.runMisses, 3u);
+		TS_ASSERT_EQUALS(stats.runEvictions, 1u);
+
+		// "second" was the least recently used run
+		font->drawString(&surface, Common::String("first"), 0, 0, surface.w, 0xFFFFFFFF);
+		TS_ASSERT_EQUALS(getStats(font).runHits, 2u);
+		font->drawString(&surface, Common::U32String("second"), 0, 0, surface.w, 0xFFFFFFFF);
+		TS_ASSERT_EQUALS(getStats(font).runMisses, 4u);
+
+		// Shrinking the cache evicts right away
+		Graphics::setTTFRunCacheSize(font, 1);
+		stats = getStats(font);
+		TS_ASSERT_EQUALS(stats.runs, 1u);
+		TS_ASSERT_EQUALS(stats.runEvictions, 3u);
+
+		surface.free();
+		delete font;
+#endif
+	}
+};
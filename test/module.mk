@@ -5,7 +5,7 @@
 #
 ######################################################################
 
-TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/common/formats/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/math/*.h $(srcdir)/test/image/*.h
+TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/common/formats/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/math/*.h $(srcdir)/test/image/*.h $(srcdir)/test/graphics/*.h
 TEST_LIBS    :=
 
 ifdef POSIX
@@ -15,7 +15,11 @@ TEST_LIBS += test/null_osystem.o \
 	backends/fs/posix/posix-iostream.o \
 	backends/fs/abstract-fs.o \
 	backends/fs/stdiostream.o \
-	backends/modular-backend.o
+	backends/modular-backend.o \
+	backends/threads/default/default-threadpool.o
+ifdef HAS_PTHREADS
+TEST_LIBS += backends/threads/pthread/pthread-threadpool.o
+endif
 endif
 
 ifdef WIN32
@@ -25,16 +29,22 @@ TEST_LIBS += test/null_osystem.o \
 	backends/fs/abstract-fs.o \
 	backends/fs/stdiostream.o \
 	backends/modular-backend.o \
+	backends/threads/default/default-threadpool.o \
 	backends/platform/sdl/win32/win32_wrapper.o
 endif
 
-TEST_LIBS +=	audio/libaudio.a math/libmath.a common/formats/libformats.a common/compression/libcompression.a common/libcommon.a image/libimage.a graphics/libgraphics.a
+TEST_LIBS +=	audio/libaudio.a math/libmath.a image/libimage.a graphics/libgraphics.a common/formats/libformats.a common/compression/libcompression.a common/libcommon.a
 
 ifeq ($(ENABLE_WINTERMUTE), STATIC_PLUGIN)
 	TESTS += $(srcdir)/test/engines/wintermute/*.h
 	TEST_LIBS += engines/wintermute/libwintermute.a
 endif
 
+ifeq ($(ENABLE_HPL1), STATIC_PLUGIN)
+	TESTS += $(srcdir)/test/engines/hpl1/*.h
+	TEST_LIBS += engines/hpl1/libhpl1.a
+endif
+
 ifeq ($(ENABLE_ULTIMA), STATIC_PLUGIN)
 	TESTS += $(srcdir)/test/engines/ultima/*/*/*.h
 	TEST_LIBS += engines/ultima/libultima.a
@@ -76,13 +86,17 @@ test/runner.cpp: $(TESTS) $(srcdir)/test/module.mk
 
 clean: clean-test
 clean-test:
-	-$(RM) test/runner.cpp test/runner test/engine-data/encoding.dat test/null_osystem.o
-	-rmdir test/engine-data
+	-$(RM) test/runner.cpp test/runner test/engine-data/encoding.dat test/fonts/FreeSans.ttf test/null_osystem.o
+	-rmdir test/engine-data test/fonts
 
 test/engine-data/encoding.dat: $(srcdir)/dists/engine-data/encoding.dat
 	$(MKDIR) test/engine-data
 	$(CP) $(srcdir)/dists/engine-data/encoding.dat test/engine-data/encoding.dat
 
-copy-dat: test/engine-data/encoding.dat
+test/fonts/FreeSans.ttf: $(srcdir)/gui/themes/fonts/FreeSans.ttf
+	$(MKDIR) test/fonts
+	$(CP) $(srcdir)/gui/themes/fonts/FreeSans.ttf test/fonts/FreeSans.ttf
+
+copy-dat: test/engine-data/encoding.dat test/fonts/FreeSans.ttf
 
 .PHONY: test clean-test copy-dat
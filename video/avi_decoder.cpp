@@ -19,6 +19,8 @@
  *
  */
 
+#include "common/bufferedstream.h"
+#include "common/debug.h"
 #include "common/stream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
@@ -439,7 +441,9 @@ bool AVIDecoder::loadStream(Common::SeekableReadStream *stream) {
 		return false;
 	}
 
-	_fileStream = stream;
+	// Chunks are mostly read in order, with the index and interleaved audio
+	// causing short jumps back
+	_fileStream = Common::wrapAdaptiveBufferedSeekableReadStream(stream, 4 * 1024, 128 * 1024, DisposeAfterUse::YES);
 
 	// Go through all chunks in the file
 	while (_fileStream->pos() < fileSize && parseNextChunk())
@@ -500,6 +504,11 @@ bool AVIDecoder::loadStream(Common::SeekableReadStream *stream) {
 void AVIDecoder::close() {
 	VideoDecoder::close();
 
+	Common::BufferedStreamStats stats;
+	if (_fileStream && Common::getBufferedStreamStats(_fileStream, stats))
+		debug(3, "AVIDecoder: %d refills, %d bytes read, %d block hits, %d ms blocked",
+		      stats.refills, (int)stats.bytesRead, stats.blockHits, stats.timeBlocked);
+
 	delete _fileStream;
 	_fileStream = 0;
 	_decodedHeader = false;
@@ -23,6 +23,7 @@
 
 #include "audio/audiostream.h"
 #include "audio/decoders/raw.h"
+#include "common/bufferedstream.h"
 #include "common/debug.h"
 #include "common/stream.h"
 #include "common/system.h"
@@ -134,6 +135,9 @@ bool MKVDecoder::loadStream(Common::SeekableReadStream *stream) {
 
 	warning("MKVDecoder::loadStream()");
 
+	// Blocks are read in cluster order, with the parser jumping back to
+	// element headers it has already seen
+	stream = Common::wrapAdaptiveBufferedSeekableReadStream(stream, 4 * 1024, 128 * 1024, DisposeAfterUse::YES);
 	_reader = new mkvparser::MkvReader(stream);
 
 	long long pos = 0;